@@ -13,29 +13,70 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif //__x86_64__
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
 #include "dwio/nimble/common/Bits.h"
+#include "dwio/nimble/common/CpuFeatures.h"
+#include "folly/CPortability.h"
 #include "velox/common/base/BitUtil.h"
 
 namespace facebook::nimble::bits {
 
-void packBitmap(std::span<const bool> bools, char* bitmap) {
+namespace {
+
+// Packs |count| (at most 64) bools into the low bits of a word.
+FOLLY_ALWAYS_INLINE uint64_t packWordScalar(const bool* bools, int count) {
+  uint64_t word = 0;
+  for (int j = 0; j < count; ++j) {
+    word |= static_cast<uint64_t>(bools[j]) << j;
+  }
+  return word;
+}
+
+FOLLY_ALWAYS_INLINE uint64_t packWordScalar(const bool* bools) {
+  return packWordScalar(bools, 64);
+}
+
+using PackWord = uint64_t (*)(const bool*);
+
+template <PackWord packWord>
+FOLLY_ALWAYS_INLINE void packBitmapImpl(
+    std::span<const bool> bools,
+    char* bitmap) {
   uint64_t* word = reinterpret_cast<uint64_t*>(bitmap);
   const uint64_t loopCount = bools.size() >> 6;
   const uint64_t remainder = bools.size() - (loopCount << 6);
   const bool* rawBools = bools.data();
-  // TODO: use SIMD?
   for (uint64_t i = 0; i < loopCount; ++i) {
-    for (int j = 0; j < 64; ++j) {
-      *word |= static_cast<uint64_t>(*rawBools++) << j;
-    }
-    ++word;
+    *word++ |= packWord(rawBools);
+    rawBools += 64;
+  }
+  if (remainder > 0) {
+    *word |= packWordScalar(rawBools, remainder);
   }
-  for (int j = 0; j < remainder; ++j) {
-    *word |= static_cast<uint64_t>(*rawBools++) << j;
+}
+
+FOLLY_ALWAYS_INLINE uint32_t countWordsScalar(
+    const uint64_t* words,
+    uint32_t wordCount) {
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < wordCount; ++i) {
+    count += __builtin_popcountll(words[i]);
   }
+  return count;
 }
 
-uint32_t countSetBits(uint32_t row, uint32_t rowCount, const char* bitmap) {
+using CountWords = uint32_t (*)(const uint64_t*, uint32_t);
+
+template <CountWords countWords>
+FOLLY_ALWAYS_INLINE uint32_t
+countSetBitsImpl(uint32_t row, uint32_t rowCount, const char* bitmap) {
   // Count bits remaining in current partial word, then count bits in
   // each word, then finish with partial final word.
   uint32_t nonNullCount = 0;
@@ -55,9 +96,8 @@ uint32_t countSetBits(uint32_t row, uint32_t rowCount, const char* bitmap) {
   // We're now trued up to a word boundary.
   const uint32_t wordCount = rowCount >> 6;
   const uint32_t remainder = rowCount - (wordCount << 6);
-  for (uint32_t i = 0; i < wordCount; ++i) {
-    nonNullCount += __builtin_popcountll(*word++);
-  }
+  nonNullCount += countWords(word, wordCount);
+  word += wordCount;
   // Add in the bits in the remaining partial word.
   if (remainder > 0) {
     const uint64_t mask = (1ULL << remainder) - 1;
@@ -66,83 +106,376 @@ uint32_t countSetBits(uint32_t row, uint32_t rowCount, const char* bitmap) {
   return nonNullCount;
 }
 
-uint32_t findNonNullIndices(
+// Appends |base| + the positions of the set bits in |word| to |output|.
+// Returns |output| updated past the appended indices.
+FOLLY_ALWAYS_INLINE uint32_t*
+appendIndicesScalar(uint64_t word, uint32_t base, uint32_t* output) {
+  while (word != 0) {
+    *output++ = base + __builtin_ctzll(word);
+    word &= word - 1;
+  }
+  return output;
+}
+
+// Returns the word holding bit |index|, inverted when looking for nulls.
+template <bool kNulls>
+FOLLY_ALWAYS_INLINE uint64_t loadWord(const char* bitmap, uint32_t index) {
+  const uint64_t word = reinterpret_cast<const uint64_t*>(bitmap)[index >> 6];
+  return kNulls ? ~word : word;
+}
+
+// Finding the (relative) indices of the set bits (or unset bits, if |kNulls|)
+// among the |rowCount| bits starting at |row| is split in three: the leading
+// partial word (findIndicesHead), full words (handled by each implementation)
+// and the trailing partial word (findIndicesTail). Partial words are always
+// walked bit by bit, so implementations can store up to 64 values past
+// |output| when handling a full word, as long as they only advance |output|
+// past the actual indices.
+
+// Returns the number of rows consumed.
+template <bool kNulls>
+FOLLY_ALWAYS_INLINE uint32_t findIndicesHead(
+    uint32_t row,
+    uint32_t rowCount,
+    const char* bitmap,
+    uint32_t*& output) {
+  const uint32_t currentUsedBits = row & 63;
+  if (currentUsedBits == 0 || rowCount == 0) {
+    return 0;
+  }
+  const uint32_t bitCount = std::min(64 - currentUsedBits, rowCount);
+  const uint64_t word = (loadWord<kNulls>(bitmap, row) >> currentUsedBits) &
+      ((1ULL << bitCount) - 1);
+  output = appendIndicesScalar(word, 0, output);
+  return bitCount;
+}
+
+// Returns |output| updated past the appended indices.
+template <bool kNulls>
+FOLLY_ALWAYS_INLINE uint32_t* findIndicesTail(
+    uint32_t row,
+    uint32_t rowCount,
+    uint32_t consumed,
+    const char* bitmap,
+    uint32_t* output) {
+  if (consumed == rowCount) {
+    return output;
+  }
+  const uint64_t word = loadWord<kNulls>(bitmap, row + consumed) &
+      ((1ULL << (rowCount - consumed)) - 1);
+  return appendIndicesScalar(word, consumed, output);
+}
+
+template <bool kNulls>
+uint32_t findIndicesScalar(
     uint32_t row,
     uint32_t rowCount,
     const char* bitmap,
     uint32_t* indices) {
-  uint32_t* nextIndex = indices;
-  const uint32_t currentWord = row >> 6;
-  const uint32_t currentIndex = currentWord << 6;
-  const uint32_t currentUsedBits = row - currentIndex;
-  const uint64_t* nextWord =
-      reinterpret_cast<const uint64_t*>(bitmap) + currentWord;
-  // Consume the remaining bits in the current word.
-  int index = -1;
-  if (currentUsedBits) {
-    uint64_t word = *nextWord++ >> currentUsedBits;
-    // Do we only need to read bits from this one word?
-    if (row + rowCount <= currentIndex + 64) {
-      word &= ((1ULL << rowCount) - 1);
-      while (int setBit = __builtin_ffsll(word)) {
-        index += setBit;
-        word >>= setBit;
-        *nextIndex++ = index;
-      }
-      return nextIndex - indices;
-    }
-    while (int setBit = __builtin_ffsll(word)) {
-      index += setBit;
-      word >>= setBit;
-      *nextIndex++ = index;
+  uint32_t* output = indices;
+  uint32_t i = findIndicesHead<kNulls>(row, rowCount, bitmap, output);
+  for (; i + 64 <= rowCount; i += 64) {
+    output = appendIndicesScalar(loadWord<kNulls>(bitmap, row + i), i, output);
+  }
+  output = findIndicesTail<kNulls>(row, rowCount, i, bitmap, output);
+  return output - indices;
+}
+
+// Loads the (up to 64) bits of |bitmap| starting at |index|, without reading
+// past the byte holding bit |end| - 1. |bitCount| is set to the number of bits
+// loaded. Bits at or past |end| are cleared.
+FOLLY_ALWAYS_INLINE uint64_t loadBits(
+    const char* bitmap,
+    uint32_t index,
+    uint32_t end,
+    uint32_t& bitCount) {
+  const uint32_t byte = index / 8;
+  const uint32_t shift = index % 8;
+  const uint32_t byteCount =
+      std::min<uint64_t>(sizeof(uint64_t), bytesRequired(end) - byte);
+  uint64_t word = 0;
+  // @lint-ignore CLANGSECURITY facebook-security-vulnerable-memcpy
+  std::memcpy(&word, bitmap + byte, byteCount);
+  word >>= shift;
+  bitCount = std::min(end - index, byteCount * 8 - shift);
+  if (bitCount < 64) {
+    word &= (1ULL << bitCount) - 1;
+  }
+  return word;
+}
+
+// Returns the position of the |n|th (1 based) set bit of |word|, which must
+// have at least |n| set bits.
+FOLLY_ALWAYS_INLINE uint32_t selectBitScalar(uint64_t word, uint32_t n) {
+  // Clear the n - 1 lowest set bits.
+  while (--n > 0) {
+    word &= word - 1;
+  }
+  return __builtin_ctzll(word);
+}
+
+using SelectBit = uint32_t (*)(uint64_t, uint32_t);
+
+// Scans |bitmap| a word at a time, using |selectBit| to locate the |n|th set
+// bit within the word holding it.
+template <SelectBit selectBit>
+FOLLY_ALWAYS_INLINE uint32_t
+findSetBitImpl(const char* bitmap, uint32_t begin, uint32_t end, uint32_t n) {
+  if (n == 0) {
+    return end;
+  }
+  while (begin < end) {
+    uint32_t bitCount;
+    const uint64_t word = loadBits(bitmap, begin, end, bitCount);
+    const uint32_t setBits = __builtin_popcountll(word);
+    if (setBits >= n) {
+      return begin + selectBit(word, n);
     }
-    index = 63 - currentUsedBits;
-    rowCount -= (64 - currentUsedBits);
+    n -= setBits;
+    begin += bitCount;
   }
-  // We're now trued up to a word boundary.
-  const uint32_t wordCount = rowCount >> 6;
-  const uint32_t remainder = rowCount - (wordCount << 6);
-  for (uint32_t i = 0; i < wordCount; ++i) {
-    uint64_t word = *nextWord++;
-    uint32_t tempIndex = index;
-    constexpr uint64_t shiftEdgeCase = 1ULL << 63;
-    if (word == shiftEdgeCase) {
-      *nextIndex++ = tempIndex + 64;
-    } else {
-      while (int setBit = __builtin_ffsll(word)) {
-        tempIndex += setBit;
-        word >>= setBit;
-        *nextIndex++ = tempIndex;
+  return end;
+}
+
+#ifdef __x86_64__
+__attribute__((__target__("avx2"))) uint64_t packWordAvx2(const bool* bools) {
+  const auto zero = _mm256_setzero_si256();
+  const auto low = _mm256_cmpeq_epi8(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bools)), zero);
+  const auto high = _mm256_cmpeq_epi8(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bools + 32)), zero);
+  // Movemask collects the byte sign bits, i.e. the false bools.
+  return ~((static_cast<uint64_t>(
+                static_cast<uint32_t>(_mm256_movemask_epi8(high)))
+            << 32) |
+           static_cast<uint32_t>(_mm256_movemask_epi8(low)));
+}
+
+__attribute__((__target__("avx512f,avx512bw"))) uint64_t packWordAvx512(
+    const bool* bools) {
+  const auto values = _mm512_loadu_si512(bools);
+  return _mm512_test_epi8_mask(values, values);
+}
+
+// Nibble lookup popcount (see https://arxiv.org/abs/1611.07612): bytes are
+// counted with two table lookups, then summed into 64 bit lanes.
+__attribute__((__target__("avx2,popcnt"))) uint32_t countWordsAvx2(
+    const uint64_t* words,
+    uint32_t wordCount) {
+  const auto table = _mm256_setr_epi8(
+      0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+      0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const auto lowNibbles = _mm256_set1_epi8(0x0f);
+  const auto zero = _mm256_setzero_si256();
+  auto total = zero;
+  uint32_t i = 0;
+  for (; i + 4 <= wordCount; i += 4) {
+    const auto values =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+    const auto low =
+        _mm256_shuffle_epi8(table, _mm256_and_si256(values, lowNibbles));
+    const auto high = _mm256_shuffle_epi8(
+        table, _mm256_and_si256(_mm256_srli_epi16(values, 4), lowNibbles));
+    total = _mm256_add_epi64(
+        total, _mm256_sad_epu8(_mm256_add_epi8(low, high), zero));
+  }
+  uint32_t count = _mm256_extract_epi64(total, 0) +
+      _mm256_extract_epi64(total, 1) + _mm256_extract_epi64(total, 2) +
+      _mm256_extract_epi64(total, 3);
+  for (; i < wordCount; ++i) {
+    count += __builtin_popcountll(words[i]);
+  }
+  return count;
+}
+
+// For each byte value, the positions of its set bits, one per byte.
+constexpr std::array<uint64_t, 256> makeBytePositions() {
+  std::array<uint64_t, 256> positions{};
+  for (uint32_t value = 0; value < 256; ++value) {
+    uint32_t count = 0;
+    for (uint32_t bit = 0; bit < 8; ++bit) {
+      if (value & (1U << bit)) {
+        positions[value] |= static_cast<uint64_t>(bit) << (8 * count++);
       }
     }
-    index += 64;
   }
-  // Parse last partial word.
-  if (remainder > 0) {
-    const uint64_t mask = (1ULL << remainder) - 1;
-    uint64_t word = *nextWord & mask;
-    while (int setBit = __builtin_ffsll(word)) {
-      index += setBit;
-      word >>= setBit;
-      *nextIndex++ = index;
-    }
+  return positions;
+}
+
+constexpr auto kBytePositions = makeBytePositions();
+
+// Sparse words are cheaper to walk bit by bit than to expand with SIMD.
+constexpr int kSparseWordBitCount = 8;
+
+FOLLY_ALWAYS_INLINE __attribute__((__target__("avx2,popcnt"))) uint32_t*
+appendIndicesAvx2(uint64_t word, uint32_t base, uint32_t* output) {
+  if (__builtin_popcountll(word) <= kSparseWordBitCount) {
+    return appendIndicesScalar(word, base, output);
+  }
+  // Each byte of the word expands to (up to) 8 indices, written with a single
+  // 8 lane store.
+  for (uint32_t byte = 0; byte < 8 && word != 0; ++byte, word >>= 8) {
+    const uint8_t bits = word;
+    const auto positions =
+        _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(kBytePositions[bits]));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(output),
+        _mm256_add_epi32(positions, _mm256_set1_epi32(base + 8 * byte)));
+    output += __builtin_popcount(bits);
   }
-  return nextIndex - indices;
+  return output;
 }
 
-uint32_t findNullIndices(
+FOLLY_ALWAYS_INLINE __attribute__((__target__("avx512f,popcnt"))) uint32_t*
+appendIndicesAvx512(uint64_t word, uint32_t base, uint32_t* output) {
+  if (__builtin_popcountll(word) <= kSparseWordBitCount) {
+    return appendIndicesScalar(word, base, output);
+  }
+  const auto lanes = _mm512_setr_epi32(
+      0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  for (uint32_t part = 0; part < 4 && word != 0; ++part, word >>= 16) {
+    const __mmask16 mask = word;
+    _mm512_mask_compressstoreu_epi32(
+        output,
+        mask,
+        _mm512_add_epi32(lanes, _mm512_set1_epi32(base + 16 * part)));
+    output += __builtin_popcount(mask);
+  }
+  return output;
+}
+
+template <bool kNulls>
+__attribute__((__target__("avx2,popcnt"))) uint32_t findIndicesAvx2(
     uint32_t row,
     uint32_t rowCount,
     const char* bitmap,
     uint32_t* indices) {
-  uint32_t* nextIndex = indices;
-  for (uint32_t i = 0; i < rowCount; ++i) {
-    // TODO: optimize this like FindNonNullIndices.
-    if (getBit(row + i, bitmap)) {
-      *nextIndex++ = i;
-    }
+  uint32_t* output = indices;
+  uint32_t i = findIndicesHead<kNulls>(row, rowCount, bitmap, output);
+  for (; i + 64 <= rowCount; i += 64) {
+    output = appendIndicesAvx2(loadWord<kNulls>(bitmap, row + i), i, output);
   }
-  return nextIndex - indices;
+  output = findIndicesTail<kNulls>(row, rowCount, i, bitmap, output);
+  return output - indices;
+}
+
+template <bool kNulls>
+__attribute__((__target__("avx512f,popcnt"))) uint32_t findIndicesAvx512(
+    uint32_t row,
+    uint32_t rowCount,
+    const char* bitmap,
+    uint32_t* indices) {
+  uint32_t* output = indices;
+  uint32_t i = findIndicesHead<kNulls>(row, rowCount, bitmap, output);
+  for (; i + 64 <= rowCount; i += 64) {
+    output =
+        appendIndicesAvx512(loadWord<kNulls>(bitmap, row + i), i, output);
+  }
+  output = findIndicesTail<kNulls>(row, rowCount, i, bitmap, output);
+  return output - indices;
+}
+
+__attribute__((__target__("bmi2"))) uint32_t selectBitBmi2(
+    uint64_t word,
+    uint32_t n) {
+  // Deposit a single bit at the position of the nth set bit.
+  return __builtin_ctzll(_pdep_u64(1ULL << (n - 1), word));
+}
+#endif // __x86_64__
+
+using PackBitmap = void (*)(std::span<const bool>, char*);
+
+const cpu::Kernel<PackBitmap> packBitmapKernel{
+    "bits::packBitmap",
+    {
+#ifdef __x86_64__
+        {"avx512", cpu::Feature::Avx512, detail::packBitmapAvx512},
+        {"avx2", cpu::Feature::Avx2, detail::packBitmapAvx2},
+#endif // __x86_64__
+        {"scalar", cpu::Feature::None, detail::packBitmapScalar},
+    }};
+
+using CountSetBits = uint32_t (*)(uint32_t, uint32_t, const char*);
+
+const cpu::Kernel<CountSetBits> countSetBitsKernel{
+    "bits::countSetBits",
+    {
+#ifdef __x86_64__
+        {"avx2",
+         cpu::Feature::Avx2 | cpu::Feature::Popcnt,
+         detail::countSetBitsAvx2},
+        {"popcnt", cpu::Feature::Popcnt, detail::countSetBitsPopcnt},
+#endif // __x86_64__
+        {"scalar", cpu::Feature::None, detail::countSetBitsScalar},
+    }};
+
+using FindIndices = uint32_t (*)(uint32_t, uint32_t, const char*, uint32_t*);
+
+const cpu::Kernel<FindIndices> findNonNullIndicesKernel{
+    "bits::findNonNullIndices",
+    {
+#ifdef __x86_64__
+        {"avx512",
+         cpu::Feature::Avx512 | cpu::Feature::Popcnt,
+         detail::findNonNullIndicesAvx512},
+        {"avx2",
+         cpu::Feature::Avx2 | cpu::Feature::Popcnt,
+         detail::findNonNullIndicesAvx2},
+#endif // __x86_64__
+        {"scalar", cpu::Feature::None, detail::findNonNullIndicesScalar},
+    }};
+
+const cpu::Kernel<FindIndices> findNullIndicesKernel{
+    "bits::findNullIndices",
+    {
+#ifdef __x86_64__
+        {"avx512",
+         cpu::Feature::Avx512 | cpu::Feature::Popcnt,
+         detail::findNullIndicesAvx512},
+        {"avx2",
+         cpu::Feature::Avx2 | cpu::Feature::Popcnt,
+         detail::findNullIndicesAvx2},
+#endif // __x86_64__
+        {"scalar", cpu::Feature::None, detail::findNullIndicesScalar},
+    }};
+
+using FindSetBit = uint32_t (*)(const char*, uint32_t, uint32_t, uint32_t);
+
+const cpu::Kernel<FindSetBit> findSetBitKernel{
+    "bits::findSetBit",
+    {
+#ifdef __x86_64__
+        {"bmi2",
+         cpu::Feature::Bmi2 | cpu::Feature::Popcnt,
+         detail::findSetBitBmi2},
+#endif // __x86_64__
+        {"scalar", cpu::Feature::None, detail::findSetBitScalar},
+    }};
+
+} // namespace
+
+void packBitmap(std::span<const bool> bools, char* bitmap) {
+  packBitmapKernel(bools, bitmap);
+}
+
+uint32_t countSetBits(uint32_t row, uint32_t rowCount, const char* bitmap) {
+  return countSetBitsKernel(row, rowCount, bitmap);
+}
+
+uint32_t findNonNullIndices(
+    uint32_t row,
+    uint32_t rowCount,
+    const char* bitmap,
+    uint32_t* indices) {
+  return findNonNullIndicesKernel(row, rowCount, bitmap, indices);
+}
+
+uint32_t findNullIndices(
+    uint32_t row,
+    uint32_t rowCount,
+    const char* bitmap,
+    uint32_t* indices) {
+  return findNullIndicesKernel(row, rowCount, bitmap, indices);
 }
 
 void setBits(uint64_t begin, uint64_t end, char* bitmap) {
@@ -167,14 +500,7 @@ void clearBits(uint64_t begin, uint64_t end, char* bitmap) {
 
 uint32_t
 findSetBit(const char* bitmap, uint32_t begin, uint32_t end, uint32_t n) {
-  // TODO: maybe there is something fancy in bmi2
-  while (begin < end) {
-    if (getBit(begin, bitmap) && --n == 0) {
-      break;
-    }
-    ++begin;
-  }
-  return begin;
+  return findSetBitKernel(bitmap, begin, end, n);
 }
 
 void BitmapBuilder::copy(const Bitmap& other, uint32_t begin, uint32_t end) {
@@ -193,4 +519,106 @@ void BitmapBuilder::copy(const Bitmap& other, uint32_t begin, uint32_t end) {
       bits::bytesRequired(end) - firstByte);
 }
 
+namespace detail {
+
+void packBitmapScalar(std::span<const bool> bools, char* bitmap) {
+  packBitmapImpl<packWordScalar>(bools, bitmap);
+}
+
+uint32_t
+countSetBitsScalar(uint32_t row, uint32_t rowCount, const char* bitmap) {
+  return countSetBitsImpl<countWordsScalar>(row, rowCount, bitmap);
+}
+
+uint32_t findNonNullIndicesScalar(
+    uint32_t row,
+    uint32_t rowCount,
+    const char* bitmap,
+    uint32_t* indices) {
+  return findIndicesScalar<false>(row, rowCount, bitmap, indices);
+}
+
+uint32_t findNullIndicesScalar(
+    uint32_t row,
+    uint32_t rowCount,
+    const char* bitmap,
+    uint32_t* indices) {
+  return findIndicesScalar<true>(row, rowCount, bitmap, indices);
+}
+
+uint32_t findSetBitScalar(
+    const char* bitmap,
+    uint32_t begin,
+    uint32_t end,
+    uint32_t n) {
+  return findSetBitImpl<selectBitScalar>(bitmap, begin, end, n);
+}
+
+#ifdef __x86_64__
+__attribute__((__target__("avx2"))) void packBitmapAvx2(
+    std::span<const bool> bools,
+    char* bitmap) {
+  packBitmapImpl<packWordAvx2>(bools, bitmap);
+}
+
+__attribute__((__target__("avx512f,avx512bw"))) void packBitmapAvx512(
+    std::span<const bool> bools,
+    char* bitmap) {
+  packBitmapImpl<packWordAvx512>(bools, bitmap);
+}
+
+__attribute__((__target__("popcnt"))) uint32_t
+countSetBitsPopcnt(uint32_t row, uint32_t rowCount, const char* bitmap) {
+  return countSetBitsImpl<countWordsScalar>(row, rowCount, bitmap);
+}
+
+__attribute__((__target__("avx2,popcnt"))) uint32_t
+countSetBitsAvx2(uint32_t row, uint32_t rowCount, const char* bitmap) {
+  return countSetBitsImpl<countWordsAvx2>(row, rowCount, bitmap);
+}
+
+__attribute__((__target__("avx2,popcnt"))) uint32_t findNonNullIndicesAvx2(
+    uint32_t row,
+    uint32_t rowCount,
+    const char* bitmap,
+    uint32_t* indices) {
+  return findIndicesAvx2<false>(row, rowCount, bitmap, indices);
+}
+
+__attribute__((__target__("avx2,popcnt"))) uint32_t findNullIndicesAvx2(
+    uint32_t row,
+    uint32_t rowCount,
+    const char* bitmap,
+    uint32_t* indices) {
+  return findIndicesAvx2<true>(row, rowCount, bitmap, indices);
+}
+
+__attribute__((__target__("avx512f,popcnt"))) uint32_t
+findNonNullIndicesAvx512(
+    uint32_t row,
+    uint32_t rowCount,
+    const char* bitmap,
+    uint32_t* indices) {
+  return findIndicesAvx512<false>(row, rowCount, bitmap, indices);
+}
+
+__attribute__((__target__("avx512f,popcnt"))) uint32_t findNullIndicesAvx512(
+    uint32_t row,
+    uint32_t rowCount,
+    const char* bitmap,
+    uint32_t* indices) {
+  return findIndicesAvx512<true>(row, rowCount, bitmap, indices);
+}
+
+__attribute__((__target__("bmi2,popcnt"))) uint32_t findSetBitBmi2(
+    const char* bitmap,
+    uint32_t begin,
+    uint32_t end,
+    uint32_t n) {
+  return findSetBitImpl<selectBitBmi2>(bitmap, begin, end, n);
+}
+#endif // __x86_64__
+
+} // namespace detail
+
 } // namespace facebook::nimble::bits
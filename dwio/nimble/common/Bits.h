@@ -115,6 +115,58 @@ uint32_t findNullIndices(
 uint32_t
 findSetBit(const char* bitmap, uint32_t begin, uint32_t end, uint32_t n);
 
+namespace detail {
+
+// The different implementations of the methods above, dispatched at runtime
+// (see CpuFeatures.h). Exposed for tests and benchmarks.
+void packBitmapScalar(std::span<const bool> bools, char* bitmap);
+uint32_t
+countSetBitsScalar(uint32_t row, uint32_t rowCount, const char* bitmap);
+uint32_t findNonNullIndicesScalar(
+    uint32_t row,
+    uint32_t rowCount,
+    const char* bitmap,
+    uint32_t* indices);
+uint32_t findNullIndicesScalar(
+    uint32_t row,
+    uint32_t rowCount,
+    const char* bitmap,
+    uint32_t* indices);
+uint32_t
+findSetBitScalar(const char* bitmap, uint32_t begin, uint32_t end, uint32_t n);
+
+#ifdef __x86_64__
+void packBitmapAvx2(std::span<const bool> bools, char* bitmap);
+void packBitmapAvx512(std::span<const bool> bools, char* bitmap);
+uint32_t
+countSetBitsPopcnt(uint32_t row, uint32_t rowCount, const char* bitmap);
+uint32_t countSetBitsAvx2(uint32_t row, uint32_t rowCount, const char* bitmap);
+uint32_t findNonNullIndicesAvx2(
+    uint32_t row,
+    uint32_t rowCount,
+    const char* bitmap,
+    uint32_t* indices);
+uint32_t findNullIndicesAvx2(
+    uint32_t row,
+    uint32_t rowCount,
+    const char* bitmap,
+    uint32_t* indices);
+uint32_t findNonNullIndicesAvx512(
+    uint32_t row,
+    uint32_t rowCount,
+    const char* bitmap,
+    uint32_t* indices);
+uint32_t findNullIndicesAvx512(
+    uint32_t row,
+    uint32_t rowCount,
+    const char* bitmap,
+    uint32_t* indices);
+uint32_t
+findSetBitBmi2(const char* bitmap, uint32_t begin, uint32_t end, uint32_t n);
+#endif // __x86_64__
+
+} // namespace detail
+
 // Prints out the bits in numeric type in nibbles. Not efficient,
 // only should be used for debugging/prototyping.
 template <typename T>
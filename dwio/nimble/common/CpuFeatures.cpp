@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dwio/nimble/common/CpuFeatures.h"
+
+#include <array>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+
+#include "folly/CpuId.h"
+
+namespace facebook::nimble::cpu {
+
+namespace {
+
+constexpr std::array<std::pair<Feature, std::string_view>, 5> kFeatureNames{{
+    {Feature::Popcnt, "popcnt"},
+    {Feature::Bmi2, "bmi2"},
+    {Feature::Ssse3, "ssse3"},
+    {Feature::Avx2, "avx2"},
+    {Feature::Avx512, "avx512"},
+}};
+
+constexpr std::string_view kDisabledFeaturesVariable =
+    "NIMBLE_DISABLED_CPU_FEATURES";
+
+Feature detectFeatures() {
+  Feature detected = Feature::None;
+#ifdef __x86_64__
+  folly::CpuId cpuId;
+  const std::array<std::pair<Feature, bool>, 5> supported{{
+      {Feature::Popcnt, cpuId.popcnt()},
+      {Feature::Bmi2, cpuId.bmi2()},
+      {Feature::Ssse3, cpuId.ssse3()},
+      {Feature::Avx2, cpuId.avx2()},
+      {Feature::Avx512, cpuId.avx512f() && cpuId.avx512bw()},
+  }};
+  for (const auto& [feature, isSupported] : supported) {
+    if (isSupported) {
+      detected = detected | feature;
+    }
+  }
+#endif // __x86_64__
+
+  const char* disabled = std::getenv(kDisabledFeaturesVariable.data());
+  if (disabled == nullptr) {
+    return detected;
+  }
+  std::string_view remaining{disabled};
+  while (!remaining.empty()) {
+    const auto separator = remaining.find(',');
+    const auto name = remaining.substr(0, separator);
+    for (const auto& [feature, featureName] : kFeatureNames) {
+      if (name == featureName) {
+        detected = detected & ~feature;
+      }
+    }
+    remaining = separator == std::string_view::npos
+        ? std::string_view{}
+        : remaining.substr(separator + 1);
+  }
+  return detected;
+}
+
+struct KernelRegistry {
+  std::mutex mutex;
+  // Keyed by kernel name. Templated kernels register once per instantiation.
+  std::map<std::string, KernelInfo> kernels;
+};
+
+KernelRegistry& kernelRegistry() {
+  static KernelRegistry registry;
+  return registry;
+}
+
+} // namespace
+
+Feature features() {
+  static const Feature features = detectFeatures();
+  return features;
+}
+
+std::string toString(Feature features) {
+  std::string result;
+  for (const auto& [feature, name] : kFeatureNames) {
+    if ((features & feature) == feature) {
+      if (!result.empty()) {
+        result += ',';
+      }
+      result += name;
+    }
+  }
+  return result;
+}
+
+std::vector<KernelInfo> activeKernels() {
+  auto& registry = kernelRegistry();
+  std::lock_guard<std::mutex> lock{registry.mutex};
+  std::vector<KernelInfo> kernels;
+  kernels.reserve(registry.kernels.size());
+  for (const auto& [_, info] : registry.kernels) {
+    kernels.push_back(info);
+  }
+  return kernels;
+}
+
+namespace detail {
+
+void registerKernel(KernelInfo info) {
+  auto& registry = kernelRegistry();
+  std::lock_guard<std::mutex> lock{registry.mutex};
+  auto name = info.name;
+  registry.kernels.insert_or_assign(std::move(name), std::move(info));
+}
+
+} // namespace detail
+
+} // namespace facebook::nimble::cpu
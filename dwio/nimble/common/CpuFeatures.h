@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "dwio/nimble/common/Exceptions.h"
+
+// Runtime CPU feature detection and kernel dispatch.
+//
+// Hot kernels can have multiple implementations (variants), each requiring a
+// set of CPU features. A Kernel picks the first variant supported by the
+// current CPU, once, so a single binary runs the best available implementation
+// on every machine in a heterogeneous fleet. Selected variants are recorded,
+// so tools can report which implementations are active (see activeKernels()).
+//
+// Features can be disabled by listing them (comma separated, e.g.
+// "avx2,bmi2") in the NIMBLE_DISABLED_CPU_FEATURES environment variable. This
+// is useful to test and benchmark fallback variants on newer machines.
+
+namespace facebook::nimble::cpu {
+
+enum class Feature : uint32_t {
+  None = 0,
+  Popcnt = 1 << 0,
+  Bmi2 = 1 << 1,
+  Ssse3 = 1 << 2,
+  Avx2 = 1 << 3,
+  // AVX-512 Foundation and Byte/Word instructions.
+  Avx512 = 1 << 4,
+};
+
+constexpr Feature operator|(Feature lhs, Feature rhs) {
+  return static_cast<Feature>(
+      static_cast<uint32_t>(lhs) | static_cast<uint32_t>(rhs));
+}
+
+constexpr Feature operator&(Feature lhs, Feature rhs) {
+  return static_cast<Feature>(
+      static_cast<uint32_t>(lhs) & static_cast<uint32_t>(rhs));
+}
+
+constexpr Feature operator~(Feature feature) {
+  return static_cast<Feature>(~static_cast<uint32_t>(feature));
+}
+
+// Returns the (enabled) features of the current CPU.
+Feature features();
+
+// Returns true if the current CPU supports all of |required|.
+inline bool supports(Feature required) {
+  return (features() & required) == required;
+}
+
+// Returns the names of |features|, comma separated.
+std::string toString(Feature features);
+
+template <typename Fn>
+struct KernelVariant {
+  std::string_view name;
+  Feature features;
+  Fn function;
+};
+
+struct KernelInfo {
+  std::string name;
+  // The selected variant.
+  std::string variant;
+  // All variants, in order of preference.
+  std::vector<std::string> variants;
+};
+
+// Returns the kernels selected so far, sorted by name.
+std::vector<KernelInfo> activeKernels();
+
+namespace detail {
+void registerKernel(KernelInfo info);
+} // namespace detail
+
+// A dispatched kernel. Kernels are meant to be defined at namespace scope (so
+// their selection shows up in activeKernels() as soon as the binary starts),
+// and so shouldn't be called from static initializers in other translation
+// units.
+template <typename Fn>
+class Kernel {
+ public:
+  // |variants| are ordered by preference. The last variant should be a
+  // portable fallback (requiring no features).
+  Kernel(
+      std::string_view name,
+      std::initializer_list<KernelVariant<Fn>> variants) {
+    KernelInfo info{.name = std::string{name}};
+    for (const auto& variant : variants) {
+      info.variants.emplace_back(variant.name);
+      if (function_ == nullptr && supports(variant.features)) {
+        function_ = variant.function;
+        info.variant = std::string{variant.name};
+      }
+    }
+    NIMBLE_CHECK(
+        function_ != nullptr,
+        fmt::format("No supported variant for kernel {}.", name));
+    detail::registerKernel(std::move(info));
+  }
+
+  template <typename... Args>
+  decltype(auto) operator()(Args&&... args) const {
+    return function_(std::forward<Args>(args)...);
+  }
+
+ private:
+  Fn function_ = nullptr;
+};
+
+} // namespace facebook::nimble::cpu
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "velox/buffer/Buffer.h"
+#include "velox/common/memory/Memory.h"
+
+// Arena for the small, short lived allocations made while decoding a stripe.
+//
+// Decoding a stripe creates many small buffers (alphabets, index buffers,
+// run lengths...), one or more per nested encoding. With thousands of streams
+// (e.g. flat maps), allocating each of them from the memory pool dominates
+// decoding time. A DecodingArena carves small allocations from large chunks,
+// and releases all of them at once, when destroyed (i.e. when the stripe is
+// unloaded).
+//
+// Allocations are routed to the arena through DecodingArenaScope: Vectors
+// constructed on a thread while a scope is active allocate their (small)
+// buffers from the scope's arena. See Vector.h.
+
+namespace facebook::nimble {
+
+struct DecodingArenaStats {
+  // Allocations served by the arena, i.e. memory pool allocations avoided.
+  uint64_t allocationCount{0};
+  uint64_t allocatedBytes{0};
+  // Memory pool allocations backing the arena.
+  uint64_t chunkCount{0};
+  uint64_t chunkBytes{0};
+  // Allocations too large for the arena, served by the memory pool.
+  uint64_t oversizedCount{0};
+};
+
+// DecodingArena is threadsafe, as streams of a stripe can be decoded in
+// parallel.
+class DecodingArena {
+  using MemoryPool = facebook::velox::memory::MemoryPool;
+
+ public:
+  static constexpr uint64_t kDefaultChunkSize = 64 << 10;
+  static constexpr uint64_t kDefaultMaxAllocationSize = 4 << 10;
+
+  explicit DecodingArena(
+      MemoryPool& memoryPool,
+      uint64_t chunkSize = kDefaultChunkSize,
+      uint64_t maxAllocationSize = kDefaultMaxAllocationSize)
+      : memoryPool_{memoryPool},
+        chunkSize_{std::max(chunkSize, maxAllocationSize)},
+        maxAllocationSize_{maxAllocationSize} {}
+
+  // Returns |bytes| bytes, aligned to |alignment| (a power of two, at most
+  // alignof(std::max_align_t)), valid for the lifetime of *this. Returns
+  // nullptr if |bytes| is larger than the max allocation size, in which case
+  // the caller should allocate from the memory pool instead.
+  void* allocate(uint64_t bytes, uint64_t alignment) {
+    std::scoped_lock<std::mutex> l(mutex_);
+    if (bytes > maxAllocationSize_) {
+      ++stats_.oversizedCount;
+      return nullptr;
+    }
+    if (pos_ == nullptr || padding(alignment) + bytes > chunkEnd_ - pos_) {
+      addChunk();
+    }
+    pos_ += padding(alignment);
+    char* result = pos_;
+    pos_ += bytes;
+    ++stats_.allocationCount;
+    stats_.allocatedBytes += bytes;
+    return result;
+  }
+
+  DecodingArenaStats stats() const {
+    std::scoped_lock<std::mutex> l(mutex_);
+    return stats_;
+  }
+
+ private:
+  uint64_t padding(uint64_t alignment) const {
+    return -reinterpret_cast<uintptr_t>(pos_) & (alignment - 1);
+  }
+
+  void addChunk() {
+    auto chunk = velox::AlignedBuffer::allocate<char>(chunkSize_, &memoryPool_);
+    pos_ = chunk->asMutable<char>();
+    chunkEnd_ = pos_ + chunkSize_;
+    chunks_.push_back(std::move(chunk));
+    ++stats_.chunkCount;
+    stats_.chunkBytes += chunkSize_;
+  }
+
+  MemoryPool& memoryPool_;
+  const uint64_t chunkSize_;
+  const uint64_t maxAllocationSize_;
+  char* pos_{nullptr};
+  char* chunkEnd_{nullptr};
+  std::vector<velox::BufferPtr> chunks_;
+  DecodingArenaStats stats_;
+  mutable std::mutex mutex_;
+};
+
+// Routes the allocations of Vectors constructed on this thread to |arena|,
+// for the lifetime of the scope. A nullptr arena disables routing (e.g. within
+// an outer scope). Vectors keep allocating from the arena after the scope
+// ends, so they must not outlive the arena.
+class DecodingArenaScope {
+ public:
+  explicit DecodingArenaScope(DecodingArena* arena)
+      : previous_{Context::get().arena} {
+    Context::get().arena = arena;
+  }
+
+  ~DecodingArenaScope() {
+    Context::get().arena = previous_;
+  }
+
+  static DecodingArena* getArena() {
+    return Context::get().arena;
+  }
+
+ private:
+  struct Context {
+    DecodingArena* arena;
+
+    static Context& get();
+  };
+
+  DecodingArena* const previous_;
+};
+
+} // namespace facebook::nimble
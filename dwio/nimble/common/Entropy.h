@@ -15,8 +15,14 @@
  */
 #pragma once
 
+#include <array>
+#include <cmath>
+#include <cstring>
 #include <span>
+#include <string_view>
+#include <vector>
 #include "folly/container/F14Map.h"
+#include "folly/container/F14Set.h"
 
 // Entropy encoding.
 
@@ -47,4 +53,54 @@ double computeEntropy(std::span<const T> data) {
   return entropy(finalCounts, data.size());
 }
 
+// Fast probe estimating how well a general purpose (LZ + entropy coding)
+// compressor will compress the data. Only evenly spaced blocks of the data,
+// totaling up to |sampleSize| bytes, are inspected.
+// Returns the estimated compressed size, as a fraction of the original size.
+// The estimate combines the byte (order-0) entropy of the sample with the
+// fraction of repeated 4 byte sequences in the sample, which LZ matching can
+// eliminate (and the byte entropy doesn't capture).
+inline double estimateCompressionRatio(
+    std::string_view data,
+    uint32_t sampleSize = 4096) {
+  constexpr uint32_t kBlockSize = 256;
+  constexpr uint32_t kSequenceSize = sizeof(uint32_t);
+  if (data.empty()) {
+    return 1.0;
+  }
+
+  std::array<int, 256> byteCounts{};
+  folly::F14FastSet<uint32_t> sequences;
+  uint64_t sequenceCount = 0;
+  uint64_t repeatedSequenceCount = 0;
+  int sampledSize = 0;
+  const uint64_t blockCount = std::max<uint64_t>(
+      1, std::min<uint64_t>(data.size(), sampleSize) / kBlockSize);
+  const uint64_t stride = data.size() / blockCount;
+  for (uint64_t i = 0; i < blockCount; ++i) {
+    const auto block = data.substr(i * stride, kBlockSize);
+    for (auto c : block) {
+      ++byteCounts[static_cast<uint8_t>(c)];
+    }
+    sampledSize += block.size();
+    for (auto j = 0; j + kSequenceSize <= block.size(); ++j) {
+      uint32_t sequence;
+      std::memcpy(&sequence, block.data() + j, kSequenceSize);
+      ++sequenceCount;
+      repeatedSequenceCount += !sequences.insert(sequence).second;
+    }
+  }
+
+  std::vector<int> counts;
+  for (auto count : byteCounts) {
+    if (count > 0) {
+      counts.push_back(count);
+    }
+  }
+  const double repeatedRatio = sequenceCount == 0
+      ? 0.0
+      : static_cast<double>(repeatedSequenceCount) / sequenceCount;
+  return (1.0 - repeatedRatio) * entropy(counts, sampledSize) / 8;
+}
+
 } // namespace facebook::nimble::entropy
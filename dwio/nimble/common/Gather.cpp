@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif //__x86_64__
+
+#include <algorithm>
+#include <cstring>
+
+#include "dwio/nimble/common/CpuFeatures.h"
+#include "dwio/nimble/common/Gather.h"
+#include "folly/CPortability.h"
+
+namespace facebook::nimble::gather {
+
+namespace {
+
+template <typename T>
+FOLLY_ALWAYS_INLINE void gatherScalar(
+    const T* alphabet,
+    const uint32_t* indices,
+    uint64_t n,
+    T* output) {
+  for (uint64_t i = 0; i < n; ++i) {
+    // Indices may alias (wider) output values, so read them through memcpy.
+    uint32_t index;
+    std::memcpy(&index, indices + i, sizeof(index));
+    output[i] = alphabet[index];
+  }
+}
+
+template <typename T>
+using Gather = void (*)(const T*, uint32_t, const uint32_t*, uint64_t, T*);
+
+const cpu::Kernel<Gather<uint32_t>> gather32Kernel{
+    "gather::gather32",
+    {
+#ifdef __x86_64__
+        {"avx512", cpu::Feature::Avx512, detail::gather32Avx512},
+        {"avx2", cpu::Feature::Avx2, detail::gather32Avx2},
+#endif // __x86_64__
+        {"scalar", cpu::Feature::None, detail::gather32Scalar},
+    }};
+
+const cpu::Kernel<Gather<uint64_t>> gather64Kernel{
+    "gather::gather64",
+    {
+#ifdef __x86_64__
+        {"avx512", cpu::Feature::Avx512, detail::gather64Avx512},
+        {"avx2", cpu::Feature::Avx2, detail::gather64Avx2},
+#endif // __x86_64__
+        {"scalar", cpu::Feature::None, detail::gather64Scalar},
+    }};
+
+} // namespace
+
+void gather32(
+    const uint32_t* alphabet,
+    uint32_t alphabetSize,
+    const uint32_t* indices,
+    uint64_t n,
+    uint32_t* output) {
+  gather32Kernel(alphabet, alphabetSize, indices, n, output);
+}
+
+void gather64(
+    const uint64_t* alphabet,
+    uint32_t alphabetSize,
+    const uint32_t* indices,
+    uint64_t n,
+    uint64_t* output) {
+  gather64Kernel(alphabet, alphabetSize, indices, n, output);
+}
+
+namespace detail {
+
+void gather32Scalar(
+    const uint32_t* alphabet,
+    uint32_t /* alphabetSize */,
+    const uint32_t* indices,
+    uint64_t n,
+    uint32_t* output) {
+  gatherScalar(alphabet, indices, n, output);
+}
+
+void gather64Scalar(
+    const uint64_t* alphabet,
+    uint32_t /* alphabetSize */,
+    const uint32_t* indices,
+    uint64_t n,
+    uint64_t* output) {
+  gatherScalar(alphabet, indices, n, output);
+}
+
+#ifdef __x86_64__
+__attribute__((__target__("avx2"))) void gather32Avx2(
+    const uint32_t* alphabet,
+    uint32_t alphabetSize,
+    const uint32_t* indices,
+    uint64_t n,
+    uint32_t* output) {
+  uint64_t i = 0;
+  if (alphabetSize <= 8) {
+    // The whole alphabet fits in a register.
+    uint32_t table[8] = {};
+    std::copy(alphabet, alphabet + alphabetSize, table);
+    const auto values =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(table));
+    for (; i + 8 <= n; i += 8) {
+      const auto index =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+      _mm256_storeu_si256(
+          reinterpret_cast<__m256i*>(output + i),
+          _mm256_permutevar8x32_epi32(values, index));
+    }
+  } else {
+    for (; i + 8 <= n; i += 8) {
+      const auto index =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+      _mm256_storeu_si256(
+          reinterpret_cast<__m256i*>(output + i),
+          _mm256_i32gather_epi32(
+              reinterpret_cast<const int*>(alphabet), index, 4));
+    }
+  }
+  gatherScalar(alphabet, indices + i, n - i, output + i);
+}
+
+__attribute__((__target__("avx2"))) void gather64Avx2(
+    const uint64_t* alphabet,
+    uint32_t /* alphabetSize */,
+    const uint32_t* indices,
+    uint64_t n,
+    uint64_t* output) {
+  uint64_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const auto index =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(output + i),
+        _mm256_i32gather_epi64(
+            reinterpret_cast<const long long*>(alphabet), index, 8));
+  }
+  gatherScalar(alphabet, indices + i, n - i, output + i);
+}
+
+__attribute__((__target__("avx512f"))) void gather32Avx512(
+    const uint32_t* alphabet,
+    uint32_t alphabetSize,
+    const uint32_t* indices,
+    uint64_t n,
+    uint32_t* output) {
+  uint64_t i = 0;
+  if (alphabetSize <= 16) {
+    // The whole alphabet fits in a register.
+    uint32_t table[16] = {};
+    std::copy(alphabet, alphabet + alphabetSize, table);
+    const auto values = _mm512_loadu_si512(table);
+    for (; i + 16 <= n; i += 16) {
+      const auto index = _mm512_loadu_si512(indices + i);
+      _mm512_storeu_si512(output + i, _mm512_permutexvar_epi32(index, values));
+    }
+  } else {
+    for (; i + 16 <= n; i += 16) {
+      const auto index = _mm512_loadu_si512(indices + i);
+      _mm512_storeu_si512(
+          output + i, _mm512_i32gather_epi32(index, alphabet, 4));
+    }
+  }
+  gatherScalar(alphabet, indices + i, n - i, output + i);
+}
+
+__attribute__((__target__("avx512f"))) void gather64Avx512(
+    const uint64_t* alphabet,
+    uint32_t alphabetSize,
+    const uint32_t* indices,
+    uint64_t n,
+    uint64_t* output) {
+  uint64_t i = 0;
+  if (alphabetSize <= 8) {
+    // The whole alphabet fits in a register.
+    uint64_t table[8] = {};
+    std::copy(alphabet, alphabet + alphabetSize, table);
+    const auto values = _mm512_loadu_si512(table);
+    for (; i + 8 <= n; i += 8) {
+      const auto index = _mm512_cvtepu32_epi64(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i)));
+      _mm512_storeu_si512(output + i, _mm512_permutexvar_epi64(index, values));
+    }
+  } else {
+    for (; i + 8 <= n; i += 8) {
+      const auto index =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+      _mm512_storeu_si512(
+          output + i, _mm512_i32gather_epi64(index, alphabet, 8));
+    }
+  }
+  gatherScalar(alphabet, indices + i, n - i, output + i);
+}
+#endif // __x86_64__
+
+} // namespace detail
+
+} // namespace facebook::nimble::gather
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+
+// Dictionary gathers: output[i] = alphabet[indices[i]].
+//
+// Gathers are dispatched at runtime (see CpuFeatures.h) to AVX-512, AVX2 or
+// scalar implementations. Small alphabets, which fit in a single vector
+// register, are looked up using register permutes instead of memory gathers.
+//
+// To let callers decode indices straight into the output buffer, |indices|
+// may alias |output|, as long as the indices occupy the last n * 4 bytes of
+// the output buffer (for 4 byte values, this is the whole buffer). Each block
+// of indices is loaded before the block of values overwriting it is stored.
+//
+// Like the varint methods, no functions in this library check bounds. All
+// indices must be smaller than |alphabetSize|.
+
+namespace facebook::nimble::gather {
+
+void gather32(
+    const uint32_t* alphabet,
+    uint32_t alphabetSize,
+    const uint32_t* indices,
+    uint64_t n,
+    uint32_t* output);
+
+void gather64(
+    const uint64_t* alphabet,
+    uint32_t alphabetSize,
+    const uint32_t* indices,
+    uint64_t n,
+    uint64_t* output);
+
+namespace detail {
+
+// The different gather implementations. Exposed for tests and benchmarks.
+// Prefer using gather32() and gather64(), which pick the best one for the
+// current CPU.
+void gather32Scalar(
+    const uint32_t* alphabet,
+    uint32_t alphabetSize,
+    const uint32_t* indices,
+    uint64_t n,
+    uint32_t* output);
+
+void gather64Scalar(
+    const uint64_t* alphabet,
+    uint32_t alphabetSize,
+    const uint32_t* indices,
+    uint64_t n,
+    uint64_t* output);
+
+#ifdef __x86_64__
+void gather32Avx2(
+    const uint32_t* alphabet,
+    uint32_t alphabetSize,
+    const uint32_t* indices,
+    uint64_t n,
+    uint32_t* output);
+
+void gather64Avx2(
+    const uint64_t* alphabet,
+    uint32_t alphabetSize,
+    const uint32_t* indices,
+    uint64_t n,
+    uint64_t* output);
+
+void gather32Avx512(
+    const uint32_t* alphabet,
+    uint32_t alphabetSize,
+    const uint32_t* indices,
+    uint64_t n,
+    uint32_t* output);
+
+void gather64Avx512(
+    const uint64_t* alphabet,
+    uint32_t alphabetSize,
+    const uint32_t* indices,
+    uint64_t n,
+    uint64_t* output);
+#endif // __x86_64__
+
+} // namespace detail
+
+} // namespace facebook::nimble::gather
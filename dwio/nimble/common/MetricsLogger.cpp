@@ -23,6 +23,22 @@ folly::dynamic StripeLoadMetrics::serialize() const {
   obj["rowsInStripe"] = rowsInStripe;
   obj["streamCount"] = streamCount;
   obj["totalStreamSize"] = totalStreamSize;
+  obj["arenaAllocationCount"] = arenaAllocationCount;
+  obj["arenaChunkCount"] = arenaChunkCount;
+  obj["arenaChunkBytes"] = arenaChunkBytes;
+  obj["ioRegionCount"] = ioRegionCount;
+  obj["ioBytesRequested"] = ioBytesRequested;
+  obj["ioWallTimeUsec"] = ioWallTimeUsec;
+  obj["ioWaitUsec"] = ioWaitUsec;
+  obj["decompressCpuUsec"] = decompressCpuUsec;
+  obj["decodeCpuUsec"] = decodeCpuUsec;
+  folly::dynamic histogram = folly::dynamic::object;
+  for (const auto& [encodingType, count] : encodingHistogram) {
+    histogram[toString(encodingType)] = count;
+  }
+  obj["encodingHistogram"] = std::move(histogram);
+  obj["cpuUsec"] = cpuUsec;
+  obj["wallTimeUsec"] = wallTimeUsec;
   return obj;
 }
 
@@ -35,6 +51,18 @@ folly::dynamic StripeFlushMetrics::serialize() const {
   return obj;
 }
 
+folly::dynamic StreamEncodeMetrics::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["stripeIndex"] = stripeIndex;
+  obj["streamOffset"] = streamOffset;
+  obj["rawSize"] = rawSize;
+  obj["encodedSize"] = encodedSize;
+  obj["sliceCount"] = sliceCount;
+  obj["cpuUsec"] = cpuUsec;
+  obj["wallTimeUsec"] = wallTimeUsec;
+  return obj;
+}
+
 folly::dynamic FileCloseMetrics::serialize() const {
   folly::dynamic obj = folly::dynamic::object;
   obj["rowCount"] = rowCount;
@@ -15,7 +15,10 @@
  */
 #pragma once
 
+#include <map>
+
 #include <folly/json/dynamic.h>
+#include "dwio/nimble/common/Types.h"
 
 namespace facebook::nimble {
 
@@ -24,9 +27,28 @@ struct StripeLoadMetrics {
   uint32_t rowsInStripe;
   uint32_t streamCount{0};
   uint32_t totalStreamSize{0};
-  // TODO: add IO sizes.
-
-  // TODO: add encoding summary
+  // Decoding arena usage, for the chunks decoded during the stripe load.
+  // arenaAllocationCount is the number of memory pool allocations avoided.
+  uint64_t arenaAllocationCount{0};
+  uint64_t arenaChunkCount{0};
+  uint64_t arenaChunkBytes{0};
+
+  // Stream I/O (see TabletReader::load). One region is requested per loaded
+  // stream.
+  uint32_t ioRegionCount{0};
+  uint64_t ioBytesRequested{0};
+  uint64_t ioWallTimeUsec{0};
+  // Time the reader was blocked, waiting for the stripe to be loaded. Close to
+  // zero when the stripe was prefetched.
+  uint64_t ioWaitUsec{0};
+
+  // CPU time spent decompressing and decoding (i.e. creating the encodings
+  // of) the first chunk of each stream, when loading the stripe.
+  uint64_t decompressCpuUsec{0};
+  uint64_t decodeCpuUsec{0};
+
+  // Number of loaded streams per (top level) encoding type.
+  std::map<EncodingType, uint32_t> encodingHistogram;
 
   size_t cpuUsec;
   size_t wallTimeUsec;
@@ -59,6 +81,23 @@ struct StripeFlushMetrics {
   folly::dynamic serialize() const;
 };
 
+// Encoding metrics of a single stream, reported every time the stream is
+// encoded (on every chunk/stripe flush).
+struct StreamEncodeMetrics {
+  uint64_t stripeIndex;
+  uint32_t streamOffset;
+  uint64_t rawSize;
+  uint64_t encodedSize;
+  // Number of slices the stream was split into, to be encoded in parallel.
+  uint32_t sliceCount;
+
+  // Perf stats (summed across all slices).
+  uint64_t cpuUsec;
+  uint64_t wallTimeUsec;
+
+  folly::dynamic serialize() const;
+};
+
 struct FileCloseMetrics {
   uint64_t rowCount;
   uint64_t inputSize;
@@ -90,6 +129,8 @@ class MetricsLogger {
 
   virtual void logStripeLoad(const StripeLoadMetrics& /* metrics */) const {}
   virtual void logStripeFlush(const StripeFlushMetrics& /* metrics */) const {}
+  virtual void logStreamEncode(
+      const StreamEncodeMetrics& /* metrics */) const {}
   virtual void logFileClose(const FileCloseMetrics& /* metrics */) const {}
   virtual void logCompressionContext(const std::string&) const {}
 };
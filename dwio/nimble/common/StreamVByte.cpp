@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif //__x86_64__
+
+#include <algorithm>
+#include <array>
+
+#include "dwio/nimble/common/CpuFeatures.h"
+#include "dwio/nimble/common/StreamVByte.h"
+
+namespace facebook::nimble::streamvbyte {
+
+namespace {
+
+// Returns the length code (byte length minus one) of |value|.
+inline uint32_t lengthCode(uint32_t value) {
+  return (31 - __builtin_clz(value | 1U)) / 8;
+}
+
+constexpr std::array<uint8_t, 256> makeLengthTable() {
+  std::array<uint8_t, 256> table{};
+  for (uint32_t control = 0; control < 256; ++control) {
+    for (uint32_t i = 0; i < 4; ++i) {
+      table[control] += ((control >> (2 * i)) & 3) + 1;
+    }
+  }
+  return table;
+}
+
+struct alignas(16) ShuffleMask {
+  uint8_t bytes[16];
+};
+
+constexpr std::array<ShuffleMask, 256> makeShuffleTable() {
+  std::array<ShuffleMask, 256> table{};
+  for (uint32_t control = 0; control < 256; ++control) {
+    uint8_t offset = 0;
+    for (uint32_t i = 0; i < 4; ++i) {
+      const uint8_t length = ((control >> (2 * i)) & 3) + 1;
+      for (uint8_t j = 0; j < 4; ++j) {
+        // Shuffle indices with the high bit set produce zero bytes.
+        table[control].bytes[4 * i + j] = j < length ? offset + j : 0xFF;
+      }
+      offset += length;
+    }
+  }
+  return table;
+}
+
+// Total data length of the group described by each control byte.
+constexpr auto kLengthTable = makeLengthTable();
+
+// For each control byte, the shuffle mask spreading the group's values (1 to 4
+// bytes each) into 4 byte lanes.
+constexpr auto kShuffleTable = makeShuffleTable();
+
+const char* decodeScalar(
+    uint64_t n,
+    const uint8_t* control,
+    const char* data,
+    const char* /* dataEnd */,
+    uint32_t* output) {
+  return detail::decodeScalar(n, control, data, output);
+}
+
+using Decode = const char* (*)(uint64_t,
+                               const uint8_t*,
+                               const char*,
+                               const char*,
+                               uint32_t*);
+
+const cpu::Kernel<Decode> decodeKernel{
+    "streamvbyte::decode",
+    {
+#ifdef __x86_64__
+        {"avx2", cpu::Feature::Avx2, detail::decodeAvx2},
+        {"ssse3", cpu::Feature::Ssse3, detail::decodeSsse3},
+#endif // __x86_64__
+        {"scalar", cpu::Feature::None, decodeScalar},
+    }};
+
+} // namespace
+
+uint64_t dataSize(std::span<const uint32_t> values, uint32_t baseline) {
+  uint64_t size = 0;
+  for (auto value : values) {
+    size += lengthCode(value - baseline) + 1;
+  }
+  return size;
+}
+
+char* encode(
+    std::span<const uint32_t> values,
+    uint32_t baseline,
+    uint8_t* control,
+    char* data) {
+  for (size_t group = 0; group < values.size(); group += 4) {
+    const auto groupEnd = std::min(group + 4, values.size());
+    uint8_t controlByte = 0;
+    for (auto i = group; i < groupEnd; ++i) {
+      const uint32_t value = values[i] - baseline;
+      const uint32_t code = lengthCode(value);
+      controlByte |= code << (2 * (i - group));
+      std::memcpy(data, &value, code + 1);
+      data += code + 1;
+    }
+    *control++ = controlByte;
+  }
+  return data;
+}
+
+const char* decode(
+    uint64_t n,
+    const uint8_t* control,
+    const char* data,
+    const char* dataEnd,
+    uint32_t* output) {
+  return decodeKernel(n, control, data, dataEnd, output);
+}
+
+const char* skip(uint64_t n, const uint8_t* control, const char* data) {
+  for (; n >= 4; n -= 4) {
+    data += kLengthTable[*control++];
+  }
+  for (uint32_t i = 0; i < n; ++i) {
+    data += valueLength(*control, i);
+  }
+  return data;
+}
+
+namespace detail {
+
+const char* decodeScalar(
+    uint64_t n,
+    const uint8_t* control,
+    const char* data,
+    uint32_t* output) {
+  for (uint64_t i = 0; i < n; ++i) {
+    *output++ = readValue(&data, valueLength(control[i / 4], i % 4));
+  }
+  return data;
+}
+
+#ifdef __x86_64__
+__attribute__((__target__("ssse3"))) const char* decodeSsse3(
+    uint64_t n,
+    const uint8_t* control,
+    const char* data,
+    const char* dataEnd,
+    uint32_t* output) {
+  // Each group loads 16 data bytes, even if the group itself is shorter.
+  while (n >= 4 && dataEnd - data >= 16) {
+    const auto mask = _mm_load_si128(
+        reinterpret_cast<const __m128i*>(kShuffleTable[*control].bytes));
+    const auto input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(output), _mm_shuffle_epi8(input, mask));
+    data += kLengthTable[*control++];
+    output += 4;
+    n -= 4;
+  }
+  return decodeScalar(n, control, data, output);
+}
+
+__attribute__((__target__("avx2"))) const char* decodeAvx2(
+    uint64_t n,
+    const uint8_t* control,
+    const char* data,
+    const char* dataEnd,
+    uint32_t* output) {
+  // Decodes two groups per iteration, one per 128 bit lane. The second group
+  // starts at most 16 bytes after the first one, so both loads end within 32
+  // bytes.
+  while (n >= 8 && dataEnd - data >= 32) {
+    const char* second = data + kLengthTable[control[0]];
+    const auto input = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(second)),
+        1);
+    const auto mask = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_load_si128(
+            reinterpret_cast<const __m128i*>(kShuffleTable[control[0]].bytes))),
+        _mm_load_si128(
+            reinterpret_cast<const __m128i*>(kShuffleTable[control[1]].bytes)),
+        1);
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(output), _mm256_shuffle_epi8(input, mask));
+    data = second + kLengthTable[control[1]];
+    control += 2;
+    output += 8;
+    n -= 8;
+  }
+  return decodeSsse3(n, control, data, dataEnd, output);
+}
+#endif // __x86_64__
+
+} // namespace detail
+
+} // namespace facebook::nimble::streamvbyte
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+// Stream VByte integer encoding (see https://arxiv.org/abs/1709.08990).
+//
+// Each 32 bit value is stored using 1 to 4 (little endian) bytes. Unlike
+// regular varints, the lengths are not interleaved with the data. Instead,
+// lengths are stored in a separate control stream, using 2 bits per value
+// (so each control byte describes a group of 4 values). This allows decoding
+// a full group using a single SIMD shuffle, with a shuffle mask looked up by
+// the control byte. Decoding is dispatched at runtime to an AVX2, SSSE3 or
+// scalar implementation, based on the CPU capabilities.
+//
+// Like the varint methods, no functions in this library check bounds.
+
+namespace facebook::nimble::streamvbyte {
+
+// Returns the number of control bytes required to store |count| values.
+inline uint64_t controlSize(uint64_t count) {
+  return (count + 3) / 4;
+}
+
+// Returns the number of data bytes required to store |values| (after
+// subtracting |baseline| from each value).
+uint64_t dataSize(std::span<const uint32_t> values, uint32_t baseline = 0);
+
+// Encodes |values| (after subtracting |baseline| from each value). Writes
+// controlSize(values.size()) bytes to |control| and dataSize(values) bytes to
+// |data|. Returns |data| updated past the written data bytes.
+char* encode(
+    std::span<const uint32_t> values,
+    uint32_t baseline,
+    uint8_t* control,
+    char* data);
+
+// Decodes |n| values, starting at the first value of the group described by
+// |control|. |dataEnd| is the end of the readable data region. SIMD loads
+// never cross it, so no padding is required after the data. Returns |data|
+// updated past the decoded values.
+const char* decode(
+    uint64_t n,
+    const uint8_t* control,
+    const char* data,
+    const char* dataEnd,
+    uint32_t* output);
+
+// Skips |n| values, starting at the first value of the group described by
+// |control|. Returns |data| updated past the skipped values.
+const char* skip(uint64_t n, const uint8_t* control, const char* data);
+
+// Inline single value methods follow below.
+
+// Returns the length (in bytes) of the |index|th value (0 to 3) of the group
+// described by |control|.
+inline uint32_t valueLength(uint8_t control, uint32_t index) {
+  return ((control >> (2 * index)) & 3) + 1;
+}
+
+inline uint32_t readValue(const char** pos, uint32_t length) {
+  uint32_t value = 0;
+  std::memcpy(&value, *pos, length);
+  *pos += length;
+  return value;
+}
+
+namespace detail {
+
+// The different decoder implementations. Exposed for tests and benchmarks.
+// Prefer using decode(), which picks the best one for the current CPU.
+const char* decodeScalar(
+    uint64_t n,
+    const uint8_t* control,
+    const char* data,
+    uint32_t* output);
+
+#ifdef __x86_64__
+const char* decodeSsse3(
+    uint64_t n,
+    const uint8_t* control,
+    const char* data,
+    const char* dataEnd,
+    uint32_t* output);
+
+const char* decodeAvx2(
+    uint64_t n,
+    const uint8_t* control,
+    const char* data,
+    const char* dataEnd,
+    uint32_t* output);
+#endif // __x86_64__
+
+} // namespace detail
+
+} // namespace facebook::nimble::streamvbyte
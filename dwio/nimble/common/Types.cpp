@@ -48,6 +48,8 @@ std::string toString(EncodingType encodingType) {
       return "MainlyConstant";
     case EncodingType::Sentinel:
       return "Sentinel";
+    case EncodingType::StreamVByte:
+      return "StreamVByte";
   }
   return fmt::format(
       "Unknown encoding type: {}", static_cast<int32_t>(encodingType));
@@ -97,6 +99,10 @@ std::string toString(CompressionType compressionType) {
       return "Zstd";
     case CompressionType::MetaInternal:
       return "MetaInternal";
+    case CompressionType::Lz4:
+      return "Lz4";
+    case CompressionType::ZstdDictionary:
+      return "ZstdDictionary";
     default:
       return fmt::format(
           "Unknown compression type: {}",
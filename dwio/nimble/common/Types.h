@@ -98,6 +98,10 @@ enum class EncodingType {
   // using a bool child vector to store whether each row is that special value,
   // and stores the non-special values as a separate encoding.
   MainlyConstant = 10,
+  // Stores 32 bit integer types using Stream VByte encoding, i.e. byte aligned
+  // values with their lengths stored in separate control bytes, allowing SIMD
+  // decoding. Like Varint, values are stored relative to the minimum value.
+  StreamVByte = 11,
 };
 std::string toString(EncodingType encodingType);
 std::ostream& operator<<(std::ostream& out, EncodingType encodingType);
@@ -128,6 +132,11 @@ enum class CompressionType : uint8_t {
   // Zstd doesn't require us to externally store level or any other info.
   Zstd = 1,
   MetaInternal = 2,
+  // LZ4 block compression, optimized for decompression speed.
+  Lz4 = 3,
+  // Zstd compression using the file's trained dictionary (stored in the
+  // columnar.zstd_dictionary optional section). Only used for stream chunks.
+  ZstdDictionary = 4,
 };
 
 std::string toString(CompressionType compressionType);
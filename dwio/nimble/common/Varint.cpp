@@ -21,9 +21,9 @@
 #include "common/aarch64/compat.h"
 #endif //__aarch64__
 
+#include "dwio/nimble/common/CpuFeatures.h"
 #include "dwio/nimble/common/Exceptions.h"
 #include "dwio/nimble/common/Varint.h"
-#include "folly/CpuId.h"
 
 namespace facebook::nimble::varint {
 
@@ -70,28 +70,47 @@ __attribute__((__target__("bmi2")))
 const char*
 bulkVarintDecodeBmi2(uint64_t n, const char* pos, T* output);
 
-const char* bulkVarintDecode32(uint64_t n, const char* pos, uint32_t* output) {
-  static bool hasBmi2 = folly::CpuId().bmi2();
-  if (hasBmi2) {
-    return bulkVarintDecodeBmi2(n, pos, output);
-  }
+namespace {
+
+const char*
+bulkVarintDecodeScalar32(uint64_t n, const char* pos, uint32_t* output) {
   for (uint64_t i = 0; i < n; ++i) {
     *output++ = readVarint32(&pos);
   }
   return pos;
 }
 
-const char* bulkVarintDecode64(uint64_t n, const char* pos, uint64_t* output) {
-  static bool hasBmi2 = folly::CpuId().bmi2();
-  if (hasBmi2) {
-    return bulkVarintDecodeBmi2(n, pos, output);
-  }
+const char*
+bulkVarintDecodeScalar64(uint64_t n, const char* pos, uint64_t* output) {
   for (uint64_t i = 0; i < n; ++i) {
     *output++ = readVarint64(&pos);
   }
   return pos;
 }
 
+template <typename T>
+using BulkVarintDecode = const char* (*)(uint64_t, const char*, T*);
+
+const cpu::Kernel<BulkVarintDecode<uint32_t>> bulkVarintDecode32Kernel{
+    "varint::bulkVarintDecode32",
+    {{"bmi2", cpu::Feature::Bmi2, bulkVarintDecodeBmi2<uint32_t>},
+     {"scalar", cpu::Feature::None, bulkVarintDecodeScalar32}}};
+
+const cpu::Kernel<BulkVarintDecode<uint64_t>> bulkVarintDecode64Kernel{
+    "varint::bulkVarintDecode64",
+    {{"bmi2", cpu::Feature::Bmi2, bulkVarintDecodeBmi2<uint64_t>},
+     {"scalar", cpu::Feature::None, bulkVarintDecodeScalar64}}};
+
+} // namespace
+
+const char* bulkVarintDecode32(uint64_t n, const char* pos, uint32_t* output) {
+  return bulkVarintDecode32Kernel(n, pos, output);
+}
+
+const char* bulkVarintDecode64(uint64_t n, const char* pos, uint64_t* output) {
+  return bulkVarintDecode64Kernel(n, pos, output);
+}
+
 // Codegen for the cases below. Useful if we want to try to tweak something
 // (different mask length, etc) in the future.
 
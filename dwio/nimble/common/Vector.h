@@ -15,16 +15,25 @@
  */
 #pragma once
 
+#include "dwio/nimble/common/DecodingArena.h"
 #include "dwio/nimble/common/Exceptions.h"
 #include "velox/buffer/Buffer.h"
 #include "velox/common/memory/Memory.h"
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <memory>
 
 // Basically equivalent to std::vector, but without the edge case for booleans,
 // i.e. data() returns T* for all T. This allows for implicit conversion to
 // std::span for all T.
+//
+// Vectors constructed within a DecodingArenaScope allocate their first buffer
+// from the scope's arena when possible (see DecodingArena.h). Such Vectors
+// must not outlive the arena. Arena memory is never reclaimed before the arena
+// is destroyed, so regrowth, copies and released buffers are always allocated
+// from the memory pool.
 
 namespace facebook::nimble {
 
@@ -35,18 +44,18 @@ class Vector {
 
  public:
   Vector(velox::memory::MemoryPool* memoryPool, size_t size, T value)
-      : memoryPool_{memoryPool} {
+      : memoryPool_{memoryPool}, arena_{DecodingArenaScope::getArena()} {
     init(size);
     std::fill(dataRawPtr_, dataRawPtr_ + size_, value);
   }
 
   Vector(velox::memory::MemoryPool* memoryPool, size_t size)
-      : memoryPool_{memoryPool} {
+      : memoryPool_{memoryPool}, arena_{DecodingArenaScope::getArena()} {
     init(size);
   }
 
   explicit Vector(velox::memory::MemoryPool* memoryPool)
-      : memoryPool_{memoryPool} {
+      : memoryPool_{memoryPool}, arena_{DecodingArenaScope::getArena()} {
     capacity_ = 0;
     size_ = 0;
     data_ = nullptr;
@@ -58,7 +67,7 @@ class Vector {
 
   template <typename It>
   Vector(velox::memory::MemoryPool* memoryPool, It first, It last)
-      : memoryPool_{memoryPool} {
+      : memoryPool_{memoryPool}, arena_{DecodingArenaScope::getArena()} {
     auto size = last - first;
     init(size);
     std::copy(first, last, dataRawPtr_);
@@ -73,6 +82,7 @@ class Vector {
       size_ = other.size();
       capacity_ = other.capacity_;
       memoryPool_ = other.memoryPool_;
+      arena_ = nullptr;
       allocateBuffer();
       std::copy(other.dataRawPtr_, other.dataRawPtr_ + size_, dataRawPtr_);
     }
@@ -88,13 +98,15 @@ class Vector {
       size_ = other.size();
       capacity_ = other.capacity_;
       data_ = std::move(other.data_);
+      // Arena backed vectors have no data_.
+      dataRawPtr_ = other.dataRawPtr_;
 #ifndef NDEBUG
-      dataRawPtr_ = placeholder_.data();
-#endif
-      if (data_ != nullptr) {
-        dataRawPtr_ = reinterpret_cast<T*>(data_->asMutable<InnerType>());
+      if (dataRawPtr_ == nullptr) {
+        dataRawPtr_ = placeholder_.data();
       }
+#endif
       memoryPool_ = other.memoryPool_;
+      arena_ = other.arena_;
       other.size_ = 0;
       other.capacity_ = 0;
     }
@@ -102,7 +114,7 @@ class Vector {
   }
 
   Vector(velox::memory::MemoryPool* memoryPool, std::initializer_list<T> l)
-      : memoryPool_{memoryPool} {
+      : memoryPool_{memoryPool}, arena_{DecodingArenaScope::getArena()} {
     init(l.size());
     std::copy(l.begin(), l.end(), dataRawPtr_);
   }
@@ -161,12 +173,14 @@ class Vector {
     std::fill(dataRawPtr_, dataRawPtr_ + capacity_, value);
   }
 
-  // Resets *this to a newly constructed empty state.
+  // Resets *this to a newly constructed empty state. Detaches *this from its
+  // arena, if any, so later allocations are made from the memory pool.
   void clear() {
     capacity_ = 0;
     size_ = 0;
     data_.reset();
     dataRawPtr_ = nullptr;
+    arena_ = nullptr;
   }
 
   void insert(T* output, const T* inputStart, const T* inputEnd) {
@@ -221,16 +235,13 @@ class Vector {
   void reserve(uint64_t size) {
     if (size > capacity_) {
       capacity_ = size;
-      auto newData =
-          velox::AlignedBuffer::allocate<InnerType>(capacity_, memoryPool_);
-      if (data_ != nullptr && size_ > 0) {
-        std::move(
-            dataRawPtr_,
-            dataRawPtr_ + size_,
-            reinterpret_cast<T*>(newData->template asMutable<InnerType>()));
+      // Keeps the old buffer alive until its content is moved.
+      auto oldData = std::move(data_);
+      auto* oldDataRawPtr = dataRawPtr_;
+      allocateBuffer();
+      if (size_ > 0) {
+        std::move(oldDataRawPtr, oldDataRawPtr + size_, dataRawPtr_);
       }
-      data_ = std::move(newData);
-      dataRawPtr_ = reinterpret_cast<T*>(data_->asMutable<InnerType>());
     }
   }
 
@@ -253,6 +264,14 @@ class Vector {
   }
 
   velox::BufferPtr releaseOwnership() {
+    if (data_ == nullptr) {
+      // Arena backed. The released buffer may outlive the arena, so move the
+      // content to the memory pool.
+      auto* arenaData = dataRawPtr_;
+      arena_ = nullptr;
+      allocateBuffer();
+      std::copy(arenaData, arenaData + size_, dataRawPtr_);
+    }
     velox::BufferPtr tmp = std::move(data_);
     tmp->setSize(size_);
     capacity_ = 0;
@@ -281,12 +300,34 @@ class Vector {
     return newSize;
   }
 
+  // Allocates capacity_ elements, from the arena if possible, otherwise from
+  // the memory pool. Does not copy the existing content. Only the first
+  // (non-empty) allocation is made from the arena: growing Vectors would
+  // otherwise leave a dead arena block behind at each growth step.
   inline void allocateBuffer() {
+    if constexpr (std::is_trivially_copyable_v<InnerType>) {
+      if (arena_ != nullptr && capacity_ > 0) {
+        auto* data = arena_->allocate(
+            capacity_ * sizeof(InnerType),
+            std::max(alignof(InnerType), kArenaAlignment));
+        arena_ = nullptr;
+        if (data != nullptr) {
+          data_ = nullptr;
+          dataRawPtr_ = static_cast<T*>(data);
+          return;
+        }
+      }
+    }
     data_ = velox::AlignedBuffer::allocate<InnerType>(capacity_, memoryPool_);
     dataRawPtr_ = reinterpret_cast<T*>(data_->asMutable<InnerType>());
   }
 
+  static constexpr size_t kArenaAlignment = alignof(std::max_align_t);
+
   velox::memory::MemoryPool* memoryPool_;
+  // Not owned. Only set for Vectors constructed within a DecodingArenaScope,
+  // until their first allocation.
+  DecodingArena* arena_{nullptr};
   velox::BufferPtr data_;
   uint64_t capacity_;
   uint64_t size_;
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <zstd.h>
+#include <memory>
+
+#include "dwio/nimble/common/Exceptions.h"
+
+// Thread local zstd contexts.
+// Creating a zstd context allocates and initializes a few hundred KB of
+// state. ZSTD_compress/ZSTD_decompress do so on every call, which dominates
+// the cost of (de)compressing small payloads. Instead, each thread creates its
+// contexts once, and reuses them for all subsequent calls.
+// Note: Contexts are not reentrant. Callers must not hold on to a context
+// across calls which may (de)compress on the same thread.
+
+namespace facebook::nimble::zstd {
+
+inline ZSTD_CCtx* compressionContext() {
+  thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context{
+      ZSTD_createCCtx(), &ZSTD_freeCCtx};
+  NIMBLE_CHECK(context != nullptr, "Unable to create zstd context.");
+  return context.get();
+}
+
+inline ZSTD_DCtx* decompressionContext() {
+  thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context{
+      ZSTD_createDCtx(), &ZSTD_freeDCtx};
+  NIMBLE_CHECK(context != nullptr, "Unable to create zstd context.");
+  return context.get();
+}
+
+} // namespace facebook::nimble::zstd
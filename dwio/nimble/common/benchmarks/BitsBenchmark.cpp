@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <vector>
+
+#include "dwio/nimble/common/Bits.h"
+#include "folly/Benchmark.h"
+#include "folly/Random.h"
+#include "folly/init/Init.h"
+
+using namespace ::facebook;
+
+// Null processing benchmarks. Each benchmark processes a bitmap of kRowCount
+// rows, with a null ratio varying from dense (1%) to sparse (99%) nulls.
+
+constexpr uint32_t kRowCount = 1024 * 1024;
+
+struct Data {
+  std::unique_ptr<bool[]> bools;
+  std::vector<char> bitmap;
+  std::vector<uint32_t> indices;
+};
+
+Data makeData(uint32_t nullPercent) {
+  Data data;
+  data.bools.reset(new bool[kRowCount]);
+  data.bitmap.resize(nimble::bits::bucketsRequired(kRowCount, 64) * 8);
+  data.indices.resize(kRowCount);
+  for (uint32_t i = 0; i < kRowCount; ++i) {
+    data.bools[i] = folly::Random::rand32(100) >= nullPercent;
+    nimble::bits::maybeSetBit(i, data.bitmap.data(), data.bools[i]);
+  }
+  return data;
+}
+
+Data& data(uint32_t nullPercent) {
+  static Data dense = makeData(1);
+  static Data half = makeData(50);
+  static Data sparse = makeData(99);
+  return nullPercent < 50 ? dense : (nullPercent == 50 ? half : sparse);
+}
+
+template <typename PackBitmap>
+void packBitmap(uint32_t iters, uint32_t nullPercent, PackBitmap pack) {
+  auto& input = data(nullPercent);
+  std::vector<char> bitmap(input.bitmap.size());
+  while (iters--) {
+    std::fill(bitmap.begin(), bitmap.end(), 0);
+    pack({input.bools.get(), kRowCount}, bitmap.data());
+    folly::doNotOptimizeAway(bitmap);
+  }
+}
+
+template <typename CountSetBits>
+void countSetBits(uint32_t iters, uint32_t nullPercent, CountSetBits count) {
+  auto& input = data(nullPercent);
+  while (iters--) {
+    // Start mid word, like most reads do.
+    folly::doNotOptimizeAway(count(3, kRowCount - 3, input.bitmap.data()));
+  }
+}
+
+template <typename FindIndices>
+void findIndices(uint32_t iters, uint32_t nullPercent, FindIndices find) {
+  auto& input = data(nullPercent);
+  while (iters--) {
+    folly::doNotOptimizeAway(find(
+        3, kRowCount - 3, input.bitmap.data(), input.indices.data()));
+  }
+}
+
+template <typename FindSetBit>
+void findSetBit(uint32_t iters, uint32_t nullPercent, FindSetBit find) {
+  auto& input = data(nullPercent);
+  const auto setBits =
+      nimble::bits::countSetBits(0, kRowCount, input.bitmap.data());
+  while (iters--) {
+    folly::doNotOptimizeAway(
+        find(input.bitmap.data(), 3, kRowCount, setBits / 2));
+  }
+}
+
+#define BENCHMARK_NULL_RATIOS(name, function, variant) \
+  BENCHMARK(name##Dense, iters) {                      \
+    function(iters, 1, variant);                       \
+  }                                                    \
+  BENCHMARK(name##Half, iters) {                       \
+    function(iters, 50, variant);                      \
+  }                                                    \
+  BENCHMARK(name##Sparse, iters) {                     \
+    function(iters, 99, variant);                      \
+  }
+
+BENCHMARK_NULL_RATIOS(
+    PackBitmapScalar,
+    packBitmap,
+    nimble::bits::detail::packBitmapScalar)
+#ifdef __x86_64__
+BENCHMARK_NULL_RATIOS(
+    PackBitmapAvx2,
+    packBitmap,
+    nimble::bits::detail::packBitmapAvx2)
+BENCHMARK_NULL_RATIOS(
+    PackBitmapAvx512,
+    packBitmap,
+    nimble::bits::detail::packBitmapAvx512)
+#endif // __x86_64__
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NULL_RATIOS(
+    CountSetBitsScalar,
+    countSetBits,
+    nimble::bits::detail::countSetBitsScalar)
+#ifdef __x86_64__
+BENCHMARK_NULL_RATIOS(
+    CountSetBitsPopcnt,
+    countSetBits,
+    nimble::bits::detail::countSetBitsPopcnt)
+BENCHMARK_NULL_RATIOS(
+    CountSetBitsAvx2,
+    countSetBits,
+    nimble::bits::detail::countSetBitsAvx2)
+#endif // __x86_64__
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NULL_RATIOS(
+    FindNonNullIndicesScalar,
+    findIndices,
+    nimble::bits::detail::findNonNullIndicesScalar)
+#ifdef __x86_64__
+BENCHMARK_NULL_RATIOS(
+    FindNonNullIndicesAvx2,
+    findIndices,
+    nimble::bits::detail::findNonNullIndicesAvx2)
+BENCHMARK_NULL_RATIOS(
+    FindNonNullIndicesAvx512,
+    findIndices,
+    nimble::bits::detail::findNonNullIndicesAvx512)
+#endif // __x86_64__
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NULL_RATIOS(
+    FindNullIndicesScalar,
+    findIndices,
+    nimble::bits::detail::findNullIndicesScalar)
+#ifdef __x86_64__
+BENCHMARK_NULL_RATIOS(
+    FindNullIndicesAvx2,
+    findIndices,
+    nimble::bits::detail::findNullIndicesAvx2)
+BENCHMARK_NULL_RATIOS(
+    FindNullIndicesAvx512,
+    findIndices,
+    nimble::bits::detail::findNullIndicesAvx512)
+#endif // __x86_64__
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NULL_RATIOS(
+    FindSetBitScalar,
+    findSetBit,
+    nimble::bits::detail::findSetBitScalar)
+#ifdef __x86_64__
+BENCHMARK_NULL_RATIOS(
+    FindSetBitBmi2,
+    findSetBit,
+    nimble::bits::detail::findSetBitBmi2)
+#endif // __x86_64__
+
+// Variants not supported by the current CPU crash with an illegal
+// instruction. Use --bm_regex to select supported ones.
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  folly::runBenchmarks();
+  return 0;
+}
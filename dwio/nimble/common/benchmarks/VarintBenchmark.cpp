@@ -17,6 +17,7 @@
 #include <memory>
 #include <vector>
 
+#include "dwio/nimble/common/StreamVByte.h"
 #include "dwio/nimble/common/Varint.h"
 #include "folly/Benchmark.h"
 #include "folly/Random.h"
@@ -333,6 +334,97 @@ BENCHMARK(DwrfDecodeSkewed, iters) {
   }
 }
 
+// Stream VByte encoded data: control bytes followed by data bytes.
+struct StreamVByteData {
+  std::vector<uint8_t> control;
+  std::vector<char> data;
+};
+
+StreamVByteData MakeStreamVByteData(const std::vector<uint32_t>& values) {
+  StreamVByteData encoded;
+  encoded.control.resize(nimble::streamvbyte::controlSize(values.size()));
+  encoded.data.resize(nimble::streamvbyte::dataSize(values));
+  nimble::streamvbyte::encode(
+      values, 0, encoded.control.data(), encoded.data.data());
+  return encoded;
+}
+
+BENCHMARK(StreamVByteEncode, iters) {
+  std::vector<uint32_t> data;
+  std::vector<uint8_t> control;
+  std::unique_ptr<char[]> buf;
+  BENCHMARK_SUSPEND {
+    data = MakeUniformData();
+    control.resize(nimble::streamvbyte::controlSize(kNumElements));
+    buf = std::make_unique<char[]>(kNumElements * sizeof(uint32_t));
+  }
+  while (iters--) {
+    char* pos = nimble::streamvbyte::encode(data, 0, control.data(), buf.get());
+    CHECK_GE(pos - buf.get(), kNumElements);
+  }
+}
+
+void StreamVByteDecode(
+    size_t iters,
+    std::vector<uint32_t> (*makeData)(int),
+    const char* (*decode)(
+        uint64_t, const uint8_t*, const char*, const char*, uint32_t*)) {
+  std::vector<uint32_t> data;
+  StreamVByteData encoded;
+  std::vector<uint32_t> recovered;
+  BENCHMARK_SUSPEND {
+    recovered.resize(kNumElements);
+    data = makeData(kNumElements);
+    encoded = MakeStreamVByteData(data);
+  }
+  while (iters--) {
+    decode(
+        kNumElements,
+        encoded.control.data(),
+        encoded.data.data(),
+        encoded.data.data() + encoded.data.size(),
+        recovered.data());
+    CHECK_EQ(recovered.back(), data.back());
+  }
+}
+
+const char* StreamVByteDecodeScalar(
+    uint64_t n,
+    const uint8_t* control,
+    const char* data,
+    const char* /* dataEnd */,
+    uint32_t* output) {
+  return nimble::streamvbyte::detail::decodeScalar(n, control, data, output);
+}
+
+BENCHMARK(StreamVByteDecodeUniform, iters) {
+  StreamVByteDecode(iters, MakeUniformData, nimble::streamvbyte::decode);
+}
+
+BENCHMARK(StreamVByteScalarDecodeUniform, iters) {
+  StreamVByteDecode(iters, MakeUniformData, StreamVByteDecodeScalar);
+}
+
+#ifdef __x86_64__
+BENCHMARK(StreamVByteSsse3DecodeUniform, iters) {
+  StreamVByteDecode(
+      iters, MakeUniformData, nimble::streamvbyte::detail::decodeSsse3);
+}
+
+BENCHMARK(StreamVByteAvx2DecodeUniform, iters) {
+  StreamVByteDecode(
+      iters, MakeUniformData, nimble::streamvbyte::detail::decodeAvx2);
+}
+#endif // __x86_64__
+
+BENCHMARK(StreamVByteDecodeSkewed, iters) {
+  StreamVByteDecode(iters, MakeSkewedData, nimble::streamvbyte::decode);
+}
+
+BENCHMARK(StreamVByteScalarDecodeSkewed, iters) {
+  StreamVByteDecode(iters, MakeSkewedData, StreamVByteDecodeScalar);
+}
+
 int main() {
   folly::runBenchmarks();
 }
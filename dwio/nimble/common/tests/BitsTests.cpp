@@ -16,8 +16,10 @@
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 #include "dwio/nimble/common/Bits.h"
+#include "dwio/nimble/common/CpuFeatures.h"
 #include "folly/Random.h"
 
+using namespace facebook;
 using namespace facebook::nimble::bits;
 
 template <typename T>
@@ -78,6 +80,42 @@ TEST(BitsTests, findSetBit) {
   });
 }
 
+TEST(BitsTests, findSetBitMatchesScan) {
+  std::vector<uint32_t (*)(const char*, uint32_t, uint32_t, uint32_t)> finds{
+      findSetBit, detail::findSetBitScalar};
+#ifdef __x86_64__
+  if (nimble::cpu::supports(
+          nimble::cpu::Feature::Bmi2 | nimble::cpu::Feature::Popcnt)) {
+    finds.push_back(detail::findSetBitBmi2);
+  }
+#endif // __x86_64__
+  repeat(10, [&](auto& rng) {
+    auto size = folly::Random::rand32(1024, rng) + 1;
+    // Size the bitmap exactly, to catch reads past the last byte.
+    std::vector<char> bitmap(bytesRequired(size), 0);
+    for (auto i = 0; i < size; ++i) {
+      if (folly::Random::oneIn(4, rng)) {
+        setBit(i, bitmap.data());
+      }
+    }
+    auto begin = folly::Random::rand32(size, rng);
+    auto end = folly::Random::rand32(begin, size, rng) + 1;
+    std::vector<uint32_t> positions;
+    for (auto i = begin; i < end; ++i) {
+      if (getBit(i, bitmap.data())) {
+        positions.push_back(i);
+      }
+    }
+    for (auto find : finds) {
+      EXPECT_EQ(end, find(bitmap.data(), begin, end, 0));
+      for (auto n = 1; n <= positions.size(); ++n) {
+        EXPECT_EQ(positions[n - 1], find(bitmap.data(), begin, end, n)) << n;
+      }
+      EXPECT_EQ(end, find(bitmap.data(), begin, end, positions.size() + 1));
+    }
+  });
+}
+
 TEST(BitsTests, copy) {
   repeat(1, [](auto& rng) {
     auto size = folly::Random::rand32(64 * 1024, rng) + 1;
@@ -101,3 +139,124 @@ TEST(BitsTests, copy) {
     }
   });
 }
+
+namespace {
+
+using PackBitmap = void (*)(std::span<const bool>, char*);
+using CountSetBits = uint32_t (*)(uint32_t, uint32_t, const char*);
+using FindIndices = uint32_t (*)(uint32_t, uint32_t, const char*, uint32_t*);
+
+void verifyPackBitmap(PackBitmap pack) {
+  repeat(10, [&](auto& rng) {
+    auto size = folly::Random::rand32(1024, rng);
+    // Booleans are stored as 0 or 1 bytes, like std::vector<bool> can't.
+    std::unique_ptr<bool[]> bools{new bool[size]};
+    for (auto i = 0; i < size; ++i) {
+      bools[i] = folly::Random::oneIn(3, rng);
+    }
+    // Bits already set are preserved.
+    std::vector<char> bitmap(bucketsRequired(size, 64) * 8, 0);
+    if (size > 0) {
+      setBit(size - 1, bitmap.data());
+    }
+    pack({bools.get(), size}, bitmap.data());
+    for (auto i = 0; i < size; ++i) {
+      EXPECT_EQ(bools[i] || i == size - 1, getBit(i, bitmap.data())) << i;
+    }
+  });
+}
+
+void verifyCountSetBits(CountSetBits count) {
+  repeat(10, [&](auto& rng) {
+    auto size = folly::Random::rand32(64 * 1024, rng) + 1;
+    std::vector<char> bitmap(bucketsRequired(size, 64) * 8, 0);
+    for (auto i = 0; i < size; ++i) {
+      maybeSetBit(i, bitmap.data(), folly::Random::oneIn(2, rng));
+    }
+    auto begin = folly::Random::rand32(size, rng);
+    auto end = folly::Random::rand32(begin, size, rng);
+    uint32_t expected = 0;
+    for (auto i = begin; i < end; ++i) {
+      expected += getBit(i, bitmap.data());
+    }
+    EXPECT_EQ(expected, count(begin, end - begin, bitmap.data()));
+  });
+}
+
+void verifyFindIndices(FindIndices find, bool nulls) {
+  repeat(10, [&](auto& rng) {
+    auto size = folly::Random::rand32(64 * 1024, rng) + 1;
+    std::vector<char> bitmap(bucketsRequired(size, 64) * 8, 0);
+    // Mix sparse, dense and random regions.
+    for (auto i = 0; i < size; ++i) {
+      const auto region = (i / 256) % 3;
+      maybeSetBit(
+          i,
+          bitmap.data(),
+          region == 0 ? folly::Random::oneIn(50, rng)
+                      : (region == 1 ? !folly::Random::oneIn(50, rng)
+                                     : folly::Random::oneIn(2, rng)));
+    }
+    auto begin = folly::Random::rand32(size, rng);
+    auto end = folly::Random::rand32(begin, size, rng);
+    std::vector<uint32_t> expected;
+    for (auto i = begin; i < end; ++i) {
+      if (getBit(i, bitmap.data()) != nulls) {
+        expected.push_back(i - begin);
+      }
+    }
+    // Sized exactly, so ASAN catches stores past the row count.
+    std::vector<uint32_t> indices(end - begin);
+    const auto count = find(begin, end - begin, bitmap.data(), indices.data());
+    indices.resize(count);
+    EXPECT_EQ(expected, indices);
+  });
+}
+
+} // namespace
+
+TEST(BitsTests, packBitmap) {
+  verifyPackBitmap(packBitmap);
+  verifyPackBitmap(detail::packBitmapScalar);
+#ifdef __x86_64__
+  if (nimble::cpu::supports(nimble::cpu::Feature::Avx2)) {
+    verifyPackBitmap(detail::packBitmapAvx2);
+  }
+  if (nimble::cpu::supports(nimble::cpu::Feature::Avx512)) {
+    verifyPackBitmap(detail::packBitmapAvx512);
+  }
+#endif // __x86_64__
+}
+
+TEST(BitsTests, countSetBits) {
+  verifyCountSetBits(countSetBits);
+  verifyCountSetBits(detail::countSetBitsScalar);
+#ifdef __x86_64__
+  if (nimble::cpu::supports(nimble::cpu::Feature::Popcnt)) {
+    verifyCountSetBits(detail::countSetBitsPopcnt);
+  }
+  if (nimble::cpu::supports(
+          nimble::cpu::Feature::Avx2 | nimble::cpu::Feature::Popcnt)) {
+    verifyCountSetBits(detail::countSetBitsAvx2);
+  }
+#endif // __x86_64__
+}
+
+TEST(BitsTests, findIndices) {
+  verifyFindIndices(findNonNullIndices, false);
+  verifyFindIndices(findNullIndices, true);
+  verifyFindIndices(detail::findNonNullIndicesScalar, false);
+  verifyFindIndices(detail::findNullIndicesScalar, true);
+#ifdef __x86_64__
+  if (nimble::cpu::supports(
+          nimble::cpu::Feature::Avx2 | nimble::cpu::Feature::Popcnt)) {
+    verifyFindIndices(detail::findNonNullIndicesAvx2, false);
+    verifyFindIndices(detail::findNullIndicesAvx2, true);
+  }
+  if (nimble::cpu::supports(
+          nimble::cpu::Feature::Avx512 | nimble::cpu::Feature::Popcnt)) {
+    verifyFindIndices(detail::findNonNullIndicesAvx512, false);
+    verifyFindIndices(detail::findNullIndicesAvx512, true);
+  }
+#endif // __x86_64__
+}
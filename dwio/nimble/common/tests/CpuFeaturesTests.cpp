@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "dwio/nimble/common/CpuFeatures.h"
+
+using namespace facebook;
+
+namespace {
+
+const nimble::cpu::KernelInfo* findKernel(
+    const std::vector<nimble::cpu::KernelInfo>& kernels,
+    std::string_view name) {
+  auto it = std::find_if(kernels.begin(), kernels.end(), [&](const auto& k) {
+    return k.name == name;
+  });
+  return it == kernels.end() ? nullptr : &*it;
+}
+
+} // namespace
+
+TEST(CpuFeaturesTests, ToString) {
+  EXPECT_EQ("", nimble::cpu::toString(nimble::cpu::Feature::None));
+  EXPECT_EQ("bmi2", nimble::cpu::toString(nimble::cpu::Feature::Bmi2));
+  EXPECT_EQ(
+      "popcnt,avx2",
+      nimble::cpu::toString(
+          nimble::cpu::Feature::Avx2 | nimble::cpu::Feature::Popcnt));
+}
+
+TEST(CpuFeaturesTests, Supports) {
+  EXPECT_TRUE(nimble::cpu::supports(nimble::cpu::Feature::None));
+  const auto features = nimble::cpu::features();
+  EXPECT_TRUE(nimble::cpu::supports(features));
+  EXPECT_EQ(
+      nimble::cpu::supports(nimble::cpu::Feature::Avx2),
+      (features & nimble::cpu::Feature::Avx2) == nimble::cpu::Feature::Avx2);
+}
+
+TEST(CpuFeaturesTests, ActiveKernels) {
+  const auto kernels = nimble::cpu::activeKernels();
+  for (auto name :
+       {"bits::countSetBits",
+        "bits::findNonNullIndices",
+        "bits::findNullIndices",
+        "bits::findSetBit",
+        "bits::packBitmap",
+        "streamvbyte::decode",
+        "varint::bulkVarintDecode32",
+        "varint::bulkVarintDecode64"}) {
+    const auto* kernel = findKernel(kernels, name);
+    ASSERT_NE(nullptr, kernel) << name;
+    EXPECT_NE(
+        kernel->variants.end(),
+        std::find(
+            kernel->variants.begin(),
+            kernel->variants.end(),
+            kernel->variant))
+        << name;
+    // The portable fallback is always last.
+    EXPECT_EQ("scalar", kernel->variants.back()) << name;
+  }
+}
+
+TEST(CpuFeaturesTests, SelectsFirstSupportedVariant) {
+  using Fn = int (*)();
+  const nimble::cpu::Kernel<Fn> kernel{
+      "test::kernel",
+      {{"unsupported",
+        static_cast<nimble::cpu::Feature>(1U << 31),
+        []() { return 1; }},
+       {"scalar", nimble::cpu::Feature::None, []() { return 2; }}}};
+  EXPECT_EQ(2, kernel());
+
+  const auto kernels = nimble::cpu::activeKernels();
+  const auto* info = findKernel(kernels, "test::kernel");
+  ASSERT_NE(nullptr, info);
+  EXPECT_EQ("scalar", info->variant);
+  EXPECT_EQ(
+      (std::vector<std::string>{"unsupported", "scalar"}), info->variants);
+}
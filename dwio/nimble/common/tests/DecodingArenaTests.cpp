@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include "dwio/nimble/common/DecodingArena.h"
+#include "dwio/nimble/common/Vector.h"
+#include "velox/common/memory/Memory.h"
+
+using namespace ::facebook;
+
+class DecodingArenaTests : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    pool_ = facebook::velox::memory::deprecatedAddDefaultLeafMemoryPool();
+  }
+
+  std::shared_ptr<velox::memory::MemoryPool> pool_;
+};
+
+TEST_F(DecodingArenaTests, Allocate) {
+  nimble::DecodingArena arena{*pool_, 1024, 256};
+  auto* first = static_cast<char*>(arena.allocate(3, 1));
+  auto* second = static_cast<char*>(arena.allocate(8, 8));
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, second);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(second) % 8);
+  EXPECT_GE(second, first + 3);
+
+  // Larger than the max allocation size.
+  EXPECT_EQ(nullptr, arena.allocate(257, 8));
+
+  // Does not fit in the first chunk anymore.
+  for (int i = 0; i < 4; ++i) {
+    auto* data = static_cast<char*>(arena.allocate(256, 16));
+    ASSERT_NE(nullptr, data);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(data) % 16);
+    std::fill(data, data + 256, i);
+  }
+
+  auto stats = arena.stats();
+  EXPECT_EQ(6, stats.allocationCount);
+  EXPECT_EQ(3 + 8 + 4 * 256, stats.allocatedBytes);
+  EXPECT_EQ(2, stats.chunkCount);
+  EXPECT_EQ(2 * 1024, stats.chunkBytes);
+  EXPECT_EQ(1, stats.oversizedCount);
+}
+
+TEST_F(DecodingArenaTests, Scope) {
+  nimble::DecodingArena outer{*pool_};
+  nimble::DecodingArena inner{*pool_};
+  EXPECT_EQ(nullptr, nimble::DecodingArenaScope::getArena());
+  {
+    nimble::DecodingArenaScope outerScope{&outer};
+    EXPECT_EQ(&outer, nimble::DecodingArenaScope::getArena());
+    {
+      nimble::DecodingArenaScope innerScope{&inner};
+      EXPECT_EQ(&inner, nimble::DecodingArenaScope::getArena());
+      {
+        nimble::DecodingArenaScope disabledScope{nullptr};
+        EXPECT_EQ(nullptr, nimble::DecodingArenaScope::getArena());
+      }
+      EXPECT_EQ(&inner, nimble::DecodingArenaScope::getArena());
+    }
+    EXPECT_EQ(&outer, nimble::DecodingArenaScope::getArena());
+  }
+  EXPECT_EQ(nullptr, nimble::DecodingArenaScope::getArena());
+}
+
+TEST_F(DecodingArenaTests, Vector) {
+  nimble::DecodingArena arena{*pool_};
+  std::optional<nimble::Vector<int32_t>> vector;
+  {
+    nimble::DecodingArenaScope scope{&arena};
+    vector.emplace(pool_.get(), size_t{16}, 7);
+  }
+  EXPECT_EQ(1, arena.stats().allocationCount);
+
+  // Regrowth is allocated from the memory pool, so the arena doesn't
+  // accumulate dead buffers.
+  for (int32_t i = 0; i < 100; ++i) {
+    vector->push_back(i);
+  }
+  EXPECT_EQ(1, arena.stats().allocationCount);
+  ASSERT_EQ(116, vector->size());
+  for (int32_t i = 0; i < 16; ++i) {
+    EXPECT_EQ(7, (*vector)[i]);
+  }
+  for (int32_t i = 0; i < 100; ++i) {
+    EXPECT_EQ(i, (*vector)[16 + i]);
+  }
+
+  auto allocationCount = arena.stats().allocationCount;
+  auto copy = *vector;
+  auto moved = std::move(*vector);
+  EXPECT_EQ(allocationCount, arena.stats().allocationCount);
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), moved.begin()));
+
+  // Released buffers are pool backed, so they can outlive the arena.
+  auto buffer = moved.releaseOwnership();
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), buffer->as<int32_t>()));
+
+  // Empty Vectors take their first buffer from the arena, even outside of the
+  // scope. Cleared Vectors are detached from the arena.
+  std::optional<nimble::Vector<int32_t>> empty;
+  {
+    nimble::DecodingArenaScope scope{&arena};
+    empty.emplace(pool_.get());
+  }
+  empty->resize(8);
+  EXPECT_EQ(2, arena.stats().allocationCount);
+  empty->clear();
+  empty->resize(8);
+  EXPECT_EQ(2, arena.stats().allocationCount);
+
+  // Too large for the arena.
+  {
+    nimble::DecodingArenaScope scope{&arena};
+    nimble::Vector<char> large{
+        pool_.get(), nimble::DecodingArena::kDefaultMaxAllocationSize + 1};
+  }
+  EXPECT_EQ(1, arena.stats().oversizedCount);
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+#include "dwio/nimble/common/Entropy.h"
+
+using namespace ::facebook;
+
+TEST(EntropyTests, CompressionRatioEmpty) {
+  EXPECT_EQ(1.0, nimble::entropy::estimateCompressionRatio({}));
+}
+
+TEST(EntropyTests, CompressionRatioRandom) {
+  std::mt19937 rng(42);
+  std::string data(1 << 20, '\0');
+  for (auto& c : data) {
+    c = static_cast<char>(rng());
+  }
+  EXPECT_GT(nimble::entropy::estimateCompressionRatio(data), 0.95);
+}
+
+TEST(EntropyTests, CompressionRatioConstant) {
+  std::string data(1 << 20, 'a');
+  EXPECT_LT(nimble::entropy::estimateCompressionRatio(data), 0.01);
+}
+
+TEST(EntropyTests, CompressionRatioRepeatedText) {
+  std::string data;
+  while (data.size() < (1 << 16)) {
+    data.append("the quick brown fox jumps over the lazy dog. ");
+  }
+  EXPECT_LT(nimble::entropy::estimateCompressionRatio(data), 0.2);
+}
+
+TEST(EntropyTests, CompressionRatioSmallRange) {
+  // Small integers stored in wide types compress well, mostly due to the
+  // zero bytes.
+  std::mt19937 rng(42);
+  std::vector<uint64_t> values(1 << 16);
+  for (auto& value : values) {
+    value = rng() % 16;
+  }
+  const auto ratio = nimble::entropy::estimateCompressionRatio(
+      {reinterpret_cast<const char*>(values.data()),
+       values.size() * sizeof(uint64_t)});
+  EXPECT_LT(ratio, 0.5);
+}
+
+TEST(EntropyTests, CompressionRatioSmallInput) {
+  // Inputs smaller than a single probe block are fully inspected.
+  EXPECT_LT(nimble::entropy::estimateCompressionRatio("aaaaaaaaaaaa"), 0.01);
+  EXPECT_GT(nimble::entropy::estimateCompressionRatio("abcdefgh"), 0.3);
+}
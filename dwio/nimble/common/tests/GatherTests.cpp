@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+#include "dwio/nimble/common/CpuFeatures.h"
+#include "dwio/nimble/common/Gather.h"
+#include "folly/Random.h"
+
+using namespace ::facebook;
+
+namespace {
+
+template <typename T>
+using Gather = void (*)(const T*, uint32_t, const uint32_t*, uint64_t, T*);
+
+template <typename T>
+void verifyGather(Gather<T> gather) {
+  auto seed = folly::Random::rand32();
+  LOG(INFO) << "seed: " << seed;
+  std::mt19937 rng(seed);
+
+  // Covers alphabets fitting in a register (permutes) and larger ones
+  // (gathers), with counts not multiple of any vector width.
+  for (uint32_t alphabetSize : {1, 2, 4, 5, 8, 9, 16, 17, 1000}) {
+    std::vector<T> alphabet(alphabetSize);
+    for (auto& value : alphabet) {
+      value = (static_cast<T>(folly::Random::rand64(rng)) << 1) | 1;
+    }
+    for (uint64_t count : {0, 1, 3, 7, 8, 15, 16, 17, 33, 1000}) {
+      std::vector<uint32_t> indices(count);
+      for (auto& index : indices) {
+        index = folly::Random::rand32(alphabetSize, rng);
+      }
+
+      std::vector<T> output(count);
+      gather(
+          alphabet.data(),
+          alphabetSize,
+          indices.data(),
+          count,
+          output.data());
+      for (uint64_t i = 0; i < count; ++i) {
+        ASSERT_EQ(alphabet[indices[i]], output[i]) << "i: " << i;
+      }
+
+      // Indices stored in the tail of the output buffer are gathered in
+      // place.
+      std::vector<T> inPlace(count);
+      auto* aliased = reinterpret_cast<uint32_t*>(
+          reinterpret_cast<char*>(inPlace.data()) +
+          count * (sizeof(T) - sizeof(uint32_t)));
+      if (count > 0) {
+        std::memcpy(aliased, indices.data(), count * sizeof(uint32_t));
+      }
+      gather(alphabet.data(), alphabetSize, aliased, count, inPlace.data());
+      ASSERT_EQ(output, inPlace);
+    }
+  }
+}
+
+} // namespace
+
+TEST(GatherTests, Gather32) {
+  verifyGather<uint32_t>(nimble::gather::gather32);
+  verifyGather<uint32_t>(nimble::gather::detail::gather32Scalar);
+}
+
+TEST(GatherTests, Gather64) {
+  verifyGather<uint64_t>(nimble::gather::gather64);
+  verifyGather<uint64_t>(nimble::gather::detail::gather64Scalar);
+}
+
+#ifdef __x86_64__
+TEST(GatherTests, GatherAvx2) {
+  if (!nimble::cpu::supports(nimble::cpu::Feature::Avx2)) {
+    GTEST_SKIP() << "AVX2 is not supported.";
+  }
+  verifyGather<uint32_t>(nimble::gather::detail::gather32Avx2);
+  verifyGather<uint64_t>(nimble::gather::detail::gather64Avx2);
+}
+
+TEST(GatherTests, GatherAvx512) {
+  if (!nimble::cpu::supports(nimble::cpu::Feature::Avx512)) {
+    GTEST_SKIP() << "AVX-512 is not supported.";
+  }
+  verifyGather<uint32_t>(nimble::gather::detail::gather32Avx512);
+  verifyGather<uint64_t>(nimble::gather::detail::gather64Avx512);
+}
+#endif // __x86_64__
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+
+#include "dwio/nimble/common/StreamVByte.h"
+#include "folly/CpuId.h"
+#include "folly/Random.h"
+
+using namespace ::facebook;
+
+namespace {
+
+struct Encoded {
+  std::vector<uint8_t> control;
+  std::vector<char> data;
+};
+
+Encoded encode(const std::vector<uint32_t>& values, uint32_t baseline) {
+  Encoded encoded;
+  encoded.control.resize(nimble::streamvbyte::controlSize(values.size()));
+  // Data is sized exactly, so ASAN catches SIMD loads past the data end.
+  encoded.data.resize(nimble::streamvbyte::dataSize(values, baseline));
+  auto end = nimble::streamvbyte::encode(
+      values, baseline, encoded.control.data(), encoded.data.data());
+  EXPECT_EQ(encoded.data.data() + encoded.data.size(), end);
+  return encoded;
+}
+
+std::vector<uint32_t> generate(std::mt19937& rng, uint32_t count) {
+  std::vector<uint32_t> values(count);
+  // Uniform bit length, so all value lengths (and control bytes) show up.
+  for (auto& value : values) {
+    value = folly::Random::rand32(rng) >> (folly::Random::rand32(rng) % 32);
+  }
+  return values;
+}
+
+template <typename Decoder>
+void verifyDecoder(Decoder decoder) {
+  auto seed = folly::Random::rand32();
+  LOG(INFO) << "seed: " << seed;
+  std::mt19937 rng(seed);
+
+  for (auto count : {0, 1, 3, 4, 5, 7, 8, 9, 31, 32, 33, 1000, 10000}) {
+    const auto values = generate(rng, count);
+    const uint32_t baseline =
+        values.empty() ? 0 : *std::min_element(values.begin(), values.end());
+    const auto encoded = encode(values, baseline);
+    const char* dataEnd = encoded.data.data() + encoded.data.size();
+
+    std::vector<uint32_t> output(count);
+    auto pos = decoder(
+        count,
+        encoded.control.data(),
+        encoded.data.data(),
+        dataEnd,
+        output.data());
+    ASSERT_EQ(dataEnd, pos);
+    for (auto i = 0; i < count; ++i) {
+      ASSERT_EQ(values[i], output[i] + baseline) << "i: " << i;
+    }
+  }
+}
+
+} // namespace
+
+TEST(StreamVByteTests, ValueLengths) {
+  const std::vector<uint32_t> values{
+      0, 0xFF, 0x100, 0xFFFF, 0x10000, 0xFFFFFF, 0x1000000, 0xFFFFFFFF};
+  const auto encoded = encode(values, 0);
+  ASSERT_EQ(2, encoded.control.size());
+  ASSERT_EQ(1 + 1 + 2 + 2 + 3 + 3 + 4 + 4, encoded.data.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(
+        i / 2 + 1,
+        nimble::streamvbyte::valueLength(encoded.control[i / 4], i % 4));
+  }
+}
+
+TEST(StreamVByteTests, Decode) {
+  verifyDecoder(nimble::streamvbyte::decode);
+}
+
+TEST(StreamVByteTests, DecodeScalar) {
+  verifyDecoder([](uint64_t n,
+                   const uint8_t* control,
+                   const char* data,
+                   const char* /* dataEnd */,
+                   uint32_t* output) {
+    return nimble::streamvbyte::detail::decodeScalar(n, control, data, output);
+  });
+}
+
+#ifdef __x86_64__
+TEST(StreamVByteTests, DecodeSsse3) {
+  if (!folly::CpuId().ssse3()) {
+    GTEST_SKIP() << "SSSE3 is not supported.";
+  }
+  verifyDecoder(nimble::streamvbyte::detail::decodeSsse3);
+}
+
+TEST(StreamVByteTests, DecodeAvx2) {
+  if (!folly::CpuId().avx2()) {
+    GTEST_SKIP() << "AVX2 is not supported.";
+  }
+  verifyDecoder(nimble::streamvbyte::detail::decodeAvx2);
+}
+#endif // __x86_64__
+
+TEST(StreamVByteTests, Skip) {
+  auto seed = folly::Random::rand32();
+  LOG(INFO) << "seed: " << seed;
+  std::mt19937 rng(seed);
+
+  const auto values = generate(rng, 1001);
+  const auto encoded = encode(values, 0);
+  const char* dataEnd = encoded.data.data() + encoded.data.size();
+  for (auto skip : {0, 4, 8, 400, 1000}) {
+    auto pos = nimble::streamvbyte::skip(
+        skip, encoded.control.data(), encoded.data.data());
+    std::vector<uint32_t> output(values.size() - skip);
+    ASSERT_EQ(
+        dataEnd,
+        nimble::streamvbyte::decode(
+            output.size(),
+            encoded.control.data() + skip / 4,
+            pos,
+            dataEnd,
+            output.data()));
+    for (size_t i = 0; i < output.size(); ++i) {
+      ASSERT_EQ(values[skip + i], output[i]) << "i: " << i;
+    }
+  }
+  ASSERT_EQ(
+      dataEnd,
+      nimble::streamvbyte::skip(
+          values.size(), encoded.control.data(), encoded.data.data()));
+}
@@ -16,6 +16,7 @@
 #include "dwio/nimble/encodings/Compression.h"
 #include "dwio/nimble/common/EncodingPrimitives.h"
 #include "dwio/nimble/common/Exceptions.h"
+#include "dwio/nimble/encodings/Lz4Compressor.h"
 #include "dwio/nimble/encodings/ZstdCompressor.h"
 
 #ifndef DISABLE_META_INTERNAL_COMPRESSOR
@@ -28,9 +29,11 @@ namespace {
 
 struct CompressorRegistry {
   CompressorRegistry() {
-    compressors.reserve(2);
+    compressors.reserve(3);
     compressors.emplace(
         CompressionType::Zstd, std::make_unique<ZstdCompressor>());
+    compressors.emplace(
+        CompressionType::Lz4, std::make_unique<Lz4Compressor>());
 #ifndef DISABLE_META_INTERNAL_COMPRESSOR
     compressors.emplace(
         CompressionType::MetaInternal,
@@ -41,8 +44,13 @@ struct CompressorRegistry {
   std::unordered_map<CompressionType, std::unique_ptr<ICompressor>> compressors;
 };
 
-ICompressor& getCompressor(CompressionType compressionType) {
+CompressorRegistry& getRegistry() {
   static CompressorRegistry registry;
+  return registry;
+}
+
+ICompressor& getCompressor(CompressionType compressionType) {
+  auto& registry = getRegistry();
   auto it = registry.compressors.find(compressionType);
   NIMBLE_CHECK(
       it != registry.compressors.end(),
@@ -59,6 +67,12 @@ ICompressor& getCompressor(CompressionType compressionType) {
     DataType dataType,
     int bitWidth,
     const CompressionPolicy& compressionPolicy) {
+  if (!compressionPolicy.shouldAttempt(data)) {
+    return {
+        .compressionType = CompressionType::Uncompressed,
+        .buffer = std::nullopt,
+    };
+  }
   auto compression = compressionPolicy.compression();
 
   return getCompressor(compression.compressionType)
@@ -73,4 +87,18 @@ ICompressor& getCompressor(CompressionType compressionType) {
       .uncompress(memoryPool, compressionType, data);
 }
 
+/* static */ void Compression::uncompress(
+    CompressionType compressionType,
+    std::string_view data,
+    Vector<char>& output) {
+  getCompressor(compressionType).uncompress(compressionType, data, output);
+}
+
+/* static */ void Compression::registerCompressor(
+    std::unique_ptr<ICompressor>&& compressor) {
+  NIMBLE_CHECK(compressor != nullptr, "Compressor cannot be null.");
+  const auto compressionType = compressor->compressionType();
+  getRegistry().compressors[compressionType] = std::move(compressor);
+}
+
 } // namespace facebook::nimble
@@ -41,6 +41,17 @@ struct ICompressor {
       CompressionType compressionType,
       std::string_view data) = 0;
 
+  // Uncompresses |data| into |output|, reusing its existing allocation when it
+  // is large enough. |output| is resized to the uncompressed size.
+  // Compressors which store the uncompressed size up front should override
+  // this, to avoid allocating a new buffer for every call.
+  virtual void uncompress(
+      CompressionType compressionType,
+      std::string_view data,
+      Vector<char>& output) {
+    output = uncompress(*output.memoryPool(), compressionType, data);
+  }
+
   virtual CompressionType compressionType() = 0;
 
   virtual ~ICompressor() = default;
@@ -60,6 +71,15 @@ class Compression {
       CompressionType compressionType,
       std::string_view data);
 
+  // Same as above, but uncompresses into the (reusable) |output| buffer.
+  static void uncompress(
+      CompressionType compressionType,
+      std::string_view data,
+      Vector<char>& output);
+
+  // Registers (or replaces) the compressor handling
+  // compressor->compressionType(). Not thread safe: compressors should be
+  // registered before any data is compressed or uncompressed.
   static void registerCompressor(std::unique_ptr<ICompressor>&& compressor);
 };
 
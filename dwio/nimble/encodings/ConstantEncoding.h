@@ -43,6 +43,7 @@ class ConstantEncoding final
       std::string_view data);
 
   void reset() final;
+  bool reinitialize(std::string_view data) final;
   void skip(uint32_t rowCount) final;
   void materialize(uint32_t rowCount, void* buffer) final;
 
@@ -60,6 +61,8 @@ class ConstantEncoding final
   std::string debugString(int offset) const final;
 
  private:
+  void initialize(std::string_view data);
+
   physicalType value_;
 };
 
@@ -72,6 +75,11 @@ ConstantEncoding<T>::ConstantEncoding(
     velox::memory::MemoryPool& memoryPool,
     std::string_view data)
     : TypedEncoding<T, physicalType>(memoryPool, data) {
+  initialize(data);
+}
+
+template <typename T>
+void ConstantEncoding<T>::initialize(std::string_view data) {
   const char* pos = data.data() + Encoding::kPrefixSize;
   value_ = encoding::read<physicalType>(pos);
   NIMBLE_CHECK(pos == data.end(), "Unexpected constant encoding end");
@@ -80,6 +88,13 @@ ConstantEncoding<T>::ConstantEncoding(
 template <typename T>
 void ConstantEncoding<T>::reset() {}
 
+template <typename T>
+bool ConstantEncoding<T>::reinitialize(std::string_view data) {
+  this->reinitializePrefix(data);
+  initialize(data);
+  return true;
+}
+
 template <typename T>
 void ConstantEncoding<T>::skip(uint32_t /* rowCount */) {}
 
@@ -124,7 +139,9 @@ std::string_view ConstantEncoding<T>::encode(
     NIMBLE_INCOMPATIBLE_ENCODING("ConstantEncoding cannot be empty.");
   }
 
-  if (selection.statistics().uniqueCounts().size() != 1) {
+  // A single run is equivalent to a single unique value, but doesn't require
+  // building the unique values map.
+  if (selection.statistics().consecutiveRepeatCount() != 1) {
     NIMBLE_INCOMPATIBLE_ENCODING("ConstantEncoding requires constant data.");
   }
 
@@ -19,12 +19,14 @@
 #include "dwio/nimble/common/Buffer.h"
 #include "dwio/nimble/common/EncodingPrimitives.h"
 #include "dwio/nimble/common/EncodingType.h"
+#include "dwio/nimble/common/Gather.h"
 #include "dwio/nimble/common/Types.h"
 #include "dwio/nimble/common/Vector.h"
 #include "dwio/nimble/encodings/Encoding.h"
 #include "dwio/nimble/encodings/EncodingFactory.h"
 #include "dwio/nimble/encodings/EncodingIdentifier.h"
 #include "dwio/nimble/encodings/EncodingSelection.h"
+#include "dwio/nimble/encodings/NestedEncoding.h"
 #include "dwio/nimble/encodings/TrivialEncoding.h"
 #include "folly/container/F14Map.h"
 #include "velox/common/memory/Memory.h"
@@ -54,6 +56,7 @@ class DictionaryEncoding
       std::string_view data);
 
   void reset() final;
+  bool reinitialize(std::string_view data) final;
   void skip(uint32_t rowCount) final;
   void materialize(uint32_t rowCount, void* buffer) final;
 
@@ -68,11 +71,13 @@ class DictionaryEncoding
   std::string debugString(int offset) const final;
 
  private:
+  void initialize(std::string_view data);
+
   // Stores pre-loaded alphabet
   Vector<T> alphabet_;
 
   // Indices are uint32_t.
-  std::unique_ptr<Encoding> indicesEncoding_;
+  NestedEncoding<uint32_t> indicesEncoding_;
   std::unique_ptr<Encoding> alphabetEncoding_;
   Vector<uint32_t> buffer_; // Temporary buffer.
 };
@@ -88,18 +93,25 @@ DictionaryEncoding<T>::DictionaryEncoding(
     : TypedEncoding<T, physicalType>(memoryPool, data),
       alphabet_{&memoryPool},
       buffer_(&memoryPool) {
+  initialize(data);
+}
+
+template <typename T>
+void DictionaryEncoding<T>::initialize(std::string_view data) {
   auto pos = data.data() + kAlphabetSizeOffset;
   const uint32_t alphabetSize = encoding::readUint32(pos);
 
-  alphabetEncoding_ =
-      EncodingFactory::decode(this->memoryPool_, {pos, alphabetSize});
+  alphabetEncoding_ = EncodingFactory::decode(
+      this->memoryPool_, {pos, alphabetSize}, std::move(alphabetEncoding_));
   const uint32_t alphabetCount = alphabetEncoding_->rowCount();
   alphabet_.resize(alphabetCount);
   alphabetEncoding_->materialize(alphabetCount, alphabet_.data());
 
   pos += alphabetSize;
   indicesEncoding_ = EncodingFactory::decode(
-      this->memoryPool_, {pos, static_cast<size_t>(data.end() - pos)});
+      this->memoryPool_,
+      {pos, static_cast<size_t>(data.end() - pos)},
+      indicesEncoding_.release());
 }
 
 template <typename T>
@@ -107,20 +119,70 @@ void DictionaryEncoding<T>::reset() {
   indicesEncoding_->reset();
 }
 
+template <typename T>
+bool DictionaryEncoding<T>::reinitialize(std::string_view data) {
+  this->reinitializePrefix(data);
+  initialize(data);
+  return true;
+}
+
 template <typename T>
 void DictionaryEncoding<T>::skip(uint32_t rowCount) {
-  indicesEncoding_->skip(rowCount);
+  indicesEncoding_.skip(rowCount);
 }
 
 template <typename T>
 void DictionaryEncoding<T>::materialize(uint32_t rowCount, void* buffer) {
-  buffer_.resize(rowCount);
-  indicesEncoding_->materialize(rowCount, buffer_.data());
+  if constexpr (
+      isNumericType<physicalType>() &&
+      (sizeof(physicalType) == sizeof(uint32_t) ||
+       sizeof(physicalType) == sizeof(uint64_t))) {
+    // Trivially encoded indices are gathered in place. Otherwise, indices are
+    // materialized into the tail of the output buffer and then gathered in
+    // place (see Gather.h), so no temporary buffer is needed.
+    const uint32_t* indices;
+    if (indicesEncoding_.kind() == NestedEncodingKind::Trivial) {
+      indices =
+          indicesEncoding_.template as<TrivialEncoding<uint32_t>>().next(
+              rowCount);
+    } else {
+      auto* tail = reinterpret_cast<uint32_t*>(
+          static_cast<char*>(buffer) +
+          rowCount * (sizeof(physicalType) - sizeof(uint32_t)));
+      indicesEncoding_.materialize(rowCount, tail);
+      indices = tail;
+    }
+    if constexpr (sizeof(physicalType) == sizeof(uint32_t)) {
+      gather::gather32(
+          reinterpret_cast<const uint32_t*>(alphabet_.data()),
+          alphabet_.size(),
+          indices,
+          rowCount,
+          static_cast<uint32_t*>(buffer));
+    } else {
+      gather::gather64(
+          reinterpret_cast<const uint64_t*>(alphabet_.data()),
+          alphabet_.size(),
+          indices,
+          rowCount,
+          static_cast<uint64_t*>(buffer));
+    }
+  } else {
+    const uint32_t* indices;
+    if (indicesEncoding_.kind() == NestedEncodingKind::Trivial) {
+      indices =
+          indicesEncoding_.template as<TrivialEncoding<uint32_t>>().next(
+              rowCount);
+    } else {
+      buffer_.resize(rowCount);
+      indicesEncoding_.materialize(rowCount, buffer_.data());
+      indices = buffer_.data();
+    }
 
-  T* output = static_cast<T*>(buffer);
-  for (uint32_t index : buffer_) {
-    *output = alphabet_[index];
-    ++output;
+    T* output = static_cast<T*>(buffer);
+    for (uint32_t i = 0; i < rowCount; ++i) {
+      output[i] = alphabet_[indices[i]];
+    }
   }
 }
 
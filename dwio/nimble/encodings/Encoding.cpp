@@ -28,6 +28,16 @@ Encoding::Encoding(velox::memory::MemoryPool& memoryPool, std::string_view data)
       rowCount_{
           *reinterpret_cast<const uint32_t*>(data_.data() + kRowCountOffset)} {}
 
+void Encoding::reinitializePrefix(std::string_view data) {
+  NIMBLE_DASSERT(
+      static_cast<EncodingType>(data[kEncodingTypeOffset]) == encodingType_ &&
+          static_cast<DataType>(data[kDataTypeOffset]) == dataType_,
+      "Re-initializing encoding with a different type.");
+  data_ = data;
+  rowCount_ =
+      *reinterpret_cast<const uint32_t*>(data_.data() + kRowCountOffset);
+}
+
 /* static */ void Encoding::copyIOBuf(char* pos, const folly::IOBuf& buf) {
   [[maybe_unused]] size_t length = buf.computeChainDataLength();
   for (auto data : buf) {
@@ -20,6 +20,7 @@
 #include "dwio/nimble/common/Exceptions.h"
 #include "dwio/nimble/common/Types.h"
 #include "dwio/nimble/common/Vector.h"
+#include "folly/Function.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/ColumnVisitors.h"
 
@@ -117,6 +118,16 @@ class Encoding {
   // Resets the internal state (e.g. row pointer) to newly constructed form.
   virtual void reset() = 0;
 
+  // Re-initializes *this on |data|, an encoding with the same encodingType()
+  // and dataType(), leaving *this in newly constructed form. Nested encodings
+  // and internal buffers are reused, which is cheaper than constructing a new
+  // encoding when consecutive chunks share their layout. Returns false if the
+  // encoding doesn't support re-initialization, in which case *this is left
+  // untouched. See EncodingFactory::decode.
+  virtual bool reinitialize(std::string_view /* data */) {
+    return false;
+  }
+
   // Advances the row pointer N rows. Note that we don't provide a 'backwards'
   // iterator; if you need to move your row pointer back, reset() and skip().
   virtual void skip(uint32_t rowCount) = 0;
@@ -137,7 +148,10 @@ class Encoding {
   // Nullable method.
   // Like Materialize, but also sets the ith bit of bitmap to reflect whether
   // ith row was null or not. 0 means null, 1 means not null. Null rows are left
-  // untouched instead of being filled with default values.
+  // untouched instead of being filled with default values. |nulls| lazily
+  // returns the output bitmap, and is only called when a bitmap is needed. It
+  // is a non-owning reference, so callers can pass a lambda without allocating
+  // a std::function for every batch.
   //
   // If |scatterBitmap| is provided, |rowCount| still indicates how many items
   // to be read from the encoding. However, instead of placing them sequentially
@@ -157,7 +171,7 @@ class Encoding {
   virtual uint32_t materializeNullable(
       uint32_t rowCount,
       void* buffer,
-      std::function<void*()> nulls,
+      folly::FunctionRef<void*()> nulls,
       const bits::Bitmap* scatterBitmap = nullptr,
       uint32_t offset = 0) = 0;
 
@@ -226,11 +240,14 @@ class Encoding {
       uint32_t rowCount,
       char*& pos);
 
+  // Points the standard prefix members to |data|. Used by reinitialize().
+  void reinitializePrefix(std::string_view data);
+
   velox::memory::MemoryPool& memoryPool_;
-  const std::string_view data_;
+  std::string_view data_;
   const EncodingType encodingType_;
   const DataType dataType_;
-  const uint32_t rowCount_;
+  uint32_t rowCount_;
 };
 
 // The TypedEncoding<physicalType> class exposes the same interface as the base
@@ -253,7 +270,7 @@ class TypedEncoding : public Encoding {
   uint32_t materializeNullable(
       uint32_t rowCount,
       void* buffer,
-      std::function<void*()> nulls,
+      folly::FunctionRef<void*()> nulls,
       const bits::Bitmap* scatterBitmap,
       uint32_t offset) override {
     // 1. Read X items from the encoding.
@@ -337,6 +354,11 @@ class BufferedEncoding {
     encoding_->reset();
   }
 
+  // Releases the underlying encoding, e.g. to re-initialize it on new data.
+  std::unique_ptr<Encoding> releaseEncoding() {
+    return std::move(encoding_);
+  }
+
   uint32_t position() const noexcept {
     return encodingPosition_ - 1;
   }
@@ -22,6 +22,7 @@
 #include "dwio/nimble/encodings/NullableEncoding.h"
 #include "dwio/nimble/encodings/RleEncoding.h"
 #include "dwio/nimble/encodings/SparseBoolEncoding.h"
+#include "dwio/nimble/encodings/StreamVByteEncoding.h"
 #include "dwio/nimble/encodings/TrivialEncoding.h"
 #include "dwio/nimble/encodings/VarintEncoding.h"
 
@@ -122,6 +123,21 @@ std::unique_ptr<Encoding> EncodingFactory::decode(
           toString(dataType)));                                      \
   }
 
+#define RETURN_ENCODING_BY_STREAM_VBYTE_TYPE(Encoding, dataType)     \
+  switch (dataType) {                                                \
+    case DataType::Int32:                                            \
+      return std::make_unique<Encoding<int32_t>>(memoryPool, data);  \
+    case DataType::Uint32:                                           \
+      return std::make_unique<Encoding<uint32_t>>(memoryPool, data); \
+    case DataType::Float:                                            \
+      return std::make_unique<Encoding<float>>(memoryPool, data);    \
+    default:                                                         \
+      NIMBLE_UNREACHABLE(fmt::format(                                \
+          "Trying to deserialize a stream vbyte stream for "         \
+          "an incompatible data type {}.",                           \
+          toString(dataType)));                                      \
+  }
+
 #define RETURN_ENCODING_BY_NON_BOOL_TYPE(Encoding, dataType)                 \
   switch (dataType) {                                                        \
     case DataType::Int8:                                                     \
@@ -207,6 +223,9 @@ std::unique_ptr<Encoding> EncodingFactory::decode(
     case EncodingType::Varint: {
       RETURN_ENCODING_BY_VARINT_TYPE(VarintEncoding, dataType);
     }
+    case EncodingType::StreamVByte: {
+      RETURN_ENCODING_BY_STREAM_VBYTE_TYPE(StreamVByteEncoding, dataType);
+    }
     case EncodingType::Constant: {
       RETURN_ENCODING_BY_LEAF_TYPE(ConstantEncoding, dataType);
     }
@@ -220,6 +239,22 @@ std::unique_ptr<Encoding> EncodingFactory::decode(
   }
 }
 
+std::unique_ptr<Encoding> EncodingFactory::decode(
+    velox::memory::MemoryPool& memoryPool,
+    std::string_view data,
+    std::unique_ptr<Encoding> recycled) {
+  if (recycled != nullptr && reinitialize(*recycled, data)) {
+    return recycled;
+  }
+  return decode(memoryPool, data);
+}
+
+bool EncodingFactory::reinitialize(Encoding& encoding, std::string_view data) {
+  return encoding.encodingType() == static_cast<EncodingType>(data[0]) &&
+      encoding.dataType() == static_cast<DataType>(data[1]) &&
+      encoding.reinitialize(data);
+}
+
 template <typename T>
 std::string_view EncodingFactory::encode(
     std::unique_ptr<EncodingSelectionPolicy<T>>&& selectorPolicy,
@@ -302,6 +337,15 @@ std::string_view EncodingFactory::encode(
             "Varint encoding can only be selected for large numeric data types.");
       }
     }
+    case EncodingType::StreamVByte: {
+      if constexpr (
+          isNumericType<physicalType>() && sizeof(physicalType) == 4) {
+        return StreamVByteEncoding<T>::encode(selection, castedValues, buffer);
+      } else {
+        NIMBLE_INCOMPATIBLE_ENCODING(
+            "StreamVByte encoding can only be selected for 32 bit numeric data types.");
+      }
+    }
     case EncodingType::MainlyConstant: {
       if constexpr (std::is_same<T, bool>::value) {
         NIMBLE_INCOMPATIBLE_ENCODING(
@@ -35,6 +35,18 @@ class EncodingFactory {
       velox::memory::MemoryPool& memoryPool,
       std::string_view data);
 
+  // Same as above, but re-initializes |recycled| (a previously decoded
+  // encoding, possibly nullptr) on |data| instead, when their types match.
+  // Nested encodings are recycled the same way.
+  static std::unique_ptr<Encoding> decode(
+      velox::memory::MemoryPool& memoryPool,
+      std::string_view data,
+      std::unique_ptr<Encoding> recycled);
+
+  // Re-initializes |encoding| on |data|, if they have the same type and the
+  // encoding supports it. Returns whether |encoding| was re-initialized.
+  static bool reinitialize(Encoding& encoding, std::string_view data);
+
   template <typename T>
   static std::string_view encode(
       std::unique_ptr<EncodingSelectionPolicy<T>>&& selectorPolicy,
@@ -47,6 +47,7 @@ EncodingLayout EncodingLayoutCapture::capture(std::string_view encoding) {
   switch (encodingType) {
     case EncodingType::FixedBitWidth:
     case EncodingType::Varint:
+    case EncodingType::StreamVByte:
     case EncodingType::Constant: {
       // Non nested encodings have zero children
       break;
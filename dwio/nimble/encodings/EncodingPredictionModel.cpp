@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dwio/nimble/encodings/EncodingPredictionModel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include "dwio/nimble/common/Exceptions.h"
+#include "folly/Conv.h"
+#include "folly/String.h"
+
+namespace facebook::nimble {
+
+namespace {
+
+constexpr int32_t kMaxEncodingType =
+    static_cast<int32_t>(EncodingType::StreamVByte);
+constexpr uint32_t kTreeValueCount = DecisionTree::kInternalNodeCount * 2 +
+    DecisionTree::kLeafCount;
+
+EncodingType parseEncodingType(std::string_view value) {
+  for (auto i = 0; i <= kMaxEncodingType; ++i) {
+    const auto encodingType = static_cast<EncodingType>(i);
+    if (value == toString(encodingType)) {
+      return encodingType;
+    }
+  }
+  NIMBLE_NOT_SUPPORTED(fmt::format(
+      "Unknown encoding type '{}' in encoding prediction model.", value));
+}
+
+float parseFloat(const std::string& value, std::string_view entry) {
+  auto result = folly::tryTo<float>(folly::trimWhitespace(value));
+  NIMBLE_CHECK(
+      result.hasValue(),
+      fmt::format("Unable to parse value '{}' in '{}'.", value, entry));
+  return result.value();
+}
+
+// A tree always going left, with all the weight on the leftmost leaf.
+DecisionTree constantTree(float value) {
+  DecisionTree tree;
+  tree.features.fill(EncodingFeature::RunRatio);
+  tree.thresholds.fill(DecisionTree::kAlwaysLeft);
+  tree.leaves.fill(0.0f);
+  tree.leaves[0] = value;
+  return tree;
+}
+
+// Fits a regression tree to the gradients of the softmax loss, by greedily
+// picking the split with the largest squared error reduction in each node.
+// Leaves hold a Newton step (sum of gradients over sum of hessians).
+class TreeFitter {
+ public:
+  TreeFitter(
+      std::span<const EncodingTrainingSample> samples,
+      const std::vector<std::vector<float>>& thresholds,
+      const std::vector<float>& gradients,
+      const std::vector<float>& hessians,
+      const EncodingTrainingOptions& options)
+      : samples_{samples},
+        thresholds_{thresholds},
+        gradients_{gradients},
+        hessians_{hessians},
+        options_{options} {}
+
+  DecisionTree fit() {
+    DecisionTree tree;
+    std::vector<uint32_t> indices(samples_.size());
+    for (uint32_t i = 0; i < indices.size(); ++i) {
+      indices[i] = i;
+    }
+    fitNode(tree, /* node */ 0, /* depth */ 0, std::move(indices));
+    return tree;
+  }
+
+ private:
+  float feature(uint32_t index, uint32_t feature) const {
+    return samples_[index].features[feature];
+  }
+
+  void fitNode(
+      DecisionTree& tree,
+      uint32_t node,
+      uint32_t depth,
+      std::vector<uint32_t> indices) {
+    if (depth == DecisionTree::kDepth) {
+      double gradientSum = 0;
+      double hessianSum = 0;
+      for (auto index : indices) {
+        gradientSum += gradients_[index];
+        hessianSum += hessians_[index];
+      }
+      tree.leaves[node - DecisionTree::kInternalNodeCount] =
+          hessianSum > kMinHessianSum ? gradientSum / hessianSum : 0.0f;
+      return;
+    }
+
+    // When no split improves the fit, the node always goes left.
+    tree.features[node] = EncodingFeature::RunRatio;
+    tree.thresholds[node] = DecisionTree::kAlwaysLeft;
+    if (indices.size() >= options_.minSplitSampleCount) {
+      double gradientSum = 0;
+      for (auto index : indices) {
+        gradientSum += gradients_[index];
+      }
+      double bestScore = gradientSum * gradientSum / indices.size();
+      for (uint32_t f = 0; f < kEncodingFeatureCount; ++f) {
+        for (auto threshold : thresholds_[f]) {
+          double leftSum = 0;
+          uint32_t leftCount = 0;
+          for (auto index : indices) {
+            if (feature(index, f) <= threshold) {
+              leftSum += gradients_[index];
+              ++leftCount;
+            }
+          }
+          const uint32_t rightCount = indices.size() - leftCount;
+          if (leftCount == 0 || rightCount == 0) {
+            continue;
+          }
+          const double rightSum = gradientSum - leftSum;
+          const double score = leftSum * leftSum / leftCount +
+              rightSum * rightSum / rightCount;
+          if (score > bestScore + kMinScoreImprovement) {
+            bestScore = score;
+            tree.features[node] = static_cast<EncodingFeature>(f);
+            tree.thresholds[node] = threshold;
+          }
+        }
+      }
+    }
+
+    std::vector<uint32_t> left;
+    std::vector<uint32_t> right;
+    const auto f = static_cast<uint8_t>(tree.features[node]);
+    for (auto index : indices) {
+      (feature(index, f) > tree.thresholds[node] ? right : left)
+          .push_back(index);
+    }
+    fitNode(tree, 2 * node + 1, depth + 1, std::move(left));
+    fitNode(tree, 2 * node + 2, depth + 1, std::move(right));
+  }
+
+  static constexpr double kMinHessianSum = 1e-6;
+  static constexpr double kMinScoreImprovement = 1e-9;
+
+  std::span<const EncodingTrainingSample> samples_;
+  const std::vector<std::vector<float>>& thresholds_;
+  const std::vector<float>& gradients_;
+  const std::vector<float>& hessians_;
+  const EncodingTrainingOptions& options_;
+};
+
+// Returns candidate split thresholds for each feature: midpoints between
+// consecutive distinct values, thinned out to quantiles when there are too
+// many of them.
+std::vector<std::vector<float>> splitThresholds(
+    std::span<const EncodingTrainingSample> samples,
+    uint32_t maxThresholdCount) {
+  std::vector<std::vector<float>> thresholds(kEncodingFeatureCount);
+  for (uint32_t f = 0; f < kEncodingFeatureCount; ++f) {
+    std::vector<float> values;
+    values.reserve(samples.size());
+    for (const auto& sample : samples) {
+      values.push_back(sample.features[f]);
+    }
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    if (values.size() < 2) {
+      continue;
+    }
+    const auto candidateCount = values.size() - 1;
+    const auto count = std::min<size_t>(candidateCount, maxThresholdCount);
+    for (size_t i = 0; i < count; ++i) {
+      const auto j = i * candidateCount / count;
+      thresholds[f].push_back((values[j] + values[j + 1]) / 2);
+    }
+  }
+  return thresholds;
+}
+
+} // namespace
+
+std::string EncodingTrainingSample::serialize() const {
+  auto result = fmt::format("{}:", toString(encodingType));
+  for (auto i = 0; i < features.size(); ++i) {
+    if (i > 0) {
+      result += ',';
+    }
+    result += fmt::format("{}", features[i]);
+  }
+  return result;
+}
+
+/* static */ EncodingTrainingSample EncodingTrainingSample::parse(
+    std::string_view sample) {
+  std::vector<std::string> parts;
+  folly::split(':', folly::trimWhitespace(sample), parts);
+  std::vector<std::string> values;
+  if (parts.size() == 2) {
+    folly::split(',', parts[1], values);
+  }
+  NIMBLE_CHECK(
+      values.size() == kEncodingFeatureCount,
+      fmt::format(
+          "Invalid training sample format. Expected format is "
+          "<EncodingType>:<Feature0>,...,<Feature{}>. Unable to parse '{}'.",
+          kEncodingFeatureCount - 1,
+          sample));
+  EncodingTrainingSample result{
+      .encodingType =
+          parseEncodingType(folly::trimWhitespace(parts[0]).str())};
+  for (auto i = 0; i < values.size(); ++i) {
+    result.features[i] = parseFloat(values[i], sample);
+  }
+  return result;
+}
+
+std::string EncodingPredictionModel::serialize() const {
+  std::string result;
+  for (const auto& [encodingType, trees] : trees_) {
+    for (const auto& tree : trees) {
+      if (!result.empty()) {
+        result += ';';
+      }
+      result += fmt::format("{}=", toString(encodingType));
+      for (auto i = 0; i < tree.features.size(); ++i) {
+        if (i > 0) {
+          result += ',';
+        }
+        result += fmt::format("{}", static_cast<uint32_t>(tree.features[i]));
+      }
+      for (auto threshold : tree.thresholds) {
+        result += fmt::format(",{}", threshold);
+      }
+      for (auto leaf : tree.leaves) {
+        result += fmt::format(",{}", leaf);
+      }
+    }
+  }
+  return result;
+}
+
+/* static */ EncodingPredictionModel EncodingPredictionModel::parse(
+    std::string_view model) {
+  Trees trees;
+  std::vector<std::string> entries;
+  folly::split(';', folly::trimWhitespace(model), entries);
+  for (const auto& entry : entries) {
+    if (folly::trimWhitespace(entry).empty()) {
+      continue;
+    }
+    std::vector<std::string> kv;
+    folly::split('=', entry, kv);
+    std::vector<std::string> values;
+    if (kv.size() == 2) {
+      folly::split(',', kv[1], values);
+    }
+    NIMBLE_CHECK(
+        values.size() == kTreeValueCount,
+        fmt::format(
+            "Invalid encoding prediction model format. Expected format is "
+            "<EncodingType>=<Tree>, where a tree holds {} values. Unable to "
+            "parse '{}'.",
+            kTreeValueCount,
+            entry));
+
+    DecisionTree tree;
+    auto value = values.begin();
+    for (auto& feature : tree.features) {
+      auto index = folly::tryTo<uint8_t>(folly::trimWhitespace(*value++));
+      NIMBLE_CHECK(
+          index.hasValue() && index.value() < kEncodingFeatureCount,
+          fmt::format("Invalid split feature in '{}'.", entry));
+      feature = static_cast<EncodingFeature>(index.value());
+    }
+    for (auto& threshold : tree.thresholds) {
+      threshold = parseFloat(*value++, entry);
+    }
+    for (auto& leaf : tree.leaves) {
+      leaf = parseFloat(*value++, entry);
+    }
+
+    const auto encodingType =
+        parseEncodingType(folly::trimWhitespace(kv[0]).str());
+    // An encoding's score is the sum of its trees, so trees of the same
+    // encoding are merged, even when they are not listed consecutively.
+    auto it = std::find_if(trees.begin(), trees.end(), [&](const auto& entry) {
+      return entry.first == encodingType;
+    });
+    if (it == trees.end()) {
+      it = trees.emplace(
+          trees.end(), encodingType, std::vector<DecisionTree>{});
+    }
+    it->second.push_back(tree);
+  }
+  NIMBLE_CHECK(!trees.empty(), "Encoding prediction model has no trees.");
+  return EncodingPredictionModel{std::move(trees)};
+}
+
+/* static */ EncodingPredictionModel EncodingPredictionModel::train(
+    std::span<const EncodingTrainingSample> samples,
+    const EncodingTrainingOptions& options) {
+  NIMBLE_CHECK(!samples.empty(), "No encoding training samples.");
+
+  std::map<EncodingType, uint32_t> classCounts;
+  for (const auto& sample : samples) {
+    ++classCounts[sample.encodingType];
+  }
+  const uint32_t classCount = classCounts.size();
+  std::vector<uint32_t> labels;
+  labels.reserve(samples.size());
+  for (const auto& sample : samples) {
+    labels.push_back(std::distance(
+        classCounts.begin(), classCounts.find(sample.encodingType)));
+  }
+
+  Trees trees;
+  std::vector<float> scores(samples.size() * classCount);
+  for (const auto& [encodingType, count] : classCounts) {
+    const float prior = std::log(static_cast<float>(count) / samples.size());
+    const uint32_t k = trees.size();
+    for (uint32_t i = 0; i < samples.size(); ++i) {
+      scores[i * classCount + k] = prior;
+    }
+    trees.emplace_back(
+        encodingType, std::vector<DecisionTree>{constantTree(prior)});
+  }
+  if (classCount == 1) {
+    return EncodingPredictionModel{std::move(trees)};
+  }
+
+  const auto thresholds =
+      splitThresholds(samples, options.maxThresholdCount);
+  // Friedman's scaling of the Newton step, for multi-class boosting.
+  const float shrinkage =
+      options.learningRate * (classCount - 1) / classCount;
+  std::vector<float> probabilities(samples.size() * classCount);
+  std::vector<float> gradients(samples.size());
+  std::vector<float> hessians(samples.size());
+  for (uint32_t round = 0; round < options.roundCount; ++round) {
+    for (uint32_t i = 0; i < samples.size(); ++i) {
+      const auto* score = &scores[i * classCount];
+      auto* probability = &probabilities[i * classCount];
+      const float maxScore = *std::max_element(score, score + classCount);
+      float sum = 0;
+      for (uint32_t k = 0; k < classCount; ++k) {
+        probability[k] = std::exp(score[k] - maxScore);
+        sum += probability[k];
+      }
+      for (uint32_t k = 0; k < classCount; ++k) {
+        probability[k] /= sum;
+      }
+    }
+
+    for (uint32_t k = 0; k < classCount; ++k) {
+      for (uint32_t i = 0; i < samples.size(); ++i) {
+        const float probability = probabilities[i * classCount + k];
+        gradients[i] = (labels[i] == k ? 1.0f : 0.0f) - probability;
+        hessians[i] = probability * (1.0f - probability);
+      }
+      auto tree =
+          TreeFitter{samples, thresholds, gradients, hessians, options}.fit();
+      for (auto& leaf : tree.leaves) {
+        leaf *= shrinkage;
+      }
+      for (uint32_t i = 0; i < samples.size(); ++i) {
+        scores[i * classCount + k] += tree.evaluate(samples[i].features);
+      }
+      trees[k].second.push_back(tree);
+    }
+  }
+  return EncodingPredictionModel{std::move(trees)};
+}
+
+} // namespace facebook::nimble
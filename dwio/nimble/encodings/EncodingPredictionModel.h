@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "dwio/nimble/common/Bits.h"
+#include "dwio/nimble/common/Types.h"
+#include "dwio/nimble/encodings/Statistics.h"
+
+namespace facebook::nimble {
+
+// Features extracted from stream statistics, used by the learned encoding
+// selection model. All features are normalized to the [0, 1] range.
+enum class EncodingFeature : uint8_t {
+  // Number of runs, divided by the entry count.
+  RunRatio = 0,
+  // (Approximate) number of unique values, divided by the entry count.
+  UniqueRatio = 1,
+  // (Approximate) count of the most common value, divided by the entry count.
+  MostCommonRatio = 2,
+  // Bits required to represent the value range, divided by the type bit
+  // width. Always 1 for non-numeric types.
+  BitWidthRatio = 3,
+  // Average varint encoded size, divided by the type size. Capped at 1.
+  // Always 1 for non-integral types.
+  VarintRatio = 4,
+  // Bits required for dictionary indices, divided by the bits required for
+  // values (the value range for numeric types, or the average length for
+  // strings). Capped at 1. Always 1 for bool.
+  IndexWidthRatio = 5,
+};
+
+constexpr uint32_t kEncodingFeatureCount = 6;
+using EncodingFeatures = std::array<float, kEncodingFeatureCount>;
+
+template <typename T>
+EncodingFeatures extractEncodingFeatures(
+    uint64_t entryCount,
+    const Statistics<T>& statistics) {
+  EncodingFeatures features;
+  features.fill(1.0f);
+  auto set = [&features, entryCount](EncodingFeature feature, double value) {
+    features[static_cast<uint8_t>(feature)] = value / entryCount;
+  };
+
+  set(EncodingFeature::RunRatio, statistics.consecutiveRepeatCount());
+  if constexpr (isBoolType<T>()) {
+    const auto& uniqueCounts = statistics.uniqueCounts();
+    set(EncodingFeature::UniqueRatio, uniqueCounts.size());
+    uint64_t mostCommonCount = 0;
+    for (const auto& pair : uniqueCounts) {
+      mostCommonCount = std::max<uint64_t>(mostCommonCount, pair.second);
+    }
+    set(EncodingFeature::MostCommonRatio, mostCommonCount);
+  } else {
+    const auto& uniqueCounts = statistics.approximateUniqueCounts();
+    set(EncodingFeature::UniqueRatio, uniqueCounts.size());
+    set(EncodingFeature::MostCommonRatio, uniqueCounts.mostCommonCount());
+
+    const float indexBits = bits::bitsRequired(uniqueCounts.size() - 1);
+    float valueBits;
+    if constexpr (isNumericType<T>()) {
+      valueBits = bits::bitsRequired(statistics.max() - statistics.min());
+    } else {
+      valueBits = 8.0f * statistics.totalStringsLength() / entryCount;
+    }
+    features[static_cast<uint8_t>(EncodingFeature::IndexWidthRatio)] =
+        std::min(1.0f, indexBits / std::max(valueBits, 1.0f));
+  }
+
+  if constexpr (isNumericType<T>()) {
+    features[static_cast<uint8_t>(EncodingFeature::BitWidthRatio)] =
+        static_cast<float>(bits::bitsRequired(
+            statistics.max() - statistics.min())) /
+        (sizeof(T) * 8);
+  }
+  if constexpr (isIntegralType<T>()) {
+    // Each varint bucket holds 7 more bits than the previous bucket.
+    uint64_t varintSize = 0;
+    for (auto i = 0; i < statistics.bucketCounts().size(); ++i) {
+      varintSize += statistics.bucketCounts()[i] * (i + 1);
+    }
+    features[static_cast<uint8_t>(EncodingFeature::VarintRatio)] = std::min(
+        1.0, static_cast<double>(varintSize) / entryCount / sizeof(T));
+  }
+  return features;
+}
+
+// A complete binary decision tree, stored in flat arrays, with internal nodes
+// in breadth first order. This layout allows branchless evaluation.
+// Shallower trees are represented using splits with an infinite threshold
+// (which always go left).
+struct DecisionTree {
+  static constexpr uint32_t kDepth = 3;
+  static constexpr uint32_t kInternalNodeCount = (1 << kDepth) - 1;
+  static constexpr uint32_t kLeafCount = 1 << kDepth;
+  static constexpr float kAlwaysLeft = std::numeric_limits<float>::infinity();
+
+  std::array<EncodingFeature, kInternalNodeCount> features;
+  std::array<float, kInternalNodeCount> thresholds;
+  std::array<float, kLeafCount> leaves;
+
+  float evaluate(const EncodingFeatures& values) const {
+    uint32_t node = 0;
+    for (uint32_t depth = 0; depth < kDepth; ++depth) {
+      node = 2 * node + 1 +
+          (values[static_cast<uint8_t>(features[node])] > thresholds[node]);
+    }
+    return leaves[node - kInternalNodeCount];
+  }
+};
+
+// A training sample for the encoding prediction model: the features of a
+// stream, and the encoding selected for it (by the manual encoding selection
+// policy).
+struct EncodingTrainingSample {
+  EncodingType encodingType;
+  EncodingFeatures features;
+
+  // The serialized format is <EncodingType>:<Feature0>,...,<FeatureN>.
+  std::string serialize() const;
+  static EncodingTrainingSample parse(std::string_view sample);
+};
+
+struct EncodingTrainingOptions {
+  // Number of boosting rounds. Each round adds one tree to every encoding.
+  uint32_t roundCount = 16;
+  float learningRate = 0.5f;
+  // Nodes with fewer samples are not split.
+  uint32_t minSplitSampleCount = 8;
+  // Maximum number of split thresholds considered for each feature. The
+  // thresholds are taken from the quantiles of the feature values.
+  uint32_t maxThresholdCount = 32;
+};
+
+// Multi-class gradient boosted trees model, predicting the best encoding for
+// a stream, based on its features (without estimating the size of every
+// candidate encoding). The score of each encoding is the sum of its trees'
+// leaf values, and the encoding with the highest score wins.
+// Models are trained offline (see train()), on samples logged by the encoding
+// selection logger (dwio/nimble/tools/EncodingSelectionLogger), using the
+// encoding model trainer (dwio/nimble/tools/EncodingModelTrainer). Trained
+// models are loaded using parse().
+class EncodingPredictionModel {
+ public:
+  using Trees = std::vector<std::pair<EncodingType, std::vector<DecisionTree>>>;
+
+  explicit EncodingPredictionModel(Trees trees = defaultTrees())
+      : trees_{std::move(trees)} {}
+
+  // Returns the encoding with the highest score, out of the encodings allowed
+  // by |isCandidate|, or std::nullopt if no modeled encoding is allowed.
+  template <typename Predicate>
+  std::optional<EncodingType> predict(
+      const EncodingFeatures& features,
+      Predicate isCandidate) const {
+    std::optional<EncodingType> prediction;
+    float maxScore = std::numeric_limits<float>::lowest();
+    for (const auto& [encodingType, trees] : trees_) {
+      if (!isCandidate(encodingType)) {
+        continue;
+      }
+      float score = 0.0f;
+      for (const auto& tree : trees) {
+        score += tree.evaluate(features);
+      }
+      if (score > maxScore) {
+        maxScore = score;
+        prediction = encodingType;
+      }
+    }
+    return prediction;
+  }
+
+  const Trees& trees() const {
+    return trees_;
+  }
+
+  // The serialized format is a ';' separated list of <EncodingType>=<Tree>
+  // entries, where a tree is a ',' separated list of its split features (as
+  // numbers), split thresholds and leaf values. Trees of the same encoding
+  // are listed consecutively.
+  std::string serialize() const;
+  static EncodingPredictionModel parse(std::string_view model);
+
+  // Trains a model using multi-class gradient boosting (with a softmax loss).
+  // Each encoding starts with a constant tree holding its log prior, and
+  // every boosting round adds one tree to each encoding.
+  static EncodingPredictionModel train(
+      std::span<const EncodingTrainingSample> samples,
+      const EncodingTrainingOptions& options = {});
+
+  // Hand-fit trees reproducing the manual policy's main decisions. These are
+  // not trained, and are meant to be replaced by a model trained on the
+  // target workload.
+  static Trees defaultTrees() {
+    using F = EncodingFeature;
+    constexpr auto kLeft = DecisionTree::kAlwaysLeft;
+    // Most trees below only split on the first two levels, using always left
+    // splits on the bottom level.
+    return {
+        {EncodingType::Trivial,
+         {{.features = {F::RunRatio, F::RunRatio, F::RunRatio, F::RunRatio,
+                        F::RunRatio, F::RunRatio, F::RunRatio},
+           .thresholds = {kLeft, kLeft, kLeft, kLeft, kLeft, kLeft, kLeft},
+           .leaves = {0.5f, 0, 0, 0, 0, 0, 0, 0}}}},
+        {EncodingType::FixedBitWidth,
+         {{.features = {F::BitWidthRatio, F::BitWidthRatio, F::BitWidthRatio,
+                        F::RunRatio, F::RunRatio, F::RunRatio, F::RunRatio},
+           .thresholds = {0.5f, 0.25f, 0.75f, kLeft, kLeft, kLeft, kLeft},
+           .leaves = {0.9f, 0, 0.75f, 0, 0.6f, 0, 0.2f, 0}}}},
+        {EncodingType::Dictionary,
+         {{.features = {F::UniqueRatio, F::IndexWidthRatio, F::UniqueRatio,
+                        F::RunRatio, F::IndexWidthRatio, F::RunRatio,
+                        F::RunRatio},
+           .thresholds = {0.2f, 0.5f, kLeft, kLeft, 0.75f, kLeft, kLeft},
+           .leaves = {1.0f, 0, 0.55f, 0, 0, 0, 0, 0}}}},
+        {EncodingType::RLE,
+         {{.features = {F::RunRatio, F::RunRatio, F::RunRatio, F::RunRatio,
+                        F::RunRatio, F::RunRatio, F::RunRatio},
+           .thresholds = {0.05f, 0.01f, 0.2f, kLeft, kLeft, kLeft, kLeft},
+           .leaves = {1.3f, 0, 1.1f, 0, 0.7f, 0, 0, 0}}}},
+        {EncodingType::MainlyConstant,
+         {{.features = {F::MostCommonRatio, F::MostCommonRatio,
+                        F::MostCommonRatio, F::RunRatio, F::RunRatio,
+                        F::RunRatio, F::RunRatio},
+           .thresholds = {0.9f, 0.7f, 0.98f, kLeft, kLeft, kLeft, kLeft},
+           .leaves = {0, 0, 0.6f, 0, 1.15f, 0, 1.4f, 0}}}},
+        {EncodingType::SparseBool,
+         {{.features = {F::MostCommonRatio, F::MostCommonRatio,
+                        F::MostCommonRatio, F::RunRatio, F::RunRatio,
+                        F::RunRatio, F::RunRatio},
+           .thresholds = {0.95f, 0.9f, kLeft, kLeft, kLeft, kLeft, kLeft},
+           .leaves = {0, 0, 0.6f, 0, 1.0f, 0, 0, 0}}}},
+        {EncodingType::Varint,
+         {{.features = {F::VarintRatio, F::BitWidthRatio, F::VarintRatio,
+                        F::RunRatio, F::RunRatio, F::RunRatio, F::RunRatio},
+           .thresholds = {0.5f, 0.75f, kLeft, kLeft, kLeft, kLeft, kLeft},
+           .leaves = {0.3f, 0, 0.8f, 0, 0, 0, 0, 0}}}},
+    };
+  }
+
+ private:
+  Trees trees_;
+};
+
+} // namespace facebook::nimble
@@ -71,6 +71,11 @@ class EncodingSelectionPolicyBase;
 // discarded.
 struct ZstdCompressionParameters {
   int16_t compressionLevel = 3;
+  // When non-zero, payloads of at least |parallelMinSize| bytes are
+  // compressed using this many zstd worker threads. The output is a regular
+  // zstd frame, so decompression is not affected.
+  uint16_t workerCount = 0;
+  uint32_t parallelMinSize = 0;
 };
 
 struct MetaInternalCompressionParameters {
@@ -79,9 +84,15 @@ struct MetaInternalCompressionParameters {
   bool useVariableBitWidthCompressor = true;
 };
 
+struct Lz4CompressionParameters {
+  // Higher acceleration trades compression ratio for compression speed.
+  int32_t acceleration = 1;
+};
+
 union CompressionParameters {
   ZstdCompressionParameters zstd;
   MetaInternalCompressionParameters metaInternal;
+  Lz4CompressionParameters lz4;
 };
 
 struct CompressionInformation {
@@ -97,6 +108,12 @@ class CompressionPolicy {
       uint64_t /* uncompressedSize */,
       uint64_t /* compressedSize */) const = 0;
 
+  // Allows skipping compression attempts which are not likely to pay off,
+  // based on a cheap inspection of the data, before it is compressed.
+  virtual bool shouldAttempt(std::string_view /* data */) const {
+    return true;
+  }
+
   virtual ~CompressionPolicy() = default;
 };
 
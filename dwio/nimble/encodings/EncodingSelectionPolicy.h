@@ -17,12 +17,21 @@
 
 #include <glog/logging.h>
 #include <algorithm>
+#include <bit>
+#include <limits>
+#include <memory>
 #include <optional>
+#include <string>
+#include <tuple>
 #include "dwio/nimble/common/Bits.h"
 #include "dwio/nimble/common/EncodingType.h"
+#include "dwio/nimble/common/Entropy.h"
+#include "dwio/nimble/common/StreamVByte.h"
 #include "dwio/nimble/encodings/EncodingIdentifier.h"
 #include "dwio/nimble/encodings/EncodingLayout.h"
+#include "dwio/nimble/encodings/EncodingPredictionModel.h"
 #include "dwio/nimble/encodings/EncodingSelection.h"
+#include "dwio/nimble/encodings/ReadCostModel.h"
 
 namespace facebook::nimble {
 
@@ -105,6 +114,99 @@ struct CompressionOptions {
   uint32_t internalCompressionLevel = 4;
   uint32_t internalDecompressionLevel = 2;
   bool useVariableBitWidthCompressor = false;
+  // Compression is skipped when the compression ratio estimated by a fast
+  // entropy probe of the data is above this ratio (meaning compression is
+  // not likely to pay off). A ratio of 1 (or above, the default) always
+  // attempts compression. The estimate is approximate, so enabling the probe
+  // may leave some compressible chunks uncompressed.
+  float compressionSkipRatio = 1.0f;
+  // When non-zero, large payloads (of at least zstdParallelMinSize bytes) are
+  // compressed in parallel, using this many zstd worker threads. Useful when a
+  // few huge streams (e.g. strings) dominate the stripe flush latency.
+  uint32_t zstdWorkerCount = 0;
+  uint32_t zstdParallelMinSize = 16 << 20;
+  // Compression algorithm applied to data streams. When not set, MetaInternal
+  // is used (if available), otherwise, Zstd. Lz4 trades compression ratio for
+  // much faster decompression, which suits latency sensitive tables.
+  std::optional<CompressionType> compressionType;
+  int32_t lz4Acceleration = 1;
+};
+
+// Returns the compression algorithm parameters, based on the compression
+// options.
+inline CompressionInformation compressionInformation(
+    CompressionType compressionType,
+    const CompressionOptions& compressionOptions) {
+  CompressionInformation information{.compressionType = compressionType};
+  switch (compressionType) {
+    case CompressionType::Uncompressed:
+      break;
+    case CompressionType::Zstd:
+      information.parameters.zstd.compressionLevel =
+          compressionOptions.zstdCompressionLevel;
+      information.parameters.zstd.workerCount =
+          compressionOptions.zstdWorkerCount;
+      information.parameters.zstd.parallelMinSize =
+          compressionOptions.zstdParallelMinSize;
+      break;
+    case CompressionType::MetaInternal:
+      information.parameters.metaInternal.compressionLevel =
+          compressionOptions.internalCompressionLevel;
+      information.parameters.metaInternal.decompressionLevel =
+          compressionOptions.internalDecompressionLevel;
+      information.parameters.metaInternal.useVariableBitWidthCompressor =
+          compressionOptions.useVariableBitWidthCompressor;
+      break;
+    case CompressionType::Lz4:
+      information.parameters.lz4.acceleration =
+          compressionOptions.lz4Acceleration;
+      break;
+    default:
+      NIMBLE_UNREACHABLE(fmt::format(
+          "Unsupported compression type {}.", toString(compressionType)));
+  }
+  return information;
+}
+
+// Options controlling how the manual encoding selection policy inspects data.
+struct EncodingSelectionOptions {
+  // Streams with at least this many entries use approximate (sketch based)
+  // unique value statistics when estimating encoding sizes, instead of
+  // building an exact map of all unique values. Zero (the default) disables
+  // approximation.
+  uint64_t approximateStatisticsThreshold = 0;
+  // When using approximate statistics, if Dictionary or MainlyConstant
+  // encodings (or RLE, for strings), which are most sensitive to unique value
+  // statistics, have a cost within this ratio of the selected encoding's cost,
+  // selection is repeated using exact statistics.
+  float exactStatisticsCostRatio = 1.2f;
+  // Streams with at least this many entries select their encoding by
+  // inspecting a sample of the data, instead of the full stream. The selected
+  // encoding is then used to encode the full stream. Zero disables sampling.
+  uint64_t samplingThreshold = 0;
+  // The sample is made of evenly spaced slices, spread across the stream.
+  // Slices are contiguous, to preserve runs in the data.
+  uint32_t sampleSliceCount = 16;
+  uint32_t sampleSliceSize = 4096;
+  // When set, the best candidate encodings (by estimated size on the sample)
+  // are trial encoded (and compressed) on the sample, and the encoding with
+  // the smallest (read factor weighted) encoded size is selected. The pool is
+  // used for the scratch encoding buffers, and must outlive the policy.
+  velox::memory::MemoryPool* trialEncodingPool = nullptr;
+  uint32_t trialEncodingCandidates = 3;
+  // When provided, the measured decode cost of each encoding is added to its
+  // (read factor weighted) size, to balance file size against read CPU.
+  // The weight converts decode time to size, in bytes per nanosecond of
+  // decode time. Zero ignores the read cost model.
+  std::shared_ptr<const ReadCostModel> readCostModel;
+  float readCostWeight = 0.0f;
+  // When set, the estimated size of Trivial encoding (whose payload is the
+  // raw data) is scaled by the compression ratio estimated by a fast entropy
+  // probe of the data. When enabling this, the Trivial read factor no longer
+  // needs to be lowered to account for compression. Only Trivial is scaled:
+  // the estimates of other encodings (whose payloads are already packed)
+  // remain uncompressed sizes.
+  bool compressionAwareTrivialEstimate = false;
 };
 
 // This is the manual encoding selection implementation.
@@ -118,10 +220,12 @@ class ManualEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
   ManualEncodingSelectionPolicy(
       std::vector<std::pair<EncodingType, float>> readFactors,
       CompressionOptions compressionOptions,
-      std::optional<NestedEncodingIdentifier> identifier)
+      std::optional<NestedEncodingIdentifier> identifier,
+      EncodingSelectionOptions selectionOptions = {})
       : readFactors_{std::move(readFactors)},
         compressionOptions_{std::move(compressionOptions)},
-        identifier_{identifier} {}
+        identifier_{identifier},
+        selectionOptions_{std::move(selectionOptions)} {}
 
   std::unique_ptr<EncodingSelectionPolicyBase> createImpl(
       EncodingType encodingType,
@@ -150,7 +254,8 @@ class ManualEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
         COMMA FixedByteWidth,
         std::move(filteredReadFactors),
         compressionOptions_,
-        identifier);
+        identifier,
+        selectionOptions_);
   }
 
   EncodingSelectionResult select(
@@ -162,85 +267,42 @@ class ManualEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
       };
     }
 
-    float minCost = std::numeric_limits<float>::max();
-    EncodingType selectedEncoding = EncodingType::Trivial;
-    // Iterate on all candidate encodings, and pick the encoding with the
-    // minimal cost.
-    for (const auto& pair : readFactors_) {
-      auto encodingType = pair.first;
-      auto size = estimateSize(encodingType, values.size(), statistics);
-      if (!size.has_value()) {
-        NIMBLE_SELECTION_LOG(
-            PURPLE << encodingType << " encoding is incompatible.");
-        continue;
-      }
-
-      // We use read factor weights to raise/lower the favorability of each
-      // encoding.
-      auto readFactor = pair.second;
-      auto cost = size.value() * readFactor;
-      NIMBLE_SELECTION_LOG(
-          YELLOW << "Encoding: " << encodingType << ", Size: " << size.value()
-                 << ", Factor: " << readFactor << ", Cost: " << cost);
-      if (cost < minCost) {
-        minCost = cost;
-        selectedEncoding = encodingType;
+    if constexpr (!isBoolType<physicalType>()) {
+      if (shouldSample(values.size(), statistics)) {
+        return {
+            .encodingType = selectSampled(values),
+            .compressionPolicyFactory = compressionPolicyFactory()};
       }
     }
 
-    // Currently, we always attempt to compress leaf data streams. The logic
-    // behind this is that encoding selection optimizes the in-memory layout of
-    // data, while compression provides extra saving for persistent storage (and
-    // bandwidth).
-    class AlwaysCompressPolicy : public CompressionPolicy {
-     public:
-      explicit AlwaysCompressPolicy(CompressionOptions compressionOptions)
-          : compressionOptions_{std::move(compressionOptions)} {}
-
-      CompressionInformation compression() const override {
-#ifndef DISABLE_META_INTERNAL_COMPRESSOR
-        CompressionInformation information{
-            .compressionType = CompressionType::MetaInternal};
-        information.parameters.metaInternal.compressionLevel =
-            compressionOptions_.internalCompressionLevel;
-        information.parameters.metaInternal.decompressionLevel =
-            compressionOptions_.internalDecompressionLevel;
-        information.parameters.metaInternal.useVariableBitWidthCompressor =
-            compressionOptions_.useVariableBitWidthCompressor;
-        return information;
-#else
-        CompressionInformation information{
-            .compressionType = CompressionType::Zstd};
-        information.parameters.zstd.compressionLevel =
-            compressionOptions_.zstdCompressionLevel;
-        return information;
-#endif
-      }
-
-      virtual bool shouldAccept(
-          CompressionType compressionType,
-          uint64_t uncompressedSize,
-          uint64_t compressedSize) const override {
-        if (uncompressedSize * compressionOptions_.compressionAcceptRatio <
-            compressedSize) {
-          NIMBLE_SELECTION_LOG(
-              BLUE << compressionType
-                   << " compression rejected. Original size: "
-                   << uncompressedSize
-                   << ", Compressed size: " << compressedSize);
-          return false;
-        }
-
-        NIMBLE_SELECTION_LOG(
-            CYAN << compressionType
-                 << " compression accepted. Original size: " << uncompressedSize
-                 << ", Compressed size: " << compressedSize);
-        return true;
-      }
+    // On large streams, we start with approximate unique value statistics.
+    // Only if encodings sensitive to these statistics are close to winning, we
+    // pay for computing exact statistics.
+    bool approximate = false;
+    if constexpr (!isBoolType<physicalType>()) {
+      approximate = selectionOptions_.approximateStatisticsThreshold > 0 &&
+          values.size() >= selectionOptions_.approximateStatisticsThreshold;
+    }
 
-     private:
-      const CompressionOptions compressionOptions_;
-    };
+    EncodingType selectedEncoding;
+    float minCost;
+    float uniqueSensitiveCost;
+    const auto trivialRatio = trivialCompressionRatio(values);
+    std::tie(selectedEncoding, minCost, uniqueSensitiveCost) = selectEncoding(
+        values.size(), statistics, approximate, trivialRatio);
+    if (approximate &&
+        uniqueSensitiveCost <=
+            minCost * selectionOptions_.exactStatisticsCostRatio) {
+      NIMBLE_SELECTION_LOG(
+          PURPLE << "Unique sensitive encodings are close winners. "
+                 << "Re-evaluating using exact statistics.");
+      std::tie(selectedEncoding, minCost, uniqueSensitiveCost) =
+          selectEncoding(
+              values.size(),
+              statistics,
+              /* approximate */ false,
+              trivialRatio);
+    }
 
     NIMBLE_SELECTION_LOG(
         "Selected Encoding"
@@ -262,10 +324,7 @@ class ManualEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
                 : ""));
     return {
         .encodingType = selectedEncoding,
-        .compressionPolicyFactory = [compressionOptions =
-                                         compressionOptions_]() {
-          return std::make_unique<AlwaysCompressPolicy>(compressionOptions);
-        }};
+        .compressionPolicyFactory = compressionPolicyFactory()};
   }
 
   EncodingSelectionResult selectNullable(
@@ -286,6 +345,390 @@ class ManualEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
   }
 
  private:
+  // Currently, we always attempt to compress leaf data streams. The logic
+  // behind this is that encoding selection optimizes the in-memory layout of
+  // data, while compression provides extra saving for persistent storage (and
+  // bandwidth).
+  class AlwaysCompressPolicy : public CompressionPolicy {
+   public:
+    explicit AlwaysCompressPolicy(CompressionOptions compressionOptions)
+        : compressionOptions_{std::move(compressionOptions)} {}
+
+    CompressionInformation compression() const override {
+#ifndef DISABLE_META_INTERNAL_COMPRESSOR
+      constexpr auto kDefaultCompressionType = CompressionType::MetaInternal;
+#else
+      constexpr auto kDefaultCompressionType = CompressionType::Zstd;
+#endif
+      return compressionInformation(
+          compressionOptions_.compressionType.value_or(
+              kDefaultCompressionType),
+          compressionOptions_);
+    }
+
+    virtual bool shouldAccept(
+        CompressionType compressionType,
+        uint64_t uncompressedSize,
+        uint64_t compressedSize) const override {
+      if (uncompressedSize * compressionOptions_.compressionAcceptRatio <
+          compressedSize) {
+        NIMBLE_SELECTION_LOG(
+            BLUE << compressionType
+                 << " compression rejected. Original size: "
+                 << uncompressedSize
+                 << ", Compressed size: " << compressedSize);
+        return false;
+      }
+
+      NIMBLE_SELECTION_LOG(
+          CYAN << compressionType
+               << " compression accepted. Original size: " << uncompressedSize
+               << ", Compressed size: " << compressedSize);
+      return true;
+    }
+
+    bool shouldAttempt(std::string_view data) const override {
+      if (compressionOptions_.compressionSkipRatio >= 1.0f) {
+        return true;
+      }
+      const auto estimatedRatio = entropy::estimateCompressionRatio(data);
+      if (estimatedRatio > compressionOptions_.compressionSkipRatio) {
+        NIMBLE_SELECTION_LOG(
+            BLUE << "Compression skipped. Original size: " << data.size()
+                 << ", Estimated ratio: " << estimatedRatio);
+        return false;
+      }
+      return true;
+    }
+
+   private:
+    const CompressionOptions compressionOptions_;
+  };
+
+  std::function<std::unique_ptr<CompressionPolicy>()> compressionPolicyFactory()
+      const {
+    return [compressionOptions = compressionOptions_]() {
+      return std::make_unique<AlwaysCompressPolicy>(compressionOptions);
+    };
+  }
+
+  // Selection policy used for trial encoding a sample. The root encoding is
+  // forced, while nested streams are selected by the wrapped policy.
+  class TrialEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
+   public:
+    TrialEncodingSelectionPolicy(
+        EncodingType encodingType,
+        std::unique_ptr<ManualEncodingSelectionPolicy> policy)
+        : encodingType_{encodingType}, policy_{std::move(policy)} {}
+
+    EncodingSelectionResult select(
+        std::span<const physicalType> /* values */,
+        const Statistics<physicalType>& /* statistics */) override {
+      return {
+          .encodingType = encodingType_,
+          .compressionPolicyFactory = policy_->compressionPolicyFactory()};
+    }
+
+    EncodingSelectionResult selectNullable(
+        std::span<const physicalType> values,
+        std::span<const bool> nulls,
+        const Statistics<physicalType>& statistics) override {
+      return policy_->selectNullable(values, nulls, statistics);
+    }
+
+    std::unique_ptr<EncodingSelectionPolicyBase> createImpl(
+        EncodingType encodingType,
+        NestedEncodingIdentifier identifier,
+        DataType type) override {
+      return policy_->createImpl(encodingType, identifier, type);
+    }
+
+   private:
+    const EncodingType encodingType_;
+    const std::unique_ptr<ManualEncodingSelectionPolicy> policy_;
+  };
+
+  bool shouldSample(
+      uint64_t entryCount,
+      const Statistics<physicalType>& statistics) const {
+    // Note: A single run is always encoded as Constant, so there is nothing to
+    // gain from sampling (and a constant sample doesn't guarantee a constant
+    // stream).
+    return selectionOptions_.samplingThreshold > 0 &&
+        entryCount >= selectionOptions_.samplingThreshold &&
+        entryCount > uint64_t{selectionOptions_.sampleSliceCount} *
+                selectionOptions_.sampleSliceSize &&
+        statistics.consecutiveRepeatCount() > 1;
+  }
+
+  std::vector<physicalType> sample(
+      std::span<const physicalType> values) const {
+    const auto sliceCount = selectionOptions_.sampleSliceCount;
+    const auto sliceSize = selectionOptions_.sampleSliceSize;
+    const uint64_t stride = values.size() / sliceCount;
+    std::vector<physicalType> sampled;
+    sampled.reserve(sliceCount * sliceSize);
+    for (auto i = 0; i < sliceCount; ++i) {
+      const auto slice = values.subspan(i * stride, sliceSize);
+      sampled.insert(sampled.end(), slice.begin(), slice.end());
+    }
+    return sampled;
+  }
+
+  // Selects an encoding by inspecting a sample of the data. If trial encoding
+  // is enabled, the best candidates are encoded (with their nested encodings
+  // and compression) on the sample, and the smallest result wins.
+  EncodingType selectSampled(std::span<const physicalType> values) const {
+    const auto sampled = sample(values);
+    const auto statistics = Statistics<physicalType>::create(sampled);
+    auto costs = estimateCosts(
+        sampled.size(),
+        statistics,
+        /* approximate */ false,
+        /* sampled */ true,
+        trivialCompressionRatio(sampled));
+    NIMBLE_CHECK(!costs.empty(), "No compatible encoding found for sample.");
+    std::sort(costs.begin(), costs.end(), [](const auto& a, const auto& b) {
+      return a.second < b.second;
+    });
+    if (selectionOptions_.trialEncodingPool == nullptr ||
+        selectionOptions_.trialEncodingCandidates <= 1) {
+      return costs.front().first;
+    }
+
+    Buffer buffer{*selectionOptions_.trialEncodingPool};
+    EncodingType selectedEncoding = costs.front().first;
+    float minCost = std::numeric_limits<float>::max();
+    const auto candidateCount = std::min<size_t>(
+        costs.size(), selectionOptions_.trialEncodingCandidates);
+    for (auto i = 0; i < candidateCount; ++i) {
+      const auto encodingType = costs[i].first;
+      const auto size = trialEncode(encodingType, sampled, buffer);
+      const auto cost = size * readFactor(encodingType);
+      NIMBLE_SELECTION_LOG(
+          YELLOW << "Trial Encoding: " << encodingType << ", Size: " << size
+                 << ", Cost: " << cost);
+      if (cost < minCost) {
+        minCost = cost;
+        selectedEncoding = encodingType;
+      }
+    }
+    return selectedEncoding;
+  }
+
+  uint64_t trialEncode(
+      EncodingType encodingType,
+      const std::vector<physicalType>& sampled,
+      Buffer& buffer) const {
+    auto selectionOptions = selectionOptions_;
+    selectionOptions.samplingThreshold = 0;
+    auto policy = std::make_unique<TrialEncodingSelectionPolicy>(
+        encodingType,
+        std::make_unique<ManualEncodingSelectionPolicy>(
+            readFactors_,
+            compressionOptions_,
+            identifier_,
+            std::move(selectionOptions)));
+    return EncodingFactory::encode<T>(
+               std::move(policy),
+               std::span<const T>{
+                   reinterpret_cast<const T*>(sampled.data()),
+                   sampled.size()},
+               buffer)
+        .size();
+  }
+
+  float readFactor(EncodingType encodingType) const {
+    for (const auto& pair : readFactors_) {
+      if (pair.first == encodingType) {
+        return pair.second;
+      }
+    }
+    NIMBLE_UNREACHABLE(
+        fmt::format(
+            "Missing read factor for encoding {}.", toString(encodingType)));
+  }
+
+  // Returns the compression ratio expected for the raw data (i.e. Trivial
+  // encoding payload), as estimated by an entropy probe. Returns 1 when
+  // compressionAwareTrivialEstimate is disabled, or when compression is not
+  // expected to be accepted.
+  float trivialCompressionRatio(std::span<const physicalType> values) const {
+    if constexpr (isBoolType<physicalType>()) {
+      return 1.0f;
+    } else {
+      if (!selectionOptions_.compressionAwareTrivialEstimate ||
+          values.empty()) {
+        return 1.0f;
+      }
+      double ratio;
+      if constexpr (isNumericType<physicalType>()) {
+        ratio = entropy::estimateCompressionRatio(
+            {reinterpret_cast<const char*>(values.data()),
+             values.size() * sizeof(physicalType)});
+      } else {
+        // Concatenate evenly spaced strings into a small probe buffer.
+        constexpr uint64_t kProbeSize = 4096;
+        std::string probe;
+        probe.reserve(kProbeSize);
+        const uint64_t stride = std::max<uint64_t>(
+            1, values.size() / std::max<uint64_t>(1, kProbeSize / 16));
+        for (uint64_t i = 0; i < values.size() && probe.size() < kProbeSize;
+             i += stride) {
+          probe.append(values[i]);
+        }
+        ratio = entropy::estimateCompressionRatio(probe);
+      }
+      return ratio <= compressionOptions_.compressionAcceptRatio ? ratio : 1.0f;
+    }
+  }
+
+  // Estimates the cost of all compatible candidate encodings. When estimating
+  // on a sample, Constant encoding is skipped, as a constant sample doesn't
+  // guarantee a constant stream. |trivialRatio| scales the estimated size of
+  // Trivial encoding (see trivialCompressionRatio()).
+  std::vector<std::pair<EncodingType, float>> estimateCosts(
+      uint64_t entryCount,
+      const Statistics<physicalType>& statistics,
+      bool approximate,
+      bool sampled,
+      float trivialRatio) const {
+    std::vector<std::pair<EncodingType, float>> costs;
+    costs.reserve(readFactors_.size());
+    const auto useReadCostModel = selectionOptions_.readCostModel &&
+        selectionOptions_.readCostWeight > 0.0f;
+    for (const auto& pair : readFactors_) {
+      auto encodingType = pair.first;
+      if (sampled && encodingType == EncodingType::Constant) {
+        continue;
+      }
+      auto size =
+          estimateSize(encodingType, entryCount, statistics, approximate);
+      if (!size.has_value()) {
+        NIMBLE_SELECTION_LOG(
+            PURPLE << encodingType << " encoding is incompatible.");
+        continue;
+      }
+      if (encodingType == EncodingType::Trivial) {
+        size = static_cast<uint64_t>(size.value() * trivialRatio);
+      }
+
+      // We use read factor weights to raise/lower the favorability of each
+      // encoding.
+      auto readFactor = pair.second;
+      auto cost = size.value() * readFactor;
+      if (useReadCostModel) {
+        auto nanosPerValue = selectionOptions_.readCostModel->cost(
+            encodingType, TypeTraits<T>::dataType, bitWidth(statistics));
+        if (nanosPerValue.has_value()) {
+          cost += selectionOptions_.readCostWeight * nanosPerValue.value() *
+              entryCount;
+        }
+      }
+      NIMBLE_SELECTION_LOG(
+          YELLOW << "Encoding: " << encodingType << ", Size: " << size.value()
+                 << ", Factor: " << readFactor << ", Cost: " << cost
+                 << (approximate ? " (approximate)" : "")
+                 << (sampled ? " (sampled)" : ""));
+      costs.emplace_back(encodingType, cost);
+    }
+    return costs;
+  }
+
+  // Returns the bit width used to look up decode costs in the read cost
+  // model. Integer costs are calibrated at power of two bit widths, so the
+  // bit width of the values' range is rounded up to the next power of two.
+  // Bit widths don't apply to floating point (or non-numeric) values.
+  static uint32_t bitWidth(const Statistics<physicalType>& statistics) {
+    if constexpr (isNumericType<physicalType>() && !isFloatingPointType<T>()) {
+      return std::bit_ceil<uint32_t>(
+          bits::bitsRequired(statistics.max() - statistics.min()));
+    } else {
+      return 0;
+    }
+  }
+
+  // Iterates on all candidate encodings, and picks the encoding with the
+  // minimal cost. Returns the selected encoding, its cost and the minimal cost
+  // of the encodings sensitive to unique value statistics (Dictionary and
+  // MainlyConstant, and RLE for strings, whose run values are estimated as a
+  // dictionary).
+  std::tuple<EncodingType, float, float> selectEncoding(
+      uint64_t entryCount,
+      const Statistics<physicalType>& statistics,
+      bool approximate,
+      float trivialRatio) const {
+    float minCost = std::numeric_limits<float>::max();
+    float uniqueSensitiveCost = std::numeric_limits<float>::max();
+    EncodingType selectedEncoding = EncodingType::Trivial;
+    for (const auto& [encodingType, cost] : estimateCosts(
+             entryCount,
+             statistics,
+             approximate,
+             /* sampled */ false,
+             trivialRatio)) {
+      if (cost < minCost) {
+        minCost = cost;
+        selectedEncoding = encodingType;
+      }
+      if (encodingType == EncodingType::Dictionary ||
+          encodingType == EncodingType::MainlyConstant ||
+          (isStringType<physicalType>() &&
+           encodingType == EncodingType::RLE)) {
+        uniqueSensitiveCost = std::min(uniqueSensitiveCost, cost);
+      }
+    }
+    return {selectedEncoding, minCost, uniqueSensitiveCost};
+  }
+
+  // Helpers abstracting over exact and approximate unique value statistics.
+  static uint64_t uniqueCount(
+      const Statistics<physicalType>& statistics,
+      bool approximate) {
+    if constexpr (!isBoolType<physicalType>()) {
+      if (approximate) {
+        return statistics.approximateUniqueCounts().size();
+      }
+    }
+    return statistics.uniqueCounts().size();
+  }
+
+  static std::pair<physicalType, uint64_t> mostCommon(
+      const Statistics<physicalType>& statistics,
+      bool approximate) {
+    if constexpr (!isBoolType<physicalType>()) {
+      if (approximate) {
+        const auto& uniqueCounts = statistics.approximateUniqueCounts();
+        return {
+            uniqueCounts.mostCommonValue(), uniqueCounts.mostCommonCount()};
+      }
+    }
+    const auto maxUniqueCount = std::max_element(
+        statistics.uniqueCounts().cbegin(),
+        statistics.uniqueCounts().cend(),
+        [](const auto& a, const auto& b) { return a.second < b.second; });
+    return {maxUniqueCount->first, maxUniqueCount->second};
+  }
+
+  // Returns the total length of all unique strings. When approximating, we
+  // assume unique strings have the average string length.
+  static uint64_t uniqueStringsLength(
+      uint64_t entryCount,
+      const Statistics<std::string_view>& statistics,
+      bool approximate) {
+    if (approximate) {
+      return statistics.totalStringsLength() *
+          statistics.approximateUniqueCounts().size() / entryCount;
+    }
+    return std::accumulate(
+        statistics.uniqueCounts().cbegin(),
+        statistics.uniqueCounts().cend(),
+        0,
+        [](const uint32_t sum, const auto& unique) {
+          return sum + unique.first.size();
+        });
+  }
+
   static inline uint32_t
   bitPackedBytes(uint64_t minValue, uint64_t maxValue, uint32_t count) {
     if constexpr (FixedByteWidth) {
@@ -304,10 +747,12 @@ class ManualEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
   static std::optional<uint64_t> estimateNumericSize(
       EncodingType encodingType,
       uint64_t entryCount,
-      const Statistics<physicalType>& statistics) {
+      const Statistics<physicalType>& statistics,
+      bool approximate) {
     switch (encodingType) {
       case EncodingType::Constant: {
-        return statistics.uniqueCounts().size() == 1
+        // A single run is equivalent to a single unique value.
+        return statistics.consecutiveRepeatCount() == 1
             ? std::optional<uint64_t>{getEncodingOverhead<
                   EncodingType::Constant,
                   physicalType>()}
@@ -326,12 +771,9 @@ class ManualEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
         // be stored bit-packed, with bit width of max(rowCount).
 
         // Find most common item count
-        const auto maxUniqueCount = std::max_element(
-            statistics.uniqueCounts().cbegin(),
-            statistics.uniqueCounts().cend(),
-            [](const auto& a, const auto& b) { return a.second < b.second; });
+        const auto maxUniqueCount = mostCommon(statistics, approximate);
         // Deduce uncommon values count
-        const auto uncommonCount = entryCount - maxUniqueCount->second;
+        const auto uncommonCount = entryCount - maxUniqueCount.second;
         // Assuming the uncommon values will be stored bit packed.
         const auto uncommonValueSize =
             bitPackedBytes(statistics.min(), statistics.max(), uncommonCount);
@@ -364,10 +806,9 @@ class ManualEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
         // Alphabet stored trivially.
         // Indices are stored bit-packed, with bit width needed to store max
         // dictionary size (which is the unique value count).
-        const uint64_t indicesSize =
-            bitPackedBytes(0, statistics.uniqueCounts().size(), entryCount);
-        const uint64_t alphabetSize =
-            statistics.uniqueCounts().size() * sizeof(physicalType);
+        const uint64_t uniques = uniqueCount(statistics, approximate);
+        const uint64_t indicesSize = bitPackedBytes(0, uniques, entryCount);
+        const uint64_t alphabetSize = uniques * sizeof(physicalType);
         uint32_t overhead =
             getEncodingOverhead<EncodingType::Dictionary, physicalType>() +
             // Alphabet overhead
@@ -419,6 +860,30 @@ class ManualEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
           return std::nullopt;
         }
       }
+      case EncodingType::StreamVByte: {
+        // Applies to all 32 bit physical types (including float, whose bits
+        // are encoded as an unsigned integer).
+        if constexpr (
+            isNumericType<physicalType>() && sizeof(physicalType) == 4) {
+          // Varint buckets hold 7 bit ranges, so we assume the longest byte
+          // length in each bucket (1, 2, 3, 4 and 4 bytes). Each value also
+          // consumes 2 control bits.
+          size_t i = 0;
+          const uint64_t dataSize = std::accumulate(
+              statistics.bucketCounts().cbegin(),
+              statistics.bucketCounts().cend(),
+              uint64_t{0},
+              [&i](const uint64_t sum, const uint64_t bucketSize) {
+                return sum + (bucketSize * std::min<size_t>(++i, 4));
+              });
+          return getEncodingOverhead<
+                     EncodingType::StreamVByte,
+                     physicalType>() +
+              streamvbyte::controlSize(entryCount) + dataSize;
+        } else {
+          return std::nullopt;
+        }
+      }
       default: {
         return std::nullopt;
       }
@@ -428,7 +893,8 @@ class ManualEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
   static std::optional<uint64_t> estimateBoolSize(
       EncodingType encodingType,
       size_t entryCount,
-      const Statistics<physicalType>& statistics) {
+      const Statistics<physicalType>& statistics,
+      bool /* approximate */) {
     switch (encodingType) {
       case EncodingType::Constant: {
         return statistics.uniqueCounts().size() == 1
@@ -480,11 +946,13 @@ class ManualEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
   static std::optional<uint64_t> estimateStringSize(
       EncodingType encodingType,
       size_t entryCount,
-      const Statistics<std::string_view>& statistics) {
+      const Statistics<std::string_view>& statistics,
+      bool approximate) {
     const uint32_t maxStringSize = statistics.max().size();
     switch (encodingType) {
       case EncodingType::Constant: {
-        return statistics.uniqueCounts().size() == 1
+        // A single run is equivalent to a single unique value.
+        return statistics.consecutiveRepeatCount() == 1
             ? std::optional<uint64_t>{getEncodingOverhead<
                   EncodingType::Constant,
                   physicalType>(maxStringSize)}
@@ -505,36 +973,30 @@ class ManualEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
         // be stored bit-packed, with bit width of max(rowCount).
 
         // Find the most common item count
-        const auto maxUniqueCount = std::max_element(
-            statistics.uniqueCounts().cbegin(),
-            statistics.uniqueCounts().cend(),
-            [](const auto& a, const auto& b) { return a.second < b.second; });
+        const auto maxUniqueCount = mostCommon(statistics, approximate);
         // Get the total blob size for all (unique) strings
-        const uint64_t alphabetByteSize = std::accumulate(
-            statistics.uniqueCounts().cbegin(),
-            statistics.uniqueCounts().cend(),
-            0,
-            [](const uint32_t sum, const auto& unique) {
-              return sum + unique.first.size();
-            });
+        const uint64_t alphabetByteSize =
+            uniqueStringsLength(entryCount, statistics, approximate);
         // Deduce uncommon values count
-        const auto uncommonCount = entryCount - maxUniqueCount->second;
+        const auto uncommonCount = entryCount - maxUniqueCount.second;
         // Remove common string from blob, and add the (bit-packed) string
         // lengths to the size.
         // Note: we remove the common string, as it is later added back when
         // calculating the header overhead.
+        // Note: when approximating, the unique strings length is an estimate,
+        // so we make sure not to underflow.
         const uint64_t alphabetSize = alphabetByteSize -
-            maxUniqueCount->first.size() +
+            std::min<uint64_t>(maxUniqueCount.first.size(), alphabetByteSize) +
             bitPackedBytes(statistics.min().size(),
                            statistics.max().size(),
-                           statistics.uniqueCounts().size());
+                           uniqueCount(statistics, approximate));
         // Uncommon values (sparse bool) bitmap will have index per value,
         // stored bit packed.
         const auto uncommonIndicesSize =
             bitPackedBytes(0, entryCount, uncommonCount);
         uint32_t overhead =
             getEncodingOverhead<EncodingType::MainlyConstant, physicalType>(
-                maxUniqueCount->first.size()) +
+                maxUniqueCount.first.size()) +
             // Overhead for storing uncommon values
             getEncodingOverhead<EncodingType::Trivial, physicalType>(
                 maxStringSize) +
@@ -558,21 +1020,16 @@ class ManualEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
         // Alphabet stored trivially.
         // Indices are stored bit-packed, with bit width needed to store max
         // dictionary size (which is the unique value count).
-        const uint64_t indicesSize =
-            bitPackedBytes(0, statistics.uniqueCounts().size(), entryCount);
+        const uint64_t uniques = uniqueCount(statistics, approximate);
+        const uint64_t indicesSize = bitPackedBytes(0, uniques, entryCount);
         // Get the total blob size for all (unique) strings
-        const uint64_t alphabetByteSize = std::accumulate(
-            statistics.uniqueCounts().cbegin(),
-            statistics.uniqueCounts().cend(),
-            0,
-            [](const uint32_t sum, const auto& unique) {
-              return sum + unique.first.size();
-            });
+        const uint64_t alphabetByteSize =
+            uniqueStringsLength(entryCount, statistics, approximate);
         // Add (bit-packed) string lengths
         const uint64_t alphabetSize = alphabetByteSize +
             bitPackedBytes(statistics.min().size(),
                            statistics.max().size(),
-                           statistics.uniqueCounts().size());
+                           uniques);
         uint32_t overhead =
             getEncodingOverhead<EncodingType::Dictionary, physicalType>(
                 maxStringSize) +
@@ -591,13 +1048,7 @@ class ManualEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
 
         uint64_t runValuesSize =
             // (unique) strings blob size
-            std::accumulate(
-                statistics.uniqueCounts().cbegin(),
-                statistics.uniqueCounts().cend(),
-                0,
-                [](const uint32_t sum, const auto& unique) {
-                  return sum + unique.first.size();
-                }) +
+            uniqueStringsLength(entryCount, statistics, approximate) +
             // (bit-packed) string lengths
             bitPackedBytes(
                 statistics.min().size(),
@@ -606,7 +1057,7 @@ class ManualEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
             // dictionary indices
             bitPackedBytes(
                 0,
-                statistics.uniqueCounts().size(),
+                uniqueCount(statistics, approximate),
                 statistics.consecutiveRepeatCount());
         const auto runLengthsSize = bitPackedBytes(
             statistics.minRepeat(),
@@ -631,13 +1082,17 @@ class ManualEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
   static std::optional<uint64_t> estimateSize(
       EncodingType encodingType,
       size_t entryCount,
-      const Statistics<physicalType>& statistics) {
+      const Statistics<physicalType>& statistics,
+      bool approximate) {
     if constexpr (isNumericType<physicalType>()) {
-      return estimateNumericSize(encodingType, entryCount, statistics);
+      return estimateNumericSize(
+          encodingType, entryCount, statistics, approximate);
     } else if constexpr (isBoolType<physicalType>()) {
-      return estimateBoolSize(encodingType, entryCount, statistics);
+      return estimateBoolSize(
+          encodingType, entryCount, statistics, approximate);
     } else if constexpr (isStringType<physicalType>()) {
-      return estimateStringSize(encodingType, entryCount, statistics);
+      return estimateStringSize(
+          encodingType, entryCount, statistics, approximate);
     }
 
     NIMBLE_UNREACHABLE(fmt::format(
@@ -686,6 +1141,8 @@ class ManualEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
       return commonPrefixSize + sizeof(uint32_t); // Run Lengths size (4 byte)
     } else if constexpr (encodingType == EncodingType::Varint) {
       return commonPrefixSize + sizeof(dataType); // Baseline (size of dataType)
+    } else if constexpr (encodingType == EncodingType::StreamVByte) {
+      return commonPrefixSize + sizeof(dataType); // Baseline (size of dataType)
     } else if constexpr (encodingType == EncodingType::Nullable) {
       return commonPrefixSize + sizeof(uint32_t); // Data size (4 bytes)
     }
@@ -700,27 +1157,7 @@ class ManualEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
   const std::vector<std::pair<EncodingType, float>> readFactors_;
   const CompressionOptions compressionOptions_;
   const std::optional<NestedEncodingIdentifier> identifier_;
-};
-
-// This model is trained offline and parameters are updated here.
-// The parameters are relatively robust and do not need to be updated
-// unless we add / remove an encoding type.
-template <typename T>
-struct EncodingPredictionModel {
-  using physicalType = typename TypeTraits<T>::physicalType;
-  explicit EncodingPredictionModel()
-      : maxRepeatParam(1.52), minRepeatParam(1.13), uniqueParam(2.589) {}
-  float maxRepeatParam;
-  float minRepeatParam;
-  float uniqueParam;
-  float predict(const Statistics<physicalType>& statistics) {
-    // TODO: Utilize more features within statistics for prediction.
-    auto maxRepeat = statistics.maxRepeat();
-    auto minRepeat = statistics.minRepeat();
-    auto unique = statistics.uniqueCounts().size();
-    return maxRepeatParam * maxRepeat + minRepeatParam * minRepeat +
-        uniqueParam * unique;
-  }
+  const EncodingSelectionOptions selectionOptions_;
 };
 
 class ManualEncodingSelectionPolicyFactory {
@@ -728,9 +1165,11 @@ class ManualEncodingSelectionPolicyFactory {
   ManualEncodingSelectionPolicyFactory(
       std::vector<std::pair<EncodingType, float>> readFactors =
           defaultReadFactors(),
-      CompressionOptions compressionOptions = {})
+      CompressionOptions compressionOptions = {},
+      EncodingSelectionOptions selectionOptions = {})
       : readFactors_{std::move(readFactors)},
-        compressionOptions_{std::move(compressionOptions)} {}
+        compressionOptions_{std::move(compressionOptions)},
+        selectionOptions_{std::move(selectionOptions)} {}
 
   std::unique_ptr<EncodingSelectionPolicyBase> createPolicy(
       DataType dataType) const {
@@ -739,7 +1178,8 @@ class ManualEncodingSelectionPolicyFactory {
         ManualEncodingSelectionPolicy,
         readFactors_,
         compressionOptions_,
-        std::nullopt);
+        std::nullopt,
+        selectionOptions_);
   }
 
   static std::vector<EncodingType> possibleEncodings() {
@@ -752,6 +1192,7 @@ class ManualEncodingSelectionPolicyFactory {
         EncodingType::Dictionary,
         EncodingType::RLE,
         EncodingType::Varint,
+        EncodingType::StreamVByte,
     };
   }
 
@@ -825,9 +1266,12 @@ class ManualEncodingSelectionPolicyFactory {
  private:
   const std::vector<std::pair<EncodingType, float>> readFactors_;
   const CompressionOptions compressionOptions_;
+  const EncodingSelectionOptions selectionOptions_;
 };
 
 // This is a learned encoding selection implementation.
+// Instead of estimating the size of every candidate encoding, a (multi-class)
+// model predicts the best encoding from stream features.
 template <typename T>
 class LearnedEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
   using physicalType = typename TypeTraits<T>::physicalType;
@@ -836,16 +1280,16 @@ class LearnedEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
   LearnedEncodingSelectionPolicy(
       std::vector<EncodingType> encodingChoices,
       std::optional<NestedEncodingIdentifier> identifier,
-      EncodingPredictionModel<T> encodingModel = EncodingPredictionModel<T>())
+      EncodingPredictionModel encodingModel = EncodingPredictionModel())
       : encodingChoices_{std::move(encodingChoices)},
         identifier_{identifier},
-        mlModel_{encodingModel} {}
+        mlModel_{std::move(encodingModel)} {}
 
   LearnedEncodingSelectionPolicy()
       : LearnedEncodingSelectionPolicy{
             possibleEncodingChoices(),
             std::nullopt,
-            EncodingPredictionModel<T>()} {}
+            EncodingPredictionModel()} {}
 
   EncodingSelectionResult select(
       std::span<const physicalType> values,
@@ -856,17 +1300,26 @@ class LearnedEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
       };
     }
 
-    float prediction = mlModel_.predict(statistics);
-    if (prediction > 0.1) {
+    // A single run is always best stored as a constant, so there is no need
+    // to consult the model.
+    if (statistics.consecutiveRepeatCount() == 1 &&
+        isAllowed(EncodingType::Constant)) {
       return {
-          .encodingType = EncodingType::Trivial,
+          .encodingType = EncodingType::Constant,
       };
     }
-    // TODO: Implement a multi-class Encoding model so that we can predict not
-    // only a trivial encoding but also other encodings.
 
+    auto prediction = mlModel_.predict(
+        extractEncodingFeatures(values.size(), statistics),
+        [this](EncodingType encodingType) {
+          return encodingType != EncodingType::Constant &&
+              isAllowed(encodingType) && isCompatible(encodingType);
+        });
+    NIMBLE_SELECTION_LOG(
+        "Predicted Encoding: " << GREEN
+                               << prediction.value_or(EncodingType::Trivial));
     return {
-        .encodingType = EncodingType::Trivial,
+        .encodingType = prediction.value_or(EncodingType::Trivial),
     };
   }
 
@@ -904,7 +1357,8 @@ class LearnedEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
         type,
         LearnedEncodingSelectionPolicy,
         std::move(filteredReadFactors),
-        identifier);
+        identifier,
+        mlModel_);
   }
 
  private:
@@ -921,9 +1375,37 @@ class LearnedEncodingSelectionPolicy : public EncodingSelectionPolicy<T> {
     };
   }
 
+  bool isAllowed(EncodingType encodingType) const {
+    return std::find(
+               encodingChoices_.cbegin(),
+               encodingChoices_.cend(),
+               encodingType) != encodingChoices_.cend();
+  }
+
+  // Returns true if the encoding supports the data type (see
+  // EncodingFactory::encode).
+  static bool isCompatible(EncodingType encodingType) {
+    switch (encodingType) {
+      case EncodingType::Trivial:
+      case EncodingType::RLE:
+        return true;
+      case EncodingType::Dictionary:
+      case EncodingType::MainlyConstant:
+        return !isBoolType<physicalType>();
+      case EncodingType::FixedBitWidth:
+        return isNumericType<physicalType>();
+      case EncodingType::Varint:
+        return isIntegralType<physicalType>() && sizeof(T) >= 4;
+      case EncodingType::SparseBool:
+        return isBoolType<physicalType>();
+      default:
+        return false;
+    }
+  }
+
   std::vector<EncodingType> encodingChoices_;
   std::optional<NestedEncodingIdentifier> identifier_;
-  EncodingPredictionModel<T> mlModel_;
+  EncodingPredictionModel mlModel_;
 };
 
 class ReplayedCompressionPolicy : public nimble::CompressionPolicy {
@@ -935,27 +1417,7 @@ class ReplayedCompressionPolicy : public nimble::CompressionPolicy {
         compressionOptions_{std::move(compressionOptions)} {}
 
   nimble::CompressionInformation compression() const override {
-    if (compressionType_ == nimble::CompressionType::Uncompressed) {
-      return {.compressionType = nimble::CompressionType::Uncompressed};
-    }
-
-    if (compressionType_ == nimble::CompressionType::Zstd) {
-      nimble::CompressionInformation information{
-          .compressionType = nimble::CompressionType::Zstd};
-      information.parameters.zstd.compressionLevel =
-          compressionOptions_.zstdCompressionLevel;
-      return information;
-    }
-
-    nimble::CompressionInformation information{
-        .compressionType = nimble::CompressionType::MetaInternal};
-    information.parameters.metaInternal.compressionLevel =
-        compressionOptions_.internalCompressionLevel;
-    information.parameters.metaInternal.decompressionLevel =
-        compressionOptions_.internalDecompressionLevel;
-    information.parameters.metaInternal.useVariableBitWidthCompressor =
-        compressionOptions_.useVariableBitWidthCompressor;
-    return information;
+    return compressionInformation(compressionType_, compressionOptions_);
   }
 
   virtual bool shouldAccept(
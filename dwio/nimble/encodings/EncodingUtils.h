@@ -22,6 +22,7 @@
 #include "dwio/nimble/encodings/NullableEncoding.h"
 #include "dwio/nimble/encodings/RleEncoding.h"
 #include "dwio/nimble/encodings/SparseBoolEncoding.h"
+#include "dwio/nimble/encodings/StreamVByteEncoding.h"
 #include "dwio/nimble/encodings/TrivialEncoding.h"
 #include "dwio/nimble/encodings/VarintEncoding.h"
 
@@ -115,6 +116,12 @@ auto encodingTypeDispatchNonString(Encoding& encoding, F&& f) {
       } else {
         NIMBLE_UNREACHABLE(toString(encoding.dataType()));
       }
+    case EncodingType::StreamVByte:
+      if constexpr (folly::IsOneOf<T, int32_t, uint32_t, float>::value) {
+        return f(static_cast<StreamVByteEncoding<T>&>(encoding));
+      } else {
+        NIMBLE_UNREACHABLE(toString(encoding.dataType()));
+      }
     case EncodingType::Constant:
       return f(static_cast<ConstantEncoding<T>&>(encoding));
     case EncodingType::MainlyConstant:
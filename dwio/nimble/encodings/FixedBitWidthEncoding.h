@@ -57,6 +57,7 @@ class FixedBitWidthEncoding final
       std::string_view data);
 
   void reset() final;
+  bool reinitialize(std::string_view data) final;
   void skip(uint32_t rowCount) final;
   void materialize(uint32_t rowCount, void* buffer) final;
 
@@ -71,6 +72,8 @@ class FixedBitWidthEncoding final
   std::string debugString(int offset) const final;
 
  private:
+  void initialize(std::string_view data);
+
   int bitWidth_;
   physicalType baseline_;
   FixedBitArray fixedBitArray_;
@@ -90,15 +93,20 @@ FixedBitWidthEncoding<T>::FixedBitWidthEncoding(
     : TypedEncoding<T, physicalType>{memoryPool, data},
       uncompressedData_{&memoryPool},
       buffer_{&memoryPool} {
+  initialize(data);
+}
+
+template <typename T>
+void FixedBitWidthEncoding<T>::initialize(std::string_view data) {
   auto pos = data.data() + kCompressionOffset;
   auto compressionType = static_cast<CompressionType>(encoding::readChar(pos));
   baseline_ = encoding::read<const physicalType>(pos);
   bitWidth_ = static_cast<uint32_t>(encoding::readChar(pos));
   if (compressionType != CompressionType::Uncompressed) {
-    uncompressedData_ = Compression::uncompress(
-        memoryPool,
+    Compression::uncompress(
         compressionType,
-        {pos, static_cast<size_t>(data.end() - pos)});
+        {pos, static_cast<size_t>(data.end() - pos)},
+        uncompressedData_);
     fixedBitArray_ = FixedBitArray{
         {uncompressedData_.data(), uncompressedData_.size()}, bitWidth_};
   } else {
@@ -112,6 +120,14 @@ void FixedBitWidthEncoding<T>::reset() {
   row_ = 0;
 }
 
+template <typename T>
+bool FixedBitWidthEncoding<T>::reinitialize(std::string_view data) {
+  this->reinitializePrefix(data);
+  initialize(data);
+  reset();
+  return true;
+}
+
 template <typename T>
 void FixedBitWidthEncoding<T>::skip(uint32_t rowCount) {
   row_ += rowCount;
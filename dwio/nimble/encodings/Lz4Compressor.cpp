@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dwio/nimble/encodings/Lz4Compressor.h"
+
+#include <lz4.h>
+#include <optional>
+
+namespace facebook::nimble {
+
+CompressionResult Lz4Compressor::compress(
+    velox::memory::MemoryPool& memoryPool,
+    std::string_view data,
+    DataType /* dataType */,
+    int /* bitWidth */,
+    const CompressionPolicy& compressionPolicy) {
+  if (data.size() > LZ4_MAX_INPUT_SIZE) {
+    return {
+        .compressionType = CompressionType::Uncompressed,
+        .buffer = std::nullopt,
+    };
+  }
+
+  auto parameters = compressionPolicy.compression().parameters.lz4;
+  Vector<char> buffer{&memoryPool, data.size() + sizeof(uint32_t)};
+  auto pos = buffer.data();
+  encoding::writeUint32(data.size(), pos);
+  // Returns zero if the compressed data doesn't fit in the output buffer
+  // (meaning compression isn't beneficial).
+  auto ret = LZ4_compress_fast(
+      data.data(),
+      pos,
+      static_cast<int>(data.size()),
+      static_cast<int>(data.size()),
+      parameters.acceleration);
+  if (ret <= 0) {
+    return {
+        .compressionType = CompressionType::Uncompressed,
+        .buffer = std::nullopt,
+    };
+  }
+
+  buffer.resize(ret + sizeof(uint32_t));
+  return {
+      .compressionType = CompressionType::Lz4,
+      .buffer = std::move(buffer),
+  };
+}
+
+Vector<char> Lz4Compressor::uncompress(
+    velox::memory::MemoryPool& memoryPool,
+    CompressionType compressionType,
+    std::string_view data) {
+  Vector<char> buffer{&memoryPool};
+  uncompress(compressionType, data, buffer);
+  return buffer;
+}
+
+void Lz4Compressor::uncompress(
+    CompressionType /* compressionType */,
+    std::string_view data,
+    Vector<char>& output) {
+  auto pos = data.data();
+  const uint32_t uncompressedSize = encoding::readUint32(pos);
+  // Previous content is overwritten, so avoid copying it if we need to grow.
+  output.update_size(0);
+  output.resize(uncompressedSize);
+  auto ret = LZ4_decompress_safe(
+      pos,
+      output.data(),
+      static_cast<int>(data.size() - sizeof(uint32_t)),
+      static_cast<int>(uncompressedSize));
+  NIMBLE_CHECK(
+      ret >= 0 && static_cast<uint32_t>(ret) == uncompressedSize,
+      fmt::format("Error uncompressing LZ4 data (return code: {}).", ret));
+}
+
+CompressionType Lz4Compressor::compressionType() {
+  return CompressionType::Lz4;
+}
+
+} // namespace facebook::nimble
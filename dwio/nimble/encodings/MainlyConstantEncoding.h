@@ -70,6 +70,7 @@ class MainlyConstantEncoding final
       std::string_view data);
 
   void reset() final;
+  bool reinitialize(std::string_view data) final;
   void skip(uint32_t rowCount) final;
   void materialize(uint32_t rowCount, void* buffer) final;
 
@@ -92,6 +93,8 @@ class MainlyConstantEncoding final
   std::string debugString(int offset) const final;
 
  private:
+  void initialize(std::string_view data);
+
   std::unique_ptr<Encoding> isCommon_;
   std::unique_ptr<Encoding> otherValues_;
   physicalType commonValue_;
@@ -111,13 +114,19 @@ MainlyConstantEncoding<T>::MainlyConstantEncoding(
     : TypedEncoding<T, physicalType>(memoryPool, data),
       isCommonBuffer_(&memoryPool),
       otherValuesBuffer_(&memoryPool) {
+  initialize(data);
+}
+
+template <typename T>
+void MainlyConstantEncoding<T>::initialize(std::string_view data) {
   const char* pos = data.data() + Encoding::kPrefixSize;
   const uint32_t isCommonBytes = encoding::readUint32(pos);
-  isCommon_ = EncodingFactory::decode(this->memoryPool_, {pos, isCommonBytes});
+  isCommon_ = EncodingFactory::decode(
+      this->memoryPool_, {pos, isCommonBytes}, std::move(isCommon_));
   pos += isCommonBytes;
   const uint32_t otherValuesBytes = encoding::readUint32(pos);
-  otherValues_ =
-      EncodingFactory::decode(this->memoryPool_, {pos, otherValuesBytes});
+  otherValues_ = EncodingFactory::decode(
+      this->memoryPool_, {pos, otherValuesBytes}, std::move(otherValues_));
   pos += otherValuesBytes;
   commonValue_ = encoding::read<physicalType>(pos);
   NIMBLE_CHECK(pos == data.end(), "Unexpected mainly constant encoding end");
@@ -129,6 +138,13 @@ void MainlyConstantEncoding<T>::reset() {
   otherValues_->reset();
 }
 
+template <typename T>
+bool MainlyConstantEncoding<T>::reinitialize(std::string_view data) {
+  this->reinitializePrefix(data);
+  initialize(data);
+  return true;
+}
+
 template <typename T>
 void MainlyConstantEncoding<T>::skip(uint32_t rowCount) {
   // Hrm this isn't ideal. We should return to this later -- a new
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+
+#include "dwio/nimble/common/Types.h"
+#include "dwio/nimble/encodings/Encoding.h"
+#include "dwio/nimble/encodings/FixedBitWidthEncoding.h"
+#include "dwio/nimble/encodings/TrivialEncoding.h"
+
+// Composite encodings (e.g. Nullable or Dictionary) decode every batch
+// through their nested encodings. NestedEncoding owns a nested encoding, and
+// resolves its concrete type once, when the nested encoding is decoded (or
+// re-initialized), for the most common layouts. Batch decoding then calls the
+// concrete (final) encoding, which the compiler devirtualizes and inlines,
+// and parents can fuse the nested decoding into their own loops, e.g. by
+// reading a trivially encoded nulls bitmap in place instead of materializing
+// it.
+
+namespace facebook::nimble {
+
+enum class NestedEncodingKind : uint8_t {
+  Trivial,
+  FixedBitWidth,
+  Other,
+};
+
+// T is the data type of the nested encoding.
+template <typename T>
+class NestedEncoding {
+ public:
+  NestedEncoding& operator=(std::unique_ptr<Encoding> encoding) {
+    encoding_ = std::move(encoding);
+    kind_ = resolve(*encoding_);
+    return *this;
+  }
+
+  // Releases the nested encoding, e.g. to re-initialize it on new data (see
+  // EncodingFactory::decode).
+  std::unique_ptr<Encoding> release() {
+    kind_ = NestedEncodingKind::Other;
+    return std::move(encoding_);
+  }
+
+  Encoding* get() const {
+    return encoding_.get();
+  }
+
+  Encoding* operator->() const {
+    return encoding_.get();
+  }
+
+  Encoding& operator*() const {
+    return *encoding_;
+  }
+
+  NestedEncodingKind kind() const {
+    return kind_;
+  }
+
+  // The nested encoding as its concrete type E, which must match kind().
+  template <typename E>
+  E& as() const {
+    NIMBLE_DASSERT(dynamic_cast<E*>(encoding_.get()), "Unexpected encoding.");
+    return static_cast<E&>(*encoding_);
+  }
+
+  void materialize(uint32_t rowCount, void* buffer) {
+    switch (kind_) {
+      case NestedEncodingKind::Trivial:
+        as<TrivialEncoding<T>>().materialize(rowCount, buffer);
+        return;
+      case NestedEncodingKind::FixedBitWidth:
+        if constexpr (kFixedBitWidth) {
+          as<FixedBitWidthEncoding<T>>().materialize(rowCount, buffer);
+          return;
+        }
+        [[fallthrough]];
+      default:
+        encoding_->materialize(rowCount, buffer);
+    }
+  }
+
+  void skip(uint32_t rowCount) {
+    switch (kind_) {
+      case NestedEncodingKind::Trivial:
+        as<TrivialEncoding<T>>().skip(rowCount);
+        return;
+      case NestedEncodingKind::FixedBitWidth:
+        if constexpr (kFixedBitWidth) {
+          as<FixedBitWidthEncoding<T>>().skip(rowCount);
+          return;
+        }
+        [[fallthrough]];
+      default:
+        encoding_->skip(rowCount);
+    }
+  }
+
+ private:
+  static constexpr bool kFixedBitWidth =
+      isNumericType<typename TypeTraits<T>::physicalType>();
+
+  static NestedEncodingKind resolve(const Encoding& encoding) {
+    if (encoding.dataType() != TypeTraits<T>::dataType) {
+      return NestedEncodingKind::Other;
+    }
+    switch (encoding.encodingType()) {
+      case EncodingType::Trivial:
+        return NestedEncodingKind::Trivial;
+      case EncodingType::FixedBitWidth:
+        return kFixedBitWidth ? NestedEncodingKind::FixedBitWidth
+                              : NestedEncodingKind::Other;
+      default:
+        return NestedEncodingKind::Other;
+    }
+  }
+
+  std::unique_ptr<Encoding> encoding_;
+  NestedEncodingKind kind_{NestedEncodingKind::Other};
+};
+
+} // namespace facebook::nimble
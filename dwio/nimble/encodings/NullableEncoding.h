@@ -27,6 +27,8 @@
 #include "dwio/nimble/encodings/EncodingFactory.h"
 #include "dwio/nimble/encodings/EncodingIdentifier.h"
 #include "dwio/nimble/encodings/EncodingSelection.h"
+#include "dwio/nimble/encodings/NestedEncoding.h"
+#include "dwio/nimble/encodings/TrivialEncoding.h"
 
 // A nullable encoding holds a subencoding of non-null values and another
 // subencoding of booleans representing whether each row was null.
@@ -54,12 +56,13 @@ class NullableEncoding final
   const Encoding* nonNulls() const;
 
   void reset() final;
+  bool reinitialize(std::string_view data) final;
   void skip(uint32_t rowCount) final;
   void materialize(uint32_t rowCount, void* buffer) final;
   uint32_t materializeNullable(
       uint32_t rowCount,
       void* buffer,
-      std::function<void*()> nulls,
+      folly::FunctionRef<void*()> nulls,
       const bits::Bitmap* scatterBitmap = nullptr,
       uint32_t offset = 0) final;
 
@@ -75,10 +78,18 @@ class NullableEncoding final
   std::string debugString(int offset) const final;
 
  private:
+  void initialize(std::string_view data);
+
+  // Reads the nulls of the next |rowCount| rows, and returns
+  // |f(nonNullCount, isNonNull)|, where isNonNull(i) tells whether the ith row
+  // is non-null. Trivially encoded nulls are read in place from their bitmap.
+  template <typename F>
+  auto withNulls(uint32_t rowCount, F&& f);
+
   // One bit for each row. A true bit represents a row with a non-null value.
   const char* bitmap_;
-  std::unique_ptr<Encoding> nonNullValues_;
-  std::unique_ptr<Encoding> nulls_;
+  NestedEncoding<T> nonNullValues_;
+  NestedEncoding<bool> nulls_;
   uint32_t row_ = 0;
 
   // Temporary buffers.
@@ -99,13 +110,20 @@ NullableEncoding<T>::NullableEncoding(
       indicesBuffer_(&memoryPool),
       charBuffer_(&memoryPool),
       boolBuffer_(&memoryPool) {
+  initialize(data);
+}
+
+template <typename T>
+void NullableEncoding<T>::initialize(std::string_view data) {
   const char* pos = data.data() + Encoding::kPrefixSize;
   const uint32_t nonNullsBytes = encoding::readUint32(pos);
-  nonNullValues_ =
-      EncodingFactory::decode(this->memoryPool_, {pos, nonNullsBytes});
+  nonNullValues_ = EncodingFactory::decode(
+      this->memoryPool_, {pos, nonNullsBytes}, nonNullValues_.release());
   pos += nonNullsBytes;
   nulls_ = EncodingFactory::decode(
-      this->memoryPool_, {pos, static_cast<size_t>(data.end() - pos)});
+      this->memoryPool_,
+      {pos, static_cast<size_t>(data.end() - pos)},
+      nulls_.release());
   NIMBLE_DASSERT(
       Encoding::rowCount() == nulls_->rowCount(), "Nulls count mismatch.");
 }
@@ -133,35 +151,61 @@ void NullableEncoding<T>::reset() {
 }
 
 template <typename T>
-void NullableEncoding<T>::skip(uint32_t rowCount) {
-  // Hrm this isn't ideal. We should return to this later -- a new
-  // encoding func? Encoding::Accumulate to add up next N rows?
-  boolBuffer_.resize(rowCount);
-  nulls_->materialize(rowCount, boolBuffer_.data());
-  const uint32_t nonNullCount =
-      std::accumulate(boolBuffer_.begin(), boolBuffer_.end(), 0U);
-  nonNullValues_->skip(nonNullCount);
+bool NullableEncoding<T>::reinitialize(std::string_view data) {
+  this->reinitializePrefix(data);
+  initialize(data);
+  row_ = 0;
+  return true;
 }
 
 template <typename T>
-void NullableEncoding<T>::materialize(uint32_t rowCount, void* buffer) {
+template <typename F>
+auto NullableEncoding<T>::withNulls(uint32_t rowCount, F&& f) {
+  if (nulls_.kind() == NestedEncodingKind::Trivial) {
+    auto& nulls = nulls_.template as<TrivialEncoding<bool>>();
+    const char* bitmap = nulls.bitmap();
+    const uint32_t begin = nulls.row();
+    nulls.skip(rowCount);
+    return f(
+        bits::countSetBits(begin, rowCount, bitmap),
+        [bitmap, begin](uint32_t i) {
+          return bits::getBit(begin + i, bitmap);
+        });
+  }
+
   // This too isn't ideal. We will want an Encoding::Indices method or
   // something our SparseBool can use, giving back just the set indices
   // rather than a materialization.
   boolBuffer_.resize(rowCount);
-  nulls_->materialize(rowCount, boolBuffer_.data());
+  nulls_.materialize(rowCount, boolBuffer_.data());
   const uint32_t nonNullCount =
       std::accumulate(boolBuffer_.begin(), boolBuffer_.end(), 0U);
-  nonNullValues_->materialize(nonNullCount, buffer);
+  const bool* nonNulls = boolBuffer_.data();
+  return f(nonNullCount, [nonNulls](uint32_t i) { return nonNulls[i]; });
+}
+
+template <typename T>
+void NullableEncoding<T>::skip(uint32_t rowCount) {
+  withNulls(rowCount, [&](uint32_t nonNullCount, auto /* isNonNull */) {
+    nonNullValues_.skip(nonNullCount);
+  });
+}
+
+template <typename T>
+void NullableEncoding<T>::materialize(uint32_t rowCount, void* buffer) {
+  withNulls(rowCount, [&](uint32_t nonNullCount, auto isNonNull) {
+    nonNullValues_.materialize(nonNullCount, buffer);
+    if (nonNullCount == rowCount) {
+      return;
+    }
 
-  if (nonNullCount != rowCount) {
     physicalType* output = static_cast<physicalType*>(buffer) + rowCount - 1;
     const physicalType* lastNonNull =
         static_cast<physicalType*>(buffer) + nonNullCount - 1;
     // This is a generic scatter -- should we have a common scatter func?
     uint32_t pos = rowCount - 1;
     while (output != lastNonNull) {
-      if (boolBuffer_[pos]) {
+      if (isNonNull(pos)) {
         *output = *lastNonNull;
         --lastNonNull;
       } else {
@@ -170,7 +214,7 @@ void NullableEncoding<T>::materialize(uint32_t rowCount, void* buffer) {
       --output;
       --pos;
     }
-  }
+  });
 
   row_ += rowCount;
 }
@@ -179,62 +223,66 @@ template <typename T>
 uint32_t NullableEncoding<T>::materializeNullable(
     uint32_t rowCount,
     void* buffer,
-    std::function<void*()> nulls,
+    folly::FunctionRef<void*()> nulls,
     const bits::Bitmap* scatterBitmap,
     uint32_t offset) {
-  boolBuffer_.resize(rowCount);
-  nulls_->materialize(rowCount, boolBuffer_.data());
-  const uint32_t nonNullCount =
-      std::accumulate(boolBuffer_.begin(), boolBuffer_.end(), 0U);
-
   if (offset > 0) {
     buffer = static_cast<physicalType*>(buffer) + offset;
   }
-  nonNullValues_->materialize(nonNullCount, buffer);
 
-  auto scatterSize = scatterBitmap ? scatterBitmap->size() - offset : rowCount;
-  if (nonNullCount != scatterSize) {
-    void* nullBitmap = nulls();
-    bits::BitmapBuilder nullBits{nullBitmap, offset + scatterSize};
-    nullBits.clear(offset, offset + scatterSize);
+  const uint32_t nonNullCount = withNulls(
+      rowCount, [&](uint32_t nonNullCount, auto isNonNull) -> uint32_t {
+        nonNullValues_.materialize(nonNullCount, buffer);
 
-    uint32_t pos = offset + scatterSize - 1;
-    physicalType* output = static_cast<physicalType*>(buffer) + scatterSize - 1;
-    const physicalType* lastNonNull =
-        static_cast<physicalType*>(buffer) + nonNullCount - 1;
-    auto nonNullIt = boolBuffer_.begin() + rowCount - 1;
-
-    if (scatterSize != rowCount) {
-      // In scattered reads, spread the items into the right positions in
-      // |buffer| and |nullBitmap| based on the bits set to 1 in
-      // |scatterBitmap|.
-      while (output != lastNonNull) {
-        if (scatterBitmap->test(pos)) {
-          if (*nonNullIt--) {
-            nullBits.set(pos);
-            *output = *lastNonNull;
-            --lastNonNull;
-          }
+        auto scatterSize =
+            scatterBitmap ? scatterBitmap->size() - offset : rowCount;
+        if (nonNullCount == scatterSize) {
+          return nonNullCount;
         }
-        --output;
-        --pos;
-      }
-    } else {
-      while (output != lastNonNull) {
-        if (*nonNullIt--) {
-          nullBits.set(pos);
-          *output = *lastNonNull;
-          --lastNonNull;
+
+        void* nullBitmap = nulls();
+        bits::BitmapBuilder nullBits{nullBitmap, offset + scatterSize};
+        nullBits.clear(offset, offset + scatterSize);
+
+        uint32_t pos = offset + scatterSize - 1;
+        physicalType* output =
+            static_cast<physicalType*>(buffer) + scatterSize - 1;
+        const physicalType* lastNonNull =
+            static_cast<physicalType*>(buffer) + nonNullCount - 1;
+        uint32_t row = rowCount - 1;
+
+        if (scatterSize != rowCount) {
+          // In scattered reads, spread the items into the right positions in
+          // |buffer| and |nullBitmap| based on the bits set to 1 in
+          // |scatterBitmap|.
+          while (output != lastNonNull) {
+            if (scatterBitmap->test(pos)) {
+              if (isNonNull(row--)) {
+                nullBits.set(pos);
+                *output = *lastNonNull;
+                --lastNonNull;
+              }
+            }
+            --output;
+            --pos;
+          }
+        } else {
+          while (output != lastNonNull) {
+            if (isNonNull(row--)) {
+              nullBits.set(pos);
+              *output = *lastNonNull;
+              --lastNonNull;
+            }
+            --output;
+            --pos;
+          }
         }
-        --output;
-        --pos;
-      }
-    }
 
-    if (output >= buffer) {
-      nullBits.set(offset, pos + 1);
-    }
-  }
+        if (output >= buffer) {
+          nullBits.set(offset, pos + 1);
+        }
+        return nonNullCount;
+      });
 
   row_ += rowCount;
   return nonNullCount;
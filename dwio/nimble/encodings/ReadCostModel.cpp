@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dwio/nimble/encodings/ReadCostModel.h"
+#include "dwio/nimble/common/Exceptions.h"
+#include "folly/Conv.h"
+#include "folly/String.h"
+
+namespace facebook::nimble {
+
+namespace {
+
+constexpr int32_t kMaxEncodingType =
+    static_cast<int32_t>(EncodingType::StreamVByte);
+constexpr int32_t kMaxDataType = static_cast<int32_t>(DataType::String);
+
+EncodingType parseEncodingType(std::string_view value) {
+  for (auto i = 0; i <= kMaxEncodingType; ++i) {
+    const auto encodingType = static_cast<EncodingType>(i);
+    if (value == toString(encodingType)) {
+      return encodingType;
+    }
+  }
+  NIMBLE_NOT_SUPPORTED(
+      fmt::format("Unknown encoding type '{}' in read cost model.", value));
+}
+
+DataType parseDataType(std::string_view value) {
+  for (auto i = 1; i <= kMaxDataType; ++i) {
+    const auto dataType = static_cast<DataType>(i);
+    if (value == toString(dataType)) {
+      return dataType;
+    }
+  }
+  NIMBLE_NOT_SUPPORTED(
+      fmt::format("Unknown data type '{}' in read cost model.", value));
+}
+
+} // namespace
+
+void ReadCostModel::setCost(
+    EncodingType encodingType,
+    DataType dataType,
+    uint32_t bitWidth,
+    float nanosPerValue) {
+  costs_[{encodingType, dataType, bitWidth}] = nanosPerValue;
+}
+
+std::optional<float> ReadCostModel::cost(
+    EncodingType encodingType,
+    DataType dataType,
+    uint32_t bitWidth) const {
+  auto it = costs_.lower_bound({encodingType, dataType, bitWidth});
+  if (it != costs_.end() && std::get<0>(it->first) == encodingType &&
+      std::get<1>(it->first) == dataType) {
+    return it->second;
+  }
+  if (it == costs_.begin()) {
+    return std::nullopt;
+  }
+  --it;
+  if (std::get<0>(it->first) == encodingType &&
+      std::get<1>(it->first) == dataType) {
+    return it->second;
+  }
+  return std::nullopt;
+}
+
+std::string ReadCostModel::serialize() const {
+  std::string result;
+  for (const auto& [key, nanosPerValue] : costs_) {
+    if (!result.empty()) {
+      result += ';';
+    }
+    result += fmt::format(
+        "{}:{}:{}={}",
+        toString(std::get<0>(key)),
+        toString(std::get<1>(key)),
+        std::get<2>(key),
+        nanosPerValue);
+  }
+  return result;
+}
+
+/* static */ ReadCostModel ReadCostModel::parse(std::string_view model) {
+  ReadCostModel result;
+  std::vector<std::string> entries;
+  folly::split(';', folly::trimWhitespace(model), entries);
+  for (const auto& entry : entries) {
+    if (folly::trimWhitespace(entry).empty()) {
+      continue;
+    }
+    std::vector<std::string> kv;
+    folly::split('=', entry, kv);
+    std::vector<std::string> key;
+    if (kv.size() == 2) {
+      folly::split(':', folly::trimWhitespace(kv[0]), key);
+    }
+    NIMBLE_CHECK(
+        key.size() == 3,
+        fmt::format(
+            "Invalid read cost format. Expected format is "
+            "<EncodingType>:<DataType>:<BitWidth>=<NanosPerValue>. "
+            "Unable to parse '{}'.",
+            entry));
+    auto bitWidth = folly::tryTo<uint32_t>(key[2]);
+    auto nanosPerValue = folly::tryTo<float>(folly::trimWhitespace(kv[1]));
+    NIMBLE_CHECK(
+        bitWidth.hasValue() && nanosPerValue.hasValue(),
+        fmt::format("Unable to parse read cost entry '{}'.", entry));
+    result.setCost(
+        parseEncodingType(key[0]),
+        parseDataType(key[1]),
+        bitWidth.value(),
+        nanosPerValue.value());
+  }
+  return result;
+}
+
+} // namespace facebook::nimble
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+#include "dwio/nimble/common/Types.h"
+
+// The read cost model holds measured decode costs of encodings. It allows
+// encoding selection to take read CPU into account, and not only the encoded
+// size. Costs depend on the hardware, so the model is produced by running the
+// read cost calibration tool (dwio/nimble/tools/ReadCostCalibrator.cpp) on the
+// target machine, and is then loaded by the writer.
+
+namespace facebook::nimble {
+
+class ReadCostModel {
+ public:
+  // Sets the decode cost (in nanoseconds per value) of an encoding, for a
+  // data type and bit width. Bit width is the number of bits required to
+  // represent the range of the (numeric) values. For non-numeric data types,
+  // bit width should be zero.
+  void setCost(
+      EncodingType encodingType,
+      DataType dataType,
+      uint32_t bitWidth,
+      float nanosPerValue);
+
+  // Returns the decode cost (in nanoseconds per value). If there is no
+  // measurement for the exact bit width, the closest wider measurement is
+  // used (or the widest measurement, if none is wider). Returns std::nullopt
+  // if the encoding was never measured for this data type.
+  std::optional<float> cost(
+      EncodingType encodingType,
+      DataType dataType,
+      uint32_t bitWidth) const;
+
+  bool empty() const {
+    return costs_.empty();
+  }
+
+  // The serialized format is a ';' separated list of
+  // <EncodingType>:<DataType>:<BitWidth>=<NanosPerValue> entries.
+  std::string serialize() const;
+  static ReadCostModel parse(std::string_view model);
+
+ private:
+  std::map<std::tuple<EncodingType, DataType, uint32_t>, float> costs_;
+};
+
+} // namespace facebook::nimble
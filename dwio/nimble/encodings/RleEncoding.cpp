@@ -21,6 +21,10 @@ RLEEncoding<bool>::RLEEncoding(
     velox::memory::MemoryPool& memoryPool,
     std::string_view data)
     : internal::RLEEncodingBase<bool, RLEEncoding<bool>>(memoryPool, data) {
+  initialize(data);
+}
+
+void RLEEncoding<bool>::initialize(std::string_view data) {
   initialValue_ = *reinterpret_cast<const bool*>(
       internal::RLEEncodingBase<bool, RLEEncoding<bool>>::getValuesStart());
   NIMBLE_CHECK(
@@ -30,6 +34,12 @@ RLEEncoding<bool>::RLEEncoding(
   internal::RLEEncodingBase<bool, RLEEncoding<bool>>::reset();
 }
 
+bool RLEEncoding<bool>::reinitialize(std::string_view data) {
+  reinitializeRunLengths(data);
+  initialize(data);
+  return true;
+}
+
 bool RLEEncoding<bool>::nextValue() {
   value_ = !value_;
   return !value_;
@@ -57,11 +57,8 @@ class RLEEncodingBase
 
   RLEEncodingBase(velox::memory::MemoryPool& memoryPool, std::string_view data)
       : TypedEncoding<T, physicalType>(memoryPool, data),
-        materializedRunLengths_{EncodingFactory::decode(
-            memoryPool,
-            {data.data() + Encoding::kPrefixSize + 4,
-             *reinterpret_cast<const uint32_t*>(
-                 data.data() + Encoding::kPrefixSize)})} {}
+        materializedRunLengths_{
+            EncodingFactory::decode(memoryPool, runLengths(data))} {}
 
   void reset() {
     materializedRunLengths_.reset();
@@ -148,6 +145,24 @@ class RLEEncodingBase
     return {reserved, encodingSize};
   }
 
+  static std::string_view runLengths(std::string_view data) {
+    return {
+        data.data() + Encoding::kPrefixSize + 4,
+        *reinterpret_cast<const uint32_t*>(
+            data.data() + Encoding::kPrefixSize)};
+  }
+
+  // Re-initializes the prefix and the run lengths on |data|. Derived classes
+  // then re-initialize their run values and reset().
+  void reinitializeRunLengths(std::string_view data) {
+    this->reinitializePrefix(data);
+    materializedRunLengths_ =
+        detail::BufferedEncoding<uint32_t, 32>{EncodingFactory::decode(
+            this->memoryPool_,
+            runLengths(data),
+            materializedRunLengths_.releaseEncoding())};
+  }
+
   const char* getValuesStart() const {
     return this->data_.data() + Encoding::kPrefixSize + 4 +
         *reinterpret_cast<const uint32_t*>(
@@ -189,6 +204,7 @@ class RLEEncoding final : public internal::RLEEncodingBase<T, RLEEncoding<T>> {
 
   physicalType nextValue();
   void resetValues();
+  bool reinitialize(std::string_view data) final;
   static std::string_view getSerializedRunValues(
       EncodingSelection<physicalType>& selection,
       const Vector<physicalType>& runValues,
@@ -232,6 +248,7 @@ class RLEEncoding<bool> final
 
   bool nextValue();
   void resetValues();
+  bool reinitialize(std::string_view data) final;
   static std::string_view getSerializedRunValues(
       EncodingSelection<bool>& /* selection */,
       const Vector<bool>& runValues,
@@ -245,6 +262,8 @@ class RLEEncoding<bool> final
       final;
 
  private:
+  void initialize(std::string_view data);
+
   bool initialValue_;
   bool value_;
 };
@@ -278,6 +297,19 @@ void RLEEncoding<T>::resetValues() {
   values_.reset();
 }
 
+template <typename T>
+bool RLEEncoding<T>::reinitialize(std::string_view data) {
+  internal::RLEEncodingBase<T, RLEEncoding<T>>::reinitializeRunLengths(data);
+  const char* valuesStart =
+      internal::RLEEncodingBase<T, RLEEncoding<T>>::getValuesStart();
+  values_ = detail::BufferedEncoding<physicalType, 32>{EncodingFactory::decode(
+      this->memoryPool_,
+      {valuesStart, static_cast<size_t>(data.end() - valuesStart)},
+      values_.releaseEncoding())};
+  internal::RLEEncodingBase<T, RLEEncoding<T>>::reset();
+  return true;
+}
+
 template <typename T>
 template <bool kDense>
 vector_size_t RLEEncoding<T>::findNumInRun(
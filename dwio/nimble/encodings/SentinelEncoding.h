@@ -61,7 +61,7 @@ class SentinelEncoding final
   uint32_t materializeNullable(
       uint32_t rowCount,
       void* buffer,
-      std::function<void*()> nulls,
+      folly::FunctionRef<void*()> nulls,
       const bits::Bitmap* scatterBitmap = nullptr,
       uint32_t offset = 0) final;
 
@@ -156,7 +156,7 @@ template <typename T>
 uint32_t SentinelEncoding<T>::materializeNullable(
     uint32_t rowCount,
     void* buffer,
-    std::function<void*()> nulls,
+    folly::FunctionRef<void*()> nulls,
     const bits::Bitmap* scatterBitmap,
     uint32_t offset) {
   if (offset > 0) {
@@ -43,6 +43,17 @@ void SparseBoolEncoding::reset() {
   nextIndex_ = indices_.nextValue();
 }
 
+bool SparseBoolEncoding::reinitialize(std::string_view data) {
+  reinitializePrefix(data);
+  sparseValue_ = static_cast<bool>(data[kSparseValueOffset]);
+  indices_ = detail::BufferedEncoding<uint32_t, 32>{EncodingFactory::decode(
+      memoryPool_,
+      {data.data() + kIndicesOffset, data.size() - kIndicesOffset},
+      indices_.releaseEncoding())};
+  reset();
+  return true;
+}
+
 void SparseBoolEncoding::skip(uint32_t rowCount) {
   const uint32_t end = row_ + rowCount;
   while (nextIndex_ < end) {
@@ -56,6 +56,7 @@ class SparseBoolEncoding final : public TypedEncoding<bool, bool> {
       std::string_view data);
 
   void reset() final;
+  bool reinitialize(std::string_view data) final;
   void skip(uint32_t rowCount) final;
   void materialize(uint32_t rowCount, void* buffer) final;
 
@@ -73,7 +74,7 @@ class SparseBoolEncoding final : public TypedEncoding<bool, bool> {
  private:
   // If true, then indices give the position of the set bits; if false they give
   // the positions of the unset bits.
-  const bool sparseValue_;
+  bool sparseValue_;
   Vector<char> indicesUncompressed_;
   detail::BufferedEncoding<uint32_t, 32> indices_;
   uint32_t nextIndex_; // The current index (FBA value).
@@ -14,13 +14,19 @@
  * limitations under the License.
  */
 #include "dwio/nimble/encodings/Statistics.h"
+#include "dwio/nimble/common/CpuFeatures.h"
 #include "dwio/nimble/common/Types.h"
 
 #include <algorithm>
+#include <bit>
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <type_traits>
 
+#include "folly/Portability.h"
+#include "folly/hash/Hash.h"
+
 namespace facebook::nimble {
 
 namespace {
@@ -28,10 +34,184 @@ namespace {
 template <typename T, typename InputType>
 using MapType = typename UniqueValueCounts<T, InputType>::MapType;
 
+// Number of values the fused numeric statistics kernel inspects per block.
+constexpr size_t kStatisticsBlockSize = 64;
+
+template <typename T>
+struct NumericStatistics {
+  T min;
+  T max;
+  uint64_t consecutiveRepeatCount;
+  uint64_t minRepeat;
+  uint64_t maxRepeat;
+};
+
+// Computes min, max and run statistics in a single pass over |data|.
+// Data is processed in fixed size blocks. Within a block, min, max and the
+// number of value transitions are computed using branch free loops, which the
+// compiler vectorizes. Only blocks which contain both repeats and transitions
+// need to be walked value by value to track run lengths. Blocks that are fully
+// repeating (extending the current run) or fully unique (all runs of length 1)
+// are handled in constant time.
+// |data| must not be empty.
+template <typename T>
+FOLLY_ALWAYS_INLINE NumericStatistics<T> computeNumericStatistics(
+    const T* data,
+    uint64_t size) {
+  T min = data[0];
+  T max = data[0];
+  uint64_t runCount = 1;
+  uint64_t minRepeat = std::numeric_limits<uint64_t>::max();
+  uint64_t maxRepeat = 0;
+  uint64_t currentRepeat = 1;
+
+  auto closeRun = [&](uint64_t repeat) {
+    minRepeat = std::min(minRepeat, repeat);
+    maxRepeat = std::max(maxRepeat, repeat);
+  };
+
+  auto walk = [&](const T* values, uint64_t count) {
+    const T* previous = values - 1;
+    for (uint64_t j = 0; j < count; ++j) {
+      if (values[j] != previous[j]) {
+        closeRun(currentRepeat);
+        currentRepeat = 1;
+        ++runCount;
+      } else {
+        ++currentRepeat;
+      }
+    }
+  };
+
+  // First value is already accounted for, so each block compares against its
+  // preceding value, which is always valid.
+  uint64_t i = 1;
+  for (; i + kStatisticsBlockSize <= size; i += kStatisticsBlockSize) {
+    const T* block = data + i;
+    const T* previous = block - 1;
+    T blockMin = block[0];
+    T blockMax = block[0];
+    uint32_t transitions = 0;
+    for (uint32_t j = 0; j < kStatisticsBlockSize; ++j) {
+      blockMin = std::min(blockMin, block[j]);
+      blockMax = std::max(blockMax, block[j]);
+      transitions += static_cast<uint32_t>(block[j] != previous[j]);
+    }
+    min = std::min(min, blockMin);
+    max = std::max(max, blockMax);
+
+    if (transitions == 0) {
+      currentRepeat += kStatisticsBlockSize;
+    } else if (transitions == kStatisticsBlockSize) {
+      // Every value starts a new run. The run preceding the block is closed,
+      // all runs inside the block (except the last one, which is still open)
+      // have a length of one.
+      closeRun(currentRepeat);
+      closeRun(1);
+      runCount += kStatisticsBlockSize;
+      currentRepeat = 1;
+    } else {
+      walk(block, kStatisticsBlockSize);
+    }
+  }
+
+  for (uint64_t j = i; j < size; ++j) {
+    min = std::min(min, data[j]);
+    max = std::max(max, data[j]);
+  }
+  walk(data + i, size - i);
+  closeRun(currentRepeat);
+
+  return {
+      .min = min,
+      .max = max,
+      .consecutiveRepeatCount = runCount,
+      .minRepeat = minRepeat,
+      .maxRepeat = maxRepeat,
+  };
+}
+
+// HyperLogLog precision (log2 of the register count). 4096 registers yield a
+// standard error of ~1.6%.
+constexpr uint32_t kHyperLogLogPrecision = 12;
+constexpr uint32_t kHyperLogLogRegisterCount = 1 << kHyperLogLogPrecision;
+constexpr uint32_t kHyperLogLogMaxRank = 64 - kHyperLogLogPrecision + 1;
+
+// Number of counters kept by the heavy hitters sketch. Any value occurring in
+// more than 1/(kHeavyHittersCapacity + 1) of the entries is guaranteed to be
+// tracked.
+constexpr uint32_t kHeavyHittersCapacity = 32;
+
+uint64_t estimateCardinality(
+    const std::array<uint8_t, kHyperLogLogRegisterCount>& registers) {
+  constexpr double m = kHyperLogLogRegisterCount;
+  constexpr double alpha = 0.7213 / (1.0 + 1.079 / m);
+  double sum = 0;
+  uint32_t zeroRegisters = 0;
+  for (auto rank : registers) {
+    sum += std::ldexp(1.0, -rank);
+    zeroRegisters += (rank == 0);
+  }
+  double estimate = alpha * m * m / sum;
+  if (estimate <= 2.5 * m && zeroRegisters > 0) {
+    // Small range correction (linear counting).
+    estimate = m * std::log(m / zeroRegisters);
+  }
+  return std::llround(estimate);
+}
+
+#ifdef __x86_64__
+template <typename T>
+__attribute__((__target__("avx2"))) NumericStatistics<T>
+computeNumericStatisticsAvx2(const T* data, uint64_t size) {
+  return computeNumericStatistics(data, size);
+}
+#endif // __x86_64__
+
+template <typename T>
+NumericStatistics<T> computeNumericStatisticsScalar(
+    const T* data,
+    uint64_t size) {
+  return computeNumericStatistics(data, size);
+}
+
+template <typename T>
+using ComputeNumericStatistics = NumericStatistics<T> (*)(const T*, uint64_t);
+
+template <typename T>
+const cpu::Kernel<ComputeNumericStatistics<T>> numericStatisticsKernel{
+    "statistics::computeNumericStatistics",
+    {
+#ifdef __x86_64__
+        {"avx2", cpu::Feature::Avx2, computeNumericStatisticsAvx2<T>},
+#endif // __x86_64__
+        {"scalar", cpu::Feature::None, computeNumericStatisticsScalar<T>},
+    }};
+
 } // namespace
 
+template <typename T, typename InputType>
+void Statistics<T, InputType>::populateNumericStatistics() const {
+  static_assert(nimble::isIntegralType<T>());
+  const auto statistics =
+      numericStatisticsKernel<T>(data_.data(), data_.size());
+  min_ = statistics.min;
+  max_ = statistics.max;
+  consecutiveRepeatCount_ = statistics.consecutiveRepeatCount;
+  minRepeat_ = statistics.minRepeat;
+  maxRepeat_ = statistics.maxRepeat;
+  totalStringsRepeatLength_ = 0;
+}
+
 template <typename T, typename InputType>
 void Statistics<T, InputType>::populateRepeats() const {
+  if constexpr (nimble::isIntegralType<T>()) {
+    // Repeats are computed together with min/max, as most encodings consuming
+    // one also consume the other.
+    populateNumericStatistics();
+    return;
+  }
+
   uint64_t consecutiveRepeatCount = 0;
   uint64_t minRepeat = std::numeric_limits<uint64_t>::max();
   uint64_t maxRepeat = 0;
@@ -84,7 +264,9 @@ void Statistics<T, InputType>::populateRepeats() const {
 
 template <typename T, typename InputType>
 void Statistics<T, InputType>::populateMinMax() const {
-  if constexpr (nimble::isNumericType<InputType>()) {
+  if constexpr (nimble::isIntegralType<InputType>()) {
+    populateNumericStatistics();
+  } else if constexpr (nimble::isNumericType<InputType>()) {
     const auto [min, max] = std::minmax_element(data_.begin(), data_.end());
     min_ = *min;
     max_ = *max;
@@ -131,6 +313,71 @@ void Statistics<T, InputType>::populateUniques() const {
   uniqueCounts_.emplace(std::move(uniqueCounts));
 }
 
+template <typename T, typename InputType>
+void Statistics<T, InputType>::populateApproximateUniques() const {
+  static_assert(!nimble::isBoolType<T>());
+  std::array<uint8_t, kHyperLogLogRegisterCount> registers{};
+  absl::flat_hash_map<T, uint64_t> heavyHitters;
+  heavyHitters.reserve(kHeavyHittersCapacity + 1);
+
+  absl::Hash<T> hasher;
+  for (auto i = 0; i < data_.size(); ++i) {
+    const T value = data_[i];
+
+    // HyperLogLog: top bits select the register, the register keeps the max
+    // rank (position of the first set bit) seen in the remaining bits. When
+    // all remaining bits are zero, the rank is capped at their count plus one.
+    const uint64_t hash = folly::hash::twang_mix64(hasher(value));
+    const uint32_t index = hash >> (64 - kHyperLogLogPrecision);
+    const uint8_t rank = std::min<uint32_t>(
+        std::countl_zero((hash << kHyperLogLogPrecision) | 1ULL) + 1,
+        kHyperLogLogMaxRank);
+    registers[index] = std::max(registers[index], rank);
+
+    // Misra-Gries: when all counters are taken by other values, decrement all
+    // counters (and evict the ones reaching zero) instead of inserting.
+    auto it = heavyHitters.find(value);
+    if (it != heavyHitters.end()) {
+      ++it->second;
+    } else if (heavyHitters.size() < kHeavyHittersCapacity) {
+      heavyHitters.emplace(value, 1);
+    } else {
+      for (auto counter = heavyHitters.begin();
+           counter != heavyHitters.end();) {
+        if (--counter->second == 0) {
+          heavyHitters.erase(counter++);
+        } else {
+          ++counter;
+        }
+      }
+    }
+  }
+
+  // Misra-Gries counts are lower bounds. Since we only care about the single
+  // most common value, we take the top candidate and count it exactly.
+  T mostCommonValue = data_[0];
+  uint64_t candidateCount = 0;
+  for (const auto& [value, count] : heavyHitters) {
+    if (count > candidateCount) {
+      candidateCount = count;
+      mostCommonValue = value;
+    }
+  }
+  uint64_t mostCommonCount = 0;
+  for (auto i = 0; i < data_.size(); ++i) {
+    mostCommonCount += (data_[i] == mostCommonValue);
+  }
+
+  // The sketch estimate may slightly exceed the number of entries, or
+  // (for tiny streams) undercount the known distinct values.
+  const uint64_t uniqueCount = std::clamp<uint64_t>(
+      estimateCardinality(registers),
+      mostCommonCount == data_.size() ? 1 : 2,
+      data_.size() - mostCommonCount + 1);
+  approximateUniqueCounts_.emplace(
+      uniqueCount, mostCommonValue, mostCommonCount);
+}
+
 template <typename T, typename InputType>
 void Statistics<T, InputType>::populateBucketCounts() const {
   using UnsignedT = typename std::make_unsigned<T>::type;
@@ -192,6 +439,7 @@ Statistics<T, InputType> Statistics<T, InputType>::create(
 
     statistics.bucketCounts_ = {};
     statistics.uniqueCounts_ = {};
+    statistics.approximateUniqueCounts_.emplace();
     return statistics;
   }
 
@@ -242,6 +490,16 @@ template void Statistics<std::string_view>::populateRepeats() const;
 template void Statistics<std::string_view, std::string>::populateRepeats()
     const;
 
+// populateNumericStatistics works on integral types only
+template void Statistics<int8_t>::populateNumericStatistics() const;
+template void Statistics<uint8_t>::populateNumericStatistics() const;
+template void Statistics<int16_t>::populateNumericStatistics() const;
+template void Statistics<uint16_t>::populateNumericStatistics() const;
+template void Statistics<int32_t>::populateNumericStatistics() const;
+template void Statistics<uint32_t>::populateNumericStatistics() const;
+template void Statistics<int64_t>::populateNumericStatistics() const;
+template void Statistics<uint64_t>::populateNumericStatistics() const;
+
 // populateUniques works on all types
 template void Statistics<int8_t>::populateUniques() const;
 template void Statistics<uint8_t>::populateUniques() const;
@@ -258,6 +516,21 @@ template void Statistics<std::string_view>::populateUniques() const;
 template void Statistics<std::string_view, std::string>::populateUniques()
     const;
 
+// populateApproximateUniques works on all non-bool types
+template void Statistics<int8_t>::populateApproximateUniques() const;
+template void Statistics<uint8_t>::populateApproximateUniques() const;
+template void Statistics<int16_t>::populateApproximateUniques() const;
+template void Statistics<uint16_t>::populateApproximateUniques() const;
+template void Statistics<int32_t>::populateApproximateUniques() const;
+template void Statistics<uint32_t>::populateApproximateUniques() const;
+template void Statistics<int64_t>::populateApproximateUniques() const;
+template void Statistics<uint64_t>::populateApproximateUniques() const;
+template void Statistics<float>::populateApproximateUniques() const;
+template void Statistics<double>::populateApproximateUniques() const;
+template void Statistics<std::string_view>::populateApproximateUniques() const;
+template void
+Statistics<std::string_view, std::string>::populateApproximateUniques() const;
+
 // populateMinMax works on numeric types only
 template void Statistics<int8_t>::populateMinMax() const;
 template void Statistics<uint8_t>::populateMinMax() const;
@@ -111,6 +111,44 @@ class UniqueValueCounts {
   MapType uniqueCounts_;
 };
 
+// Approximate unique value statistics, computed using bounded memory.
+// The number of distinct values is estimated using a HyperLogLog sketch, and
+// the most common value is tracked using a bounded heavy hitters
+// (Misra-Gries) sketch. The occurrence count of the most common value is
+// exact.
+// These are meant to be used on large, high cardinality streams, where
+// building an exact map of all unique values is both slow and memory hungry.
+template <typename T>
+class ApproximateUniqueCounts {
+ public:
+  ApproximateUniqueCounts() = default;
+  ApproximateUniqueCounts(
+      uint64_t uniqueCount,
+      T mostCommonValue,
+      uint64_t mostCommonCount)
+      : uniqueCount_{uniqueCount},
+        mostCommonValue_{mostCommonValue},
+        mostCommonCount_{mostCommonCount} {}
+
+  // Estimated number of distinct values.
+  uint64_t size() const noexcept {
+    return uniqueCount_;
+  }
+
+  const T& mostCommonValue() const noexcept {
+    return mostCommonValue_;
+  }
+
+  uint64_t mostCommonCount() const noexcept {
+    return mostCommonCount_;
+  }
+
+ private:
+  uint64_t uniqueCount_{0};
+  T mostCommonValue_{};
+  uint64_t mostCommonCount_{0};
+};
+
 template <typename T, typename InputType = T>
 class Statistics {
  public:
@@ -186,12 +224,25 @@ class Statistics {
     return uniqueCounts_.value();
   }
 
+  // Sketch based alternative to uniqueCounts(). See ApproximateUniqueCounts.
+  const ApproximateUniqueCounts<T>& approximateUniqueCounts() const noexcept {
+    static_assert(!nimble::isBoolType<T>());
+    if (!approximateUniqueCounts_.has_value()) {
+      populateApproximateUniques();
+    }
+    return approximateUniqueCounts_.value();
+  }
+
  private:
   Statistics() = default;
   std::span<const InputType> data_;
 
   void populateRepeats() const;
+  // Computes min, max and all repeat statistics in a single (vectorized) pass.
+  // Only applicable to integral types.
+  void populateNumericStatistics() const;
   void populateUniques() const;
+  void populateApproximateUniques() const;
   void populateMinMax() const;
   void populateBucketCounts() const;
   void populateStringLength() const;
@@ -205,6 +256,7 @@ class Statistics {
   mutable std::optional<T> max_;
   mutable std::optional<std::vector<uint64_t>> bucketCounts_;
   mutable std::optional<UniqueValueCounts<T, InputType>> uniqueCounts_;
+  mutable std::optional<ApproximateUniqueCounts<T>> approximateUniqueCounts_;
 };
 
 } // namespace facebook::nimble
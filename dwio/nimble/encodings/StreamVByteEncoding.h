@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <span>
+#include "dwio/nimble/common/Buffer.h"
+#include "dwio/nimble/common/EncodingPrimitives.h"
+#include "dwio/nimble/common/EncodingType.h"
+#include "dwio/nimble/common/Exceptions.h"
+#include "dwio/nimble/common/StreamVByte.h"
+#include "dwio/nimble/common/Types.h"
+#include "dwio/nimble/encodings/Encoding.h"
+#include "dwio/nimble/encodings/EncodingSelection.h"
+#include "dwio/nimble/encodings/Statistics.h"
+
+// Stores 32 bit integer data using Stream VByte encoding (see
+// dwio/nimble/common/StreamVByte.h). Values are stored relative to the minimum
+// value, so (like Varint encoding) small ranges produce short values. Compared
+// to Varint encoding, value lengths are stored separately from the data, which
+// allows decoding 4 (or 8) values at a time using SIMD shuffles.
+
+namespace facebook::nimble {
+
+// Data layout is:
+// Encoding::kPrefixSize bytes: standard Encoding prefix
+// sizeof(T) bytes: baseline value
+// (rowCount + 3) / 4 bytes: control bytes (2 bit length code per value)
+// X bytes: the value bytes
+template <typename T>
+class StreamVByteEncoding final
+    : public TypedEncoding<T, typename TypeTraits<T>::physicalType> {
+ public:
+  using cppDataType = T;
+  using physicalType = typename TypeTraits<T>::physicalType;
+
+  static const int kBaselineOffset = Encoding::kPrefixSize;
+  static const int kControlOffset = kBaselineOffset + sizeof(T);
+  static const int kPrefixSize = kControlOffset - kBaselineOffset;
+
+  explicit StreamVByteEncoding(
+      velox::memory::MemoryPool& memoryPool,
+      std::string_view data);
+
+  void reset() final;
+  bool reinitialize(std::string_view data) final;
+  void skip(uint32_t rowCount) final;
+  void materialize(uint32_t rowCount, void* buffer) final;
+
+  template <typename DecoderVisitor>
+  void readWithVisitor(DecoderVisitor& visitor, ReadWithVisitorParams& params);
+
+  static std::string_view encode(
+      EncodingSelection<physicalType>& selection,
+      std::span<const physicalType> values,
+      Buffer& buffer);
+
+ private:
+  // Reads the value at row_ (without the baseline), and advances to the next
+  // row.
+  physicalType readNext();
+
+  void initialize(std::string_view data);
+
+  physicalType baseline_;
+  const uint8_t* control_;
+  const char* dataBegin_;
+  const char* dataEnd_;
+  uint32_t row_ = 0;
+  const char* pos_;
+};
+
+//
+// End of public API. Implementations follow.
+//
+
+template <typename T>
+StreamVByteEncoding<T>::StreamVByteEncoding(
+    velox::memory::MemoryPool& memoryPool,
+    std::string_view data)
+    : TypedEncoding<T, physicalType>(memoryPool, data) {
+  static_assert(
+      sizeof(T) == 4, "Stream VByte encoding requires 4 bytes data types.");
+  initialize(data);
+}
+
+template <typename T>
+void StreamVByteEncoding<T>::initialize(std::string_view data) {
+  baseline_ =
+      *reinterpret_cast<const physicalType*>(data.data() + kBaselineOffset);
+  control_ = reinterpret_cast<const uint8_t*>(data.data() + kControlOffset);
+  dataBegin_ = data.data() + kControlOffset +
+      streamvbyte::controlSize(this->rowCount());
+  dataEnd_ = data.data() + data.size();
+  reset();
+}
+
+template <typename T>
+void StreamVByteEncoding<T>::reset() {
+  row_ = 0;
+  pos_ = dataBegin_;
+}
+
+template <typename T>
+bool StreamVByteEncoding<T>::reinitialize(std::string_view data) {
+  this->reinitializePrefix(data);
+  initialize(data);
+  return true;
+}
+
+template <typename T>
+typename StreamVByteEncoding<T>::physicalType
+StreamVByteEncoding<T>::readNext() {
+  const auto length = streamvbyte::valueLength(control_[row_ / 4], row_ % 4);
+  ++row_;
+  return streamvbyte::readValue(&pos_, length);
+}
+
+template <typename T>
+void StreamVByteEncoding<T>::skip(uint32_t rowCount) {
+  // Finish the current (partially consumed) group, after which the bulk
+  // methods can be used.
+  for (; rowCount > 0 && row_ % 4 != 0; --rowCount) {
+    pos_ += streamvbyte::valueLength(control_[row_ / 4], row_ % 4);
+    ++row_;
+  }
+  pos_ = streamvbyte::skip(rowCount, control_ + row_ / 4, pos_);
+  row_ += rowCount;
+}
+
+template <typename T>
+void StreamVByteEncoding<T>::materialize(uint32_t rowCount, void* buffer) {
+  auto output = static_cast<physicalType*>(buffer);
+  auto end = output + rowCount;
+  // Finish the current (partially consumed) group, after which the bulk
+  // methods can be used.
+  while (output < end && row_ % 4 != 0) {
+    *output++ = readNext();
+  }
+  const uint32_t remaining = end - output;
+  pos_ = streamvbyte::decode(
+      remaining, control_ + row_ / 4, pos_, dataEnd_, output);
+  row_ += remaining;
+
+  if (baseline_ != 0) {
+    // Add baseline to values
+    output = static_cast<physicalType*>(buffer);
+    for (uint32_t i = 0; i < rowCount; ++i) {
+      output[i] += baseline_;
+    }
+  }
+}
+
+template <typename T>
+template <typename V>
+void StreamVByteEncoding<T>::readWithVisitor(
+    V& visitor,
+    ReadWithVisitorParams& params) {
+  detail::readWithVisitorSlow(
+      visitor,
+      params,
+      [&](auto toSkip) { skip(toSkip); },
+      [&] { return baseline_ + readNext(); });
+}
+
+template <typename T>
+std::string_view StreamVByteEncoding<T>::encode(
+    EncodingSelection<physicalType>& selection,
+    std::span<const physicalType> values,
+    Buffer& buffer) {
+  static_assert(
+      std::is_same_v<physicalType, uint32_t>,
+      "Stream VByte encoding requires 4 bytes data types.");
+  const uint32_t valueCount = values.size();
+  const physicalType baseline = selection.statistics().min();
+  const uint64_t controlSize = streamvbyte::controlSize(valueCount);
+  const uint32_t encodingSize = Encoding::kPrefixSize +
+      StreamVByteEncoding<T>::kPrefixSize + controlSize +
+      streamvbyte::dataSize(values, baseline);
+
+  char* reserved = buffer.reserve(encodingSize);
+  char* pos = reserved;
+  Encoding::serializePrefix(
+      EncodingType::StreamVByte, TypeTraits<T>::dataType, valueCount, pos);
+  encoding::write(baseline, pos);
+  pos = streamvbyte::encode(
+      values, baseline, reinterpret_cast<uint8_t*>(pos), pos + controlSize);
+  NIMBLE_DASSERT(pos - reserved == encodingSize, "Encoding size mismatch.");
+  return {reserved, encodingSize};
+}
+
+} // namespace facebook::nimble
@@ -26,18 +26,23 @@ TrivialEncoding<std::string_view>::TrivialEncoding(
       row_{0},
       buffer_{&memoryPool},
       dataUncompressed_{&memoryPool} {
+  initialize(data);
+}
+
+void TrivialEncoding<std::string_view>::initialize(std::string_view data) {
   auto pos = data.data() + kDataCompressionOffset;
   auto dataCompressionType =
       static_cast<CompressionType>(encoding::readChar(pos));
   auto lengthsSize = encoding::readUint32(pos);
-  lengths_ = EncodingFactory::decode(memoryPool, {pos, lengthsSize});
+  lengths_ = EncodingFactory::decode(
+      memoryPool_, {pos, lengthsSize}, std::move(lengths_));
   blob_ = pos + lengthsSize;
 
   if (dataCompressionType != CompressionType::Uncompressed) {
-    dataUncompressed_ = Compression::uncompress(
-        memoryPool,
+    Compression::uncompress(
         dataCompressionType,
-        {blob_, static_cast<size_t>(data.end() - blob_)});
+        {blob_, static_cast<size_t>(data.end() - blob_)},
+        dataUncompressed_);
     blob_ = reinterpret_cast<const char*>(dataUncompressed_.data());
     uncompressedDataBytes_ = dataUncompressed_.size();
   } else {
@@ -52,6 +57,13 @@ void TrivialEncoding<std::string_view>::reset() {
   lengths_->reset();
 }
 
+bool TrivialEncoding<std::string_view>::reinitialize(std::string_view data) {
+  reinitializePrefix(data);
+  initialize(data);
+  row_ = 0;
+  return true;
+}
+
 void TrivialEncoding<std::string_view>::skip(uint32_t rowCount) {
   buffer_.resize(rowCount);
   lengths_->materialize(rowCount, buffer_.data());
@@ -139,15 +151,19 @@ TrivialEncoding<bool>::TrivialEncoding(
     std::string_view data)
     : TypedEncoding<bool, bool>{memoryPool, data},
       row_{0},
-      bitmap_{data.data() + kDataOffset},
       uncompressed_{&memoryPool} {
+  initialize(data);
+}
+
+void TrivialEncoding<bool>::initialize(std::string_view data) {
+  bitmap_ = data.data() + kDataOffset;
   auto compressionType =
       static_cast<CompressionType>(data[kCompressionTypeOffset]);
   if (compressionType != CompressionType::Uncompressed) {
-    uncompressed_ = Compression::uncompress(
-        memoryPool,
+    Compression::uncompress(
         compressionType,
-        {bitmap_, static_cast<size_t>(data.end() - bitmap_)});
+        {bitmap_, static_cast<size_t>(data.end() - bitmap_)},
+        uncompressed_);
     bitmap_ = uncompressed_.data();
     NIMBLE_CHECK(
         bitmap_ + FixedBitArray::bufferSize(rowCount(), 1) ==
@@ -164,6 +180,13 @@ void TrivialEncoding<bool>::reset() {
   row_ = 0;
 }
 
+bool TrivialEncoding<bool>::reinitialize(std::string_view data) {
+  reinitializePrefix(data);
+  initialize(data);
+  reset();
+  return true;
+}
+
 void TrivialEncoding<bool>::skip(uint32_t rowCount) {
   row_ += rowCount;
 }
@@ -56,9 +56,18 @@ class TrivialEncoding final
   TrivialEncoding(velox::memory::MemoryPool& memoryPool, std::string_view data);
 
   void reset() final;
+  bool reinitialize(std::string_view data) final;
   void skip(uint32_t rowCount) final;
   void materialize(uint32_t rowCount, void* buffer) final;
 
+  // Returns the next |rowCount| values in place, without copying them, and
+  // advances the row pointer |rowCount|.
+  const T* next(uint32_t rowCount) {
+    const T* values = values_ + row_;
+    row_ += rowCount;
+    return values;
+  }
+
   template <typename DecoderVisitor>
   void readWithVisitor(DecoderVisitor& visitor, ReadWithVisitorParams& params);
 
@@ -76,6 +85,8 @@ class TrivialEncoding final
       Buffer& buffer);
 
  private:
+  void initialize(std::string_view data);
+
   uint32_t row_;
   const T* values_;
   Vector<char> uncompressed_;
@@ -102,6 +113,7 @@ class TrivialEncoding<std::string_view> final
   TrivialEncoding(velox::memory::MemoryPool& memoryPool, std::string_view data);
 
   void reset() final;
+  bool reinitialize(std::string_view data) final;
   void skip(uint32_t rowCount) final;
   void materialize(uint32_t rowCount, void* buffer) final;
 
@@ -117,6 +129,8 @@ class TrivialEncoding<std::string_view> final
       Buffer& buffer);
 
  private:
+  void initialize(std::string_view data);
+
   uint32_t row_;
   const char* blob_;
   const char* pos_;
@@ -148,12 +162,23 @@ class TrivialEncoding<bool> final : public TypedEncoding<bool, bool> {
   TrivialEncoding(velox::memory::MemoryPool& memoryPool, std::string_view data);
 
   void reset() final;
+  bool reinitialize(std::string_view data) final;
   void skip(uint32_t rowCount) final;
   void materialize(uint32_t rowCount, void* buffer) final;
 
   void materializeBoolsAsBits(uint32_t rowCount, uint64_t* buffer, int begin)
       final;
 
+  // The bitmap, and the position of the next row in it. Allows reading the
+  // next rows in place, followed by skip().
+  const char* bitmap() const {
+    return bitmap_;
+  }
+
+  uint32_t row() const {
+    return row_;
+  }
+
   template <typename DecoderVisitor>
   void readWithVisitor(DecoderVisitor& visitor, ReadWithVisitorParams& params);
 
@@ -163,6 +188,8 @@ class TrivialEncoding<bool> final : public TypedEncoding<bool, bool> {
       Buffer& buffer);
 
  private:
+  void initialize(std::string_view data);
+
   uint32_t row_;
   const char* bitmap_;
   Vector<char> uncompressed_;
@@ -178,15 +205,20 @@ TrivialEncoding<T>::TrivialEncoding(
     std::string_view data)
     : TypedEncoding<T, physicalType>{memoryPool, data},
       row_{0},
-      values_{reinterpret_cast<const T*>(data.data() + kDataOffset)},
       uncompressed_{&memoryPool} {
+  initialize(data);
+}
+
+template <typename T>
+void TrivialEncoding<T>::initialize(std::string_view data) {
+  values_ = reinterpret_cast<const T*>(data.data() + kDataOffset);
   auto compressionType =
       static_cast<CompressionType>(data[kCompressionTypeOffset]);
   if (compressionType != CompressionType::Uncompressed) {
-    uncompressed_ = Compression::uncompress(
-        memoryPool,
+    Compression::uncompress(
         compressionType,
-        {data.data() + kDataOffset, data.size() - kDataOffset});
+        {data.data() + kDataOffset, data.size() - kDataOffset},
+        uncompressed_);
     values_ = reinterpret_cast<const T*>(uncompressed_.data());
     NIMBLE_CHECK(
         reinterpret_cast<const char*>(values_ + this->rowCount()) ==
@@ -204,6 +236,14 @@ void TrivialEncoding<T>::reset() {
   row_ = 0;
 }
 
+template <typename T>
+bool TrivialEncoding<T>::reinitialize(std::string_view data) {
+  this->reinitializePrefix(data);
+  initialize(data);
+  reset();
+  return true;
+}
+
 template <typename T>
 void TrivialEncoding<T>::skip(uint32_t rowCount) {
   row_ += rowCount;
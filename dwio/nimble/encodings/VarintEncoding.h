@@ -55,6 +55,7 @@ class VarintEncoding final
       std::string_view data);
 
   void reset() final;
+  bool reinitialize(std::string_view data) final;
   void skip(uint32_t rowCount) final;
   void materialize(uint32_t rowCount, void* buffer) final;
 
@@ -67,7 +68,7 @@ class VarintEncoding final
       Buffer& buffer);
 
  private:
-  const physicalType baseline_;
+  physicalType baseline_;
   uint32_t row_ = 0;
   const char* pos_;
   Vector<physicalType> buf_;
@@ -95,6 +96,15 @@ void VarintEncoding<T>::reset() {
       VarintEncoding<T>::kPrefixSize;
 }
 
+template <typename T>
+bool VarintEncoding<T>::reinitialize(std::string_view data) {
+  this->reinitializePrefix(data);
+  baseline_ =
+      *reinterpret_cast<const physicalType*>(data.data() + kBaselineOffset);
+  reset();
+  return true;
+}
+
 template <typename T>
 void VarintEncoding<T>::skip(uint32_t rowCount) {
   row_ += rowCount;
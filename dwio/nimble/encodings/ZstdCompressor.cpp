@@ -18,10 +18,76 @@
 
 #include <zstd.h>
 #include <zstd_errors.h>
+#include <cstring>
+#include <memory>
 #include <optional>
 
+#include "dwio/nimble/common/ZstdContext.h"
+
 namespace facebook::nimble {
 
+namespace {
+
+// Payloads up to this size are compressed into a reusable (thread local)
+// scratch buffer, and are only copied into an output buffer (of the exact
+// compressed size) if compression succeeds. This avoids allocating a full
+// size output buffer for each of the many small streams in a stripe.
+constexpr size_t kMaxScratchSize = 64 * 1024;
+
+size_t compressSerial(
+    char* destination,
+    size_t destinationSize,
+    std::string_view data,
+    const ZstdCompressionParameters& parameters) {
+  return ZSTD_compressCCtx(
+      zstd::compressionContext(),
+      destination,
+      destinationSize,
+      data.data(),
+      data.size(),
+      parameters.compressionLevel);
+}
+
+// Compresses using zstd worker threads. Falls back to single threaded
+// compression if the zstd library was built without multithreading support.
+// Uses its own context (rather than the thread local one), so the worker pool
+// it starts is released once the payload is compressed.
+size_t compressParallel(
+    char* destination,
+    size_t destinationSize,
+    std::string_view data,
+    const ZstdCompressionParameters& parameters) {
+  std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context{
+      ZSTD_createCCtx(), &ZSTD_freeCCtx};
+  NIMBLE_CHECK(context != nullptr, "Unable to create zstd context.");
+  auto ret = ZSTD_CCtx_setParameter(
+      context.get(), ZSTD_c_compressionLevel, parameters.compressionLevel);
+  NIMBLE_CHECK(
+      !ZSTD_isError(ret),
+      fmt::format(
+          "Error setting zstd compression level: {}",
+          ZSTD_getErrorName(ret)));
+  ZSTD_CCtx_setParameter(
+      context.get(), ZSTD_c_nbWorkers, parameters.workerCount);
+  return ZSTD_compress2(
+      context.get(), destination, destinationSize, data.data(), data.size());
+}
+
+// Returns false if the compressed result didn't fit in the destination
+// buffer (meaning compression isn't beneficial).
+bool checkCompressed(size_t ret) {
+  if (ZSTD_isError(ret)) {
+    NIMBLE_ASSERT(
+        ZSTD_getErrorCode(ret) == ZSTD_ErrorCode::ZSTD_error_dstSize_tooSmall,
+        fmt::format(
+            "Error while compressing data: {}", ZSTD_getErrorName(ret)));
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
 CompressionResult ZstdCompressor::compress(
     velox::memory::MemoryPool& memoryPool,
     std::string_view data,
@@ -29,16 +95,35 @@ CompressionResult ZstdCompressor::compress(
     int /* bitWidth */,
     const CompressionPolicy& compressionPolicy) {
   auto parameters = compressionPolicy.compression().parameters.zstd;
+  const bool parallel = parameters.workerCount > 0 &&
+      data.size() >= parameters.parallelMinSize;
+
+  if (!parallel && data.size() <= kMaxScratchSize) {
+    thread_local std::unique_ptr<char[]> scratch{new char[kMaxScratchSize]};
+    auto ret = compressSerial(scratch.get(), data.size(), data, parameters);
+    if (!checkCompressed(ret)) {
+      return {
+          .compressionType = CompressionType::Uncompressed,
+          .buffer = std::nullopt,
+      };
+    }
+
+    Vector<char> buffer{&memoryPool, ret + sizeof(uint32_t)};
+    auto pos = buffer.data();
+    encoding::writeUint32(data.size(), pos);
+    std::memcpy(pos, scratch.get(), ret);
+    return {
+        .compressionType = CompressionType::Zstd,
+        .buffer = std::move(buffer),
+    };
+  }
+
   Vector<char> buffer{&memoryPool, data.size() + sizeof(uint32_t)};
   auto pos = buffer.data();
   encoding::writeUint32(data.size(), pos);
-  auto ret = ZSTD_compress(
-      pos, data.size(), data.data(), data.size(), parameters.compressionLevel);
-  if (ZSTD_isError(ret)) {
-    NIMBLE_ASSERT(
-        ZSTD_getErrorCode(ret) == ZSTD_ErrorCode::ZSTD_error_dstSize_tooSmall,
-        fmt::format(
-            "Error while compressing data: {}", ZSTD_getErrorName(ret)));
+  auto ret = parallel ? compressParallel(pos, data.size(), data, parameters)
+                      : compressSerial(pos, data.size(), data, parameters);
+  if (!checkCompressed(ret)) {
     return {
         .compressionType = CompressionType::Uncompressed,
         .buffer = std::nullopt,
@@ -56,15 +141,29 @@ Vector<char> ZstdCompressor::uncompress(
     velox::memory::MemoryPool& memoryPool,
     CompressionType compressionType,
     std::string_view data) {
+  Vector<char> buffer{&memoryPool};
+  uncompress(compressionType, data, buffer);
+  return buffer;
+}
+
+void ZstdCompressor::uncompress(
+    CompressionType /* compressionType */,
+    std::string_view data,
+    Vector<char>& output) {
   auto pos = data.data();
   const uint32_t uncompressedSize = encoding::readUint32(pos);
-  Vector<char> buffer{&memoryPool, uncompressedSize};
-  auto ret = ZSTD_decompress(
-      buffer.data(), buffer.size(), pos, data.size() - sizeof(uint32_t));
+  // Previous content is overwritten, so avoid copying it if we need to grow.
+  output.update_size(0);
+  output.resize(uncompressedSize);
+  auto ret = ZSTD_decompressDCtx(
+      zstd::decompressionContext(),
+      output.data(),
+      output.size(),
+      pos,
+      data.size() - sizeof(uint32_t));
   NIMBLE_CHECK(
       !ZSTD_isError(ret),
       fmt::format("Error uncompressing data: {}", ZSTD_getErrorName(ret)));
-  return buffer;
 }
 
 CompressionType ZstdCompressor::compressionType() {
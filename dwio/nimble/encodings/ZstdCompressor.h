@@ -34,6 +34,11 @@ class ZstdCompressor : public ICompressor {
       CompressionType compressionType,
       std::string_view data) override;
 
+  void uncompress(
+      CompressionType compressionType,
+      std::string_view data,
+      Vector<char>& output) override;
+
   CompressionType compressionType() override;
 };
 
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <zstd.h>
+#include <string>
+#include <vector>
+
+#include "dwio/nimble/encodings/Compression.h"
+#include "folly/Benchmark.h"
+#include "folly/Random.h"
+#include "folly/init/Init.h"
+#include "velox/common/memory/Memory.h"
+
+using namespace ::facebook;
+
+// Compares compressing/decompressing many small payloads (e.g. flat map value
+// streams) using a fresh zstd context per call (ZSTD_compress /
+// ZSTD_decompress), against the nimble compressor, which reuses thread local
+// contexts.
+
+constexpr size_t kPayloadCount = 1000;
+constexpr int kCompressionLevel = 3;
+
+std::shared_ptr<velox::memory::MemoryPool> pool;
+std::vector<std::string> smallPayloads;
+std::vector<std::string> mediumPayloads;
+std::vector<std::string> compressedSmallPayloads;
+std::vector<std::string> compressedMediumPayloads;
+
+class ZstdCompressionPolicy : public nimble::CompressionPolicy {
+ public:
+  nimble::CompressionInformation compression() const override {
+    nimble::CompressionInformation information{
+        .compressionType = nimble::CompressionType::Zstd};
+    information.parameters.zstd.compressionLevel = kCompressionLevel;
+    return information;
+  }
+
+  bool shouldAccept(
+      nimble::CompressionType /* compressionType */,
+      uint64_t /* uncompressedSize */,
+      uint64_t /* compressedSize */) const override {
+    return true;
+  }
+};
+
+std::vector<std::string> generatePayloads(size_t size) {
+  std::vector<std::string> payloads(kPayloadCount);
+  for (auto& payload : payloads) {
+    while (payload.size() < size) {
+      payload.append(std::to_string(folly::Random::rand32(100)));
+    }
+    payload.resize(size);
+  }
+  return payloads;
+}
+
+std::vector<std::string> compress(const std::vector<std::string>& payloads) {
+  ZstdCompressionPolicy policy;
+  std::vector<std::string> compressed;
+  compressed.reserve(payloads.size());
+  for (const auto& payload : payloads) {
+    auto result = nimble::Compression::compress(
+        *pool, payload, nimble::DataType::String, 0, policy);
+    compressed.emplace_back(result.buffer->data(), result.buffer->size());
+  }
+  return compressed;
+}
+
+void compressFreshContext(const std::vector<std::string>& payloads) {
+  std::vector<char> buffer;
+  for (const auto& payload : payloads) {
+    buffer.resize(payload.size());
+    folly::doNotOptimizeAway(ZSTD_compress(
+        buffer.data(),
+        buffer.size(),
+        payload.data(),
+        payload.size(),
+        kCompressionLevel));
+  }
+}
+
+void compressNimble(const std::vector<std::string>& payloads) {
+  ZstdCompressionPolicy policy;
+  for (const auto& payload : payloads) {
+    folly::doNotOptimizeAway(nimble::Compression::compress(
+        *pool, payload, nimble::DataType::String, 0, policy));
+  }
+}
+
+void uncompressFreshContext(
+    const std::vector<std::string>& compressed,
+    size_t size) {
+  std::vector<char> buffer(size);
+  for (const auto& payload : compressed) {
+    // Skip the uncompressed size header.
+    folly::doNotOptimizeAway(ZSTD_decompress(
+        buffer.data(),
+        buffer.size(),
+        payload.data() + sizeof(uint32_t),
+        payload.size() - sizeof(uint32_t)));
+  }
+}
+
+void uncompressNimble(const std::vector<std::string>& compressed) {
+  for (const auto& payload : compressed) {
+    folly::doNotOptimizeAway(nimble::Compression::uncompress(
+        *pool, nimble::CompressionType::Zstd, payload));
+  }
+}
+
+BENCHMARK(CompressSmallFreshContext) {
+  compressFreshContext(smallPayloads);
+}
+
+BENCHMARK_RELATIVE(CompressSmallReusedContext) {
+  compressNimble(smallPayloads);
+}
+
+BENCHMARK(CompressMediumFreshContext) {
+  compressFreshContext(mediumPayloads);
+}
+
+BENCHMARK_RELATIVE(CompressMediumReusedContext) {
+  compressNimble(mediumPayloads);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(UncompressSmallFreshContext) {
+  uncompressFreshContext(compressedSmallPayloads, smallPayloads[0].size());
+}
+
+BENCHMARK_RELATIVE(UncompressSmallReusedContext) {
+  uncompressNimble(compressedSmallPayloads);
+}
+
+BENCHMARK(UncompressMediumFreshContext) {
+  uncompressFreshContext(compressedMediumPayloads, mediumPayloads[0].size());
+}
+
+BENCHMARK_RELATIVE(UncompressMediumReusedContext) {
+  uncompressNimble(compressedMediumPayloads);
+}
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  pool = velox::memory::deprecatedAddDefaultLeafMemoryPool();
+  smallPayloads = generatePayloads(256);
+  mediumPayloads = generatePayloads(16 * 1024);
+  compressedSmallPayloads = compress(smallPayloads);
+  compressedMediumPayloads = compress(mediumPayloads);
+
+  folly::runBenchmarks();
+  return 0;
+}
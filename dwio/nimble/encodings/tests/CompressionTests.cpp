@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+#include "dwio/nimble/encodings/Compression.h"
+#include "velox/common/memory/Memory.h"
+
+using namespace ::facebook;
+
+namespace {
+
+class TestCompressionPolicy : public nimble::CompressionPolicy {
+ public:
+  explicit TestCompressionPolicy(nimble::CompressionInformation information)
+      : information_{information} {}
+
+  nimble::CompressionInformation compression() const override {
+    return information_;
+  }
+
+  bool shouldAccept(
+      nimble::CompressionType /* compressionType */,
+      uint64_t /* uncompressedSize */,
+      uint64_t /* compressedSize */) const override {
+    return true;
+  }
+
+ private:
+  const nimble::CompressionInformation information_;
+};
+
+std::string generateData(uint64_t size) {
+  std::string data;
+  data.reserve(size);
+  uint32_t value = 0;
+  while (data.size() < size) {
+    data.append(std::to_string(value++ % 1000));
+    data.push_back(',');
+  }
+  data.resize(size);
+  return data;
+}
+
+} // namespace
+
+class CompressionTests : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    pool_ = velox::memory::deprecatedAddDefaultLeafMemoryPool();
+  }
+
+  void verifyRoundTrip(
+      std::string_view data,
+      nimble::CompressionInformation information) {
+    TestCompressionPolicy policy{information};
+    auto result = nimble::Compression::compress(
+        *pool_, data, nimble::DataType::String, 0, policy);
+    ASSERT_EQ(information.compressionType, result.compressionType);
+    ASSERT_TRUE(result.buffer.has_value());
+    EXPECT_LT(result.buffer->size(), data.size());
+
+    auto uncompressed = nimble::Compression::uncompress(
+        *pool_,
+        result.compressionType,
+        {result.buffer->data(), result.buffer->size()});
+    ASSERT_EQ(data, std::string_view(uncompressed.data(), uncompressed.size()));
+  }
+
+  std::shared_ptr<velox::memory::MemoryPool> pool_;
+};
+
+TEST_F(CompressionTests, Zstd) {
+  nimble::CompressionInformation information{
+      .compressionType = nimble::CompressionType::Zstd};
+  information.parameters.zstd.compressionLevel = 3;
+  verifyRoundTrip(generateData(1 << 20), information);
+}
+
+TEST_F(CompressionTests, ZstdSmallPayloads) {
+  // Small payloads are compressed into a scratch buffer, using reused
+  // contexts. Interleave sizes, to make sure no state leaks between calls.
+  nimble::CompressionInformation information{
+      .compressionType = nimble::CompressionType::Zstd};
+  information.parameters.zstd.compressionLevel = 3;
+  for (auto i = 0; i < 10; ++i) {
+    for (auto size : {100, 64 * 1024, 1000, 64 * 1024 + 1, 10'000}) {
+      verifyRoundTrip(generateData(size), information);
+    }
+  }
+}
+
+TEST_F(CompressionTests, ZstdParallel) {
+  nimble::CompressionInformation information{
+      .compressionType = nimble::CompressionType::Zstd};
+  information.parameters.zstd.compressionLevel = 3;
+  information.parameters.zstd.workerCount = 4;
+  information.parameters.zstd.parallelMinSize = 1 << 20;
+
+  // Below the parallel threshold.
+  verifyRoundTrip(generateData(1 << 10), information);
+  // Above the parallel threshold.
+  verifyRoundTrip(generateData(8 << 20), information);
+}
+
+TEST_F(CompressionTests, Lz4) {
+  nimble::CompressionInformation information{
+      .compressionType = nimble::CompressionType::Lz4};
+  information.parameters.lz4.acceleration = 1;
+  for (auto size : {100, 10'000, 1 << 20}) {
+    verifyRoundTrip(generateData(size), information);
+  }
+
+  information.parameters.lz4.acceleration = 8;
+  verifyRoundTrip(generateData(1 << 20), information);
+}
+
+TEST_F(CompressionTests, Lz4Incompressible) {
+  nimble::CompressionInformation information{
+      .compressionType = nimble::CompressionType::Lz4};
+  TestCompressionPolicy policy{information};
+  std::mt19937 rng{42};
+  std::string data(1000, '\0');
+  for (auto& c : data) {
+    c = static_cast<char>(rng());
+  }
+  // Random data doesn't fit in the (uncompressed size) output buffer.
+  auto result = nimble::Compression::compress(
+      *pool_, data, nimble::DataType::String, 0, policy);
+  EXPECT_EQ(nimble::CompressionType::Uncompressed, result.compressionType);
+  EXPECT_FALSE(result.buffer.has_value());
+}
+
+TEST_F(CompressionTests, UncompressIntoReusedBuffer) {
+  for (auto compressionType :
+       {nimble::CompressionType::Zstd, nimble::CompressionType::Lz4}) {
+    nimble::CompressionInformation information{
+        .compressionType = compressionType};
+    if (compressionType == nimble::CompressionType::Lz4) {
+      information.parameters.lz4.acceleration = 1;
+    } else {
+      information.parameters.zstd.compressionLevel = 3;
+    }
+    TestCompressionPolicy policy{information};
+    nimble::Vector<char> output{pool_.get()};
+    const char* allocation = nullptr;
+    // Largest payload first, so all following payloads fit in the buffer
+    // allocated for it.
+    for (auto size : {1 << 20, 100, 10'000, 1 << 20, 1000}) {
+      const auto data = generateData(size);
+      auto result = nimble::Compression::compress(
+          *pool_, data, nimble::DataType::String, 0, policy);
+      ASSERT_EQ(compressionType, result.compressionType);
+
+      nimble::Compression::uncompress(
+          compressionType,
+          {result.buffer->data(), result.buffer->size()},
+          output);
+      ASSERT_EQ(data, std::string_view(output.data(), output.size()));
+      if (allocation == nullptr) {
+        allocation = output.data();
+      }
+      EXPECT_EQ(allocation, output.data());
+    }
+  }
+}
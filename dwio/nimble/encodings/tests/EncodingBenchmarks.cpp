@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <array>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "dwio/nimble/common/Bits.h"
+#include "dwio/nimble/common/Buffer.h"
+#include "dwio/nimble/common/Exceptions.h"
+#include "dwio/nimble/common/Types.h"
+#include "dwio/nimble/common/Vector.h"
+#include "dwio/nimble/encodings/EncodingFactory.h"
+#include "dwio/nimble/encodings/EncodingLayout.h"
+#include "dwio/nimble/encodings/EncodingSelectionPolicy.h"
+#include "folly/Benchmark.h"
+#include "folly/Random.h"
+#include "folly/init/Init.h"
+#include "velox/common/memory/Memory.h"
+
+using namespace ::facebook;
+
+// Decoding cost matrix: for every data type x encoding type x data
+// distribution, measures materialize, skip and materializeNullable (with ~10%
+// nulls), in batches of kBatchSize rows. Times are reported per value, so they
+// can be compared across encodings (e.g. to ground the read factors of
+// ManualEncodingSelectionPolicy).
+//
+// Benchmarks are named <operation>/<data type>/<encoding>/<distribution>. Use
+// --bm_regex to run a subset. Combinations the encoding doesn't support (e.g.
+// FixedBitWidth for strings, or Constant for non-constant data) are skipped.
+//
+// readWithVisitor is not covered, as it can only be driven by a velox
+// SelectiveColumnReader.
+
+namespace {
+
+constexpr uint32_t kRowCount = 64 * 1024;
+constexpr uint32_t kBatchSize = 1024;
+
+enum class Distribution {
+  // Uniformly distributed over the whole type range.
+  Uniform,
+  // Uniformly distributed over 100 values.
+  SmallRange,
+  // Runs of up to 64 repeated values.
+  Runs,
+  // 95% of the values are the same.
+  MainlyConstant,
+  Constant,
+};
+
+constexpr std::array kDistributions{
+    Distribution::Uniform,
+    Distribution::SmallRange,
+    Distribution::Runs,
+    Distribution::MainlyConstant,
+    Distribution::Constant,
+};
+
+constexpr std::array kEncodingTypes{
+    nimble::EncodingType::Trivial,
+    nimble::EncodingType::RLE,
+    nimble::EncodingType::Dictionary,
+    nimble::EncodingType::FixedBitWidth,
+    nimble::EncodingType::Varint,
+    nimble::EncodingType::StreamVByte,
+    nimble::EncodingType::Constant,
+    nimble::EncodingType::MainlyConstant,
+    nimble::EncodingType::SparseBool,
+};
+
+std::string toString(Distribution distribution) {
+  switch (distribution) {
+    case Distribution::Uniform:
+      return "Uniform";
+    case Distribution::SmallRange:
+      return "SmallRange";
+    case Distribution::Runs:
+      return "Runs";
+    case Distribution::MainlyConstant:
+      return "MainlyConstant";
+    case Distribution::Constant:
+      return "Constant";
+  }
+  NIMBLE_UNREACHABLE("Unknown distribution.");
+}
+
+std::shared_ptr<velox::memory::MemoryPool> pool;
+// Backing storage for string values and encoded data, referenced by the
+// registered benchmarks.
+std::deque<std::string> storage;
+
+template <typename T>
+T makeValue(uint64_t value) {
+  if constexpr (nimble::isStringType<T>()) {
+    return storage.emplace_back(fmt::format("value_{}", value));
+  } else if constexpr (nimble::isBoolType<T>()) {
+    return value & 1;
+  } else {
+    return static_cast<T>(value);
+  }
+}
+
+template <typename T>
+nimble::Vector<T> generate(Distribution distribution) {
+  nimble::Vector<T> values{pool.get()};
+  values.reserve(kRowCount);
+  uint64_t run = 0;
+  uint64_t value = 0;
+  for (auto i = 0; i < kRowCount; ++i) {
+    switch (distribution) {
+      case Distribution::Uniform:
+        value = folly::Random::rand64();
+        break;
+      case Distribution::SmallRange:
+        value = folly::Random::rand32(100);
+        break;
+      case Distribution::Runs:
+        if (run == 0) {
+          run = folly::Random::rand32(1, 65);
+          value = folly::Random::rand32(100);
+        }
+        --run;
+        break;
+      case Distribution::MainlyConstant:
+        value = folly::Random::oneIn(20) ? folly::Random::rand32(100) : 7;
+        break;
+      case Distribution::Constant:
+        value = 7;
+        break;
+    }
+    values.push_back(makeValue<T>(value));
+  }
+  return values;
+}
+
+// Encodes |values| with |encodingType| at the top level (nested encodings
+// are selected by the default policy). If |nullable|, ~10% of the rows are
+// made null. Returns nullptr if the encoding doesn't support the data.
+template <typename T>
+const std::string* encode(
+    nimble::EncodingType encodingType,
+    const nimble::Vector<T>& values,
+    bool nullable) {
+  // Dictionary encoding doesn't support bools, and asserts on them instead of
+  // reporting an incompatible encoding.
+  if (nimble::isBoolType<T>() &&
+      encodingType == nimble::EncodingType::Dictionary) {
+    return nullptr;
+  }
+
+  nimble::EncodingSelectionPolicyFactory encodingSelectionPolicyFactory =
+      [encodingFactory = nimble::ManualEncodingSelectionPolicyFactory{}](
+          nimble::DataType dataType)
+      -> std::unique_ptr<nimble::EncodingSelectionPolicyBase> {
+    return encodingFactory.createPolicy(dataType);
+  };
+  auto policy = std::make_unique<nimble::ReplayedEncodingSelectionPolicy<T>>(
+      nimble::EncodingLayout{
+          encodingType, nimble::CompressionType::Uncompressed},
+      nimble::CompressionOptions{},
+      encodingSelectionPolicyFactory);
+
+  try {
+    nimble::Buffer buffer{*pool};
+    std::string_view encoded;
+    if (nullable) {
+      nimble::Vector<bool> nonNulls{pool.get()};
+      uint32_t nonNullCount = 0;
+      for (auto i = 0; i < values.size(); ++i) {
+        nonNulls.push_back(!folly::Random::oneIn(10));
+        nonNullCount += nonNulls.back();
+      }
+      encoded = nimble::EncodingFactory::encodeNullable<T>(
+          std::move(policy),
+          std::span<const T>{values.data(), nonNullCount},
+          std::span<const bool>{nonNulls.data(), nonNulls.size()},
+          buffer);
+    } else {
+      encoded = nimble::EncodingFactory::encode<T>(
+          std::move(policy),
+          std::span<const T>{values.data(), values.size()},
+          buffer);
+    }
+
+    // Verify the encoding can be decoded.
+    using physicalType = typename nimble::TypeTraits<T>::physicalType;
+    nimble::Vector<physicalType> output{pool.get(), values.size()};
+    nimble::EncodingFactory::decode(*pool, encoded)
+        ->materialize(values.size(), output.data());
+    return &storage.emplace_back(encoded);
+  } catch (const nimble::NimbleUserError& e) {
+    if (e.errorCode() == nimble::error_code::IncompatibleEncoding) {
+      return nullptr;
+    }
+    throw;
+  }
+}
+
+template <typename T>
+unsigned materialize(const std::string& data, unsigned iters) {
+  using physicalType = typename nimble::TypeTraits<T>::physicalType;
+  folly::BenchmarkSuspender suspender;
+  auto encoding = nimble::EncodingFactory::decode(*pool, data);
+  nimble::Vector<physicalType> output{pool.get(), kBatchSize};
+  suspender.dismiss();
+
+  for (auto i = 0; i < iters; ++i) {
+    encoding->reset();
+    for (auto row = 0; row < kRowCount; row += kBatchSize) {
+      encoding->materialize(kBatchSize, output.data());
+      folly::doNotOptimizeAway(output.data());
+    }
+  }
+  return iters * kRowCount;
+}
+
+unsigned skip(const std::string& data, unsigned iters) {
+  folly::BenchmarkSuspender suspender;
+  auto encoding = nimble::EncodingFactory::decode(*pool, data);
+  suspender.dismiss();
+
+  for (auto i = 0; i < iters; ++i) {
+    encoding->reset();
+    for (auto row = 0; row < kRowCount; row += kBatchSize) {
+      encoding->skip(kBatchSize);
+    }
+    folly::doNotOptimizeAway(encoding);
+  }
+  return iters * kRowCount;
+}
+
+template <typename T>
+unsigned materializeNullable(const std::string& data, unsigned iters) {
+  using physicalType = typename nimble::TypeTraits<T>::physicalType;
+  folly::BenchmarkSuspender suspender;
+  auto encoding = nimble::EncodingFactory::decode(*pool, data);
+  nimble::Vector<physicalType> output{pool.get(), kBatchSize};
+  nimble::Vector<char> nulls{
+      pool.get(), nimble::bits::bytesRequired(kBatchSize)};
+  suspender.dismiss();
+
+  for (auto i = 0; i < iters; ++i) {
+    encoding->reset();
+    for (auto row = 0; row < kRowCount; row += kBatchSize) {
+      folly::doNotOptimizeAway(encoding->materializeNullable(
+          kBatchSize, output.data(), [&]() { return nulls.data(); }));
+    }
+  }
+  return iters * kRowCount;
+}
+
+template <typename T>
+void registerBenchmarks() {
+  const auto dataType = nimble::toString(nimble::TypeTraits<T>::dataType);
+  for (auto distribution : kDistributions) {
+    const auto values = generate<T>(distribution);
+    for (auto encodingType : kEncodingTypes) {
+      const auto suffix = fmt::format(
+          "{}/{}/{}",
+          dataType,
+          nimble::toString(encodingType),
+          toString(distribution));
+      if (const auto* data = encode<T>(encodingType, values, false)) {
+        folly::addBenchmark(
+            __FILE__, "Materialize/" + suffix, [data](unsigned iters) {
+              return materialize<T>(*data, iters);
+            });
+        folly::addBenchmark(
+            __FILE__, "Skip/" + suffix, [data](unsigned iters) {
+              return skip(*data, iters);
+            });
+      }
+      if (const auto* data = encode<T>(encodingType, values, true)) {
+        folly::addBenchmark(
+            __FILE__, "MaterializeNullable/" + suffix, [data](unsigned iters) {
+              return materializeNullable<T>(*data, iters);
+            });
+      }
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  pool = velox::memory::deprecatedAddDefaultLeafMemoryPool();
+
+  registerBenchmarks<int32_t>();
+  registerBenchmarks<uint32_t>();
+  registerBenchmarks<int64_t>();
+  registerBenchmarks<float>();
+  registerBenchmarks<double>();
+  registerBenchmarks<bool>();
+  registerBenchmarks<std::string_view>();
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -157,6 +157,16 @@ TEST(EncodingLayoutTests, Varint) {
   testCapture<uint32_t>(expected, {1, 2, 3});
 }
 
+TEST(EncodingLayoutTests, StreamVByte) {
+  nimble::EncodingLayout expected{
+      nimble::EncodingType::StreamVByte,
+      nimble::CompressionType::Uncompressed,
+  };
+
+  testSerialization(expected);
+  testCapture<uint32_t>(expected, {1, 2, 3, 1000, 100000});
+}
+
 TEST(EncodingLayoutTests, Constant) {
   nimble::EncodingLayout expected{
       nimble::EncodingType::Constant,
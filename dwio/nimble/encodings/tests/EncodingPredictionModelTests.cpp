@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <random>
+
+#include "dwio/nimble/common/Exceptions.h"
+#include "dwio/nimble/encodings/EncodingPredictionModel.h"
+
+using namespace ::facebook;
+
+namespace {
+
+constexpr auto kAnyEncoding = [](nimble::EncodingType) { return true; };
+
+// Labels samples using simple rules, resembling the manual policy decisions.
+nimble::EncodingType label(const nimble::EncodingFeatures& features) {
+  auto feature = [&](nimble::EncodingFeature feature) {
+    return features[static_cast<uint8_t>(feature)];
+  };
+  if (feature(nimble::EncodingFeature::MostCommonRatio) > 0.9f) {
+    return nimble::EncodingType::MainlyConstant;
+  }
+  if (feature(nimble::EncodingFeature::RunRatio) < 0.1f) {
+    return nimble::EncodingType::RLE;
+  }
+  if (feature(nimble::EncodingFeature::UniqueRatio) < 0.3f) {
+    return nimble::EncodingType::Dictionary;
+  }
+  return nimble::EncodingType::Trivial;
+}
+
+std::vector<nimble::EncodingTrainingSample> generateSamples(
+    std::mt19937& rng,
+    uint32_t count) {
+  std::uniform_real_distribution<float> distribution{0.0f, 1.0f};
+  std::vector<nimble::EncodingTrainingSample> samples(count);
+  for (auto& sample : samples) {
+    for (auto& feature : sample.features) {
+      feature = distribution(rng);
+    }
+    sample.encodingType = label(sample.features);
+  }
+  return samples;
+}
+
+} // namespace
+
+TEST(EncodingPredictionModelTests, SampleSerialization) {
+  nimble::EncodingTrainingSample sample{
+      .encodingType = nimble::EncodingType::Dictionary,
+      .features = {0.5f, 0.25f, 1.0f, 0.125f, 0.0f, 0.75f}};
+  auto serialized = sample.serialize();
+  EXPECT_EQ("Dictionary:0.5,0.25,1,0.125,0,0.75", serialized);
+
+  auto parsed = nimble::EncodingTrainingSample::parse(serialized);
+  EXPECT_EQ(sample.encodingType, parsed.encodingType);
+  EXPECT_EQ(sample.features, parsed.features);
+
+  EXPECT_THROW(
+      nimble::EncodingTrainingSample::parse("Dictionary:0.5,0.25"),
+      nimble::NimbleUserError);
+  EXPECT_THROW(
+      nimble::EncodingTrainingSample::parse("Unknown:0,0,0,0,0,0"),
+      nimble::NimbleUserError);
+  EXPECT_THROW(
+      nimble::EncodingTrainingSample::parse("Trivial:0,0,abc,0,0,0"),
+      nimble::NimbleUserError);
+}
+
+TEST(EncodingPredictionModelTests, ModelSerialization) {
+  nimble::EncodingPredictionModel model;
+  auto serialized = model.serialize();
+  auto parsed = nimble::EncodingPredictionModel::parse(serialized);
+  EXPECT_EQ(serialized, parsed.serialize());
+  ASSERT_EQ(model.trees().size(), parsed.trees().size());
+  for (auto i = 0; i < model.trees().size(); ++i) {
+    EXPECT_EQ(model.trees()[i].first, parsed.trees()[i].first);
+    EXPECT_EQ(model.trees()[i].second.size(), parsed.trees()[i].second.size());
+  }
+
+  EXPECT_THROW(
+      nimble::EncodingPredictionModel::parse(""), nimble::NimbleUserError);
+  EXPECT_THROW(
+      nimble::EncodingPredictionModel::parse("Trivial=0,0,0"),
+      nimble::NimbleUserError);
+  EXPECT_THROW(
+      nimble::EncodingPredictionModel::parse(
+          "Unknown=0,0,0,0,0,0,0,inf,inf,inf,inf,inf,inf,inf,1,0,0,0,0,0,0,0"),
+      nimble::NimbleUserError);
+  EXPECT_THROW(
+      nimble::EncodingPredictionModel::parse(
+          "Trivial=9,0,0,0,0,0,0,inf,inf,inf,inf,inf,inf,inf,1,0,0,0,0,0,0,0"),
+      nimble::NimbleUserError);
+
+  // Trees of the same encoding are merged, even when not consecutive.
+  auto merged = nimble::EncodingPredictionModel::parse(
+      "Trivial=0,0,0,0,0,0,0,inf,inf,inf,inf,inf,inf,inf,1,0,0,0,0,0,0,0;"
+      "RLE=0,0,0,0,0,0,0,inf,inf,inf,inf,inf,inf,inf,2,0,0,0,0,0,0,0;"
+      "Trivial=0,0,0,0,0,0,0,inf,inf,inf,inf,inf,inf,inf,3,0,0,0,0,0,0,0");
+  ASSERT_EQ(2, merged.trees().size());
+  EXPECT_EQ(nimble::EncodingType::Trivial, merged.trees()[0].first);
+  EXPECT_EQ(2, merged.trees()[0].second.size());
+  EXPECT_EQ(nimble::EncodingType::RLE, merged.trees()[1].first);
+  EXPECT_EQ(1, merged.trees()[1].second.size());
+}
+
+TEST(EncodingPredictionModelTests, Train) {
+  std::mt19937 rng{42};
+  const auto trainingSamples = generateSamples(rng, 2000);
+  const auto testSamples = generateSamples(rng, 2000);
+
+  auto model = nimble::EncodingPredictionModel::train(trainingSamples);
+  // One constant tree, plus one tree per boosting round, for each of the four
+  // labeled encodings.
+  const nimble::EncodingTrainingOptions options;
+  ASSERT_EQ(4, model.trees().size());
+  for (const auto& [encodingType, trees] : model.trees()) {
+    EXPECT_EQ(1 + options.roundCount, trees.size());
+  }
+
+  uint32_t correct = 0;
+  for (const auto& sample : testSamples) {
+    correct +=
+        model.predict(sample.features, kAnyEncoding) == sample.encodingType;
+  }
+  EXPECT_GT(correct, testSamples.size() * 0.95);
+
+  // The trained model round trips through serialization, and the parsed model
+  // makes the same predictions.
+  auto serialized = model.serialize();
+  auto parsed = nimble::EncodingPredictionModel::parse(serialized);
+  EXPECT_EQ(serialized, parsed.serialize());
+  for (const auto& sample : testSamples) {
+    EXPECT_EQ(
+        model.predict(sample.features, kAnyEncoding),
+        parsed.predict(sample.features, kAnyEncoding));
+  }
+
+  // Disallowed encodings are never predicted.
+  for (const auto& sample : testSamples) {
+    EXPECT_NE(
+        nimble::EncodingType::RLE,
+        model.predict(sample.features, [](nimble::EncodingType encodingType) {
+          return encodingType != nimble::EncodingType::RLE;
+        }));
+  }
+}
+
+TEST(EncodingPredictionModelTests, TrainSingleEncoding) {
+  std::vector<nimble::EncodingTrainingSample> samples{
+      {.encodingType = nimble::EncodingType::Trivial, .features = {}},
+      {.encodingType = nimble::EncodingType::Trivial, .features = {}},
+  };
+  auto model = nimble::EncodingPredictionModel::train(samples);
+  ASSERT_EQ(1, model.trees().size());
+  EXPECT_EQ(
+      nimble::EncodingType::Trivial,
+      model.predict(samples[0].features, kAnyEncoding));
+
+  EXPECT_THROW(
+      nimble::EncodingPredictionModel::train({}), nimble::NimbleUserError);
+}
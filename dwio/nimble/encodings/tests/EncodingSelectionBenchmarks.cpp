@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+
+#include "dwio/nimble/encodings/EncodingSelectionPolicy.h"
+#include "folly/Benchmark.h"
+#include "folly/Random.h"
+#include "folly/init/Init.h"
+
+using namespace ::facebook;
+
+constexpr size_t kDataSize = 1024 * 1024; // 1M
+constexpr size_t kMaxRunLength = 64;
+constexpr size_t kDictionarySize = 1000;
+
+std::vector<uint32_t> uniqueData;
+std::vector<uint32_t> dictionaryData;
+std::vector<uint32_t> runData;
+
+// Measures the time it takes to select an encoding for the data, including
+// computing the statistics the policy needs.
+template <typename Policy>
+void select(Policy& policy, const std::vector<uint32_t>& data) {
+  auto statistics = nimble::Statistics<uint32_t>::create(data);
+  folly::doNotOptimizeAway(policy.select(data, statistics).encodingType);
+}
+
+nimble::ManualEncodingSelectionPolicy<uint32_t> manualPolicy{
+    nimble::ManualEncodingSelectionPolicyFactory::defaultReadFactors(),
+    nimble::CompressionOptions{},
+    std::nullopt};
+nimble::LearnedEncodingSelectionPolicy<uint32_t> learnedPolicy;
+
+BENCHMARK(ManualUnique, n) {
+  for (int i = 0; i < n; ++i) {
+    select(manualPolicy, uniqueData);
+  }
+}
+
+BENCHMARK_RELATIVE(LearnedUnique, n) {
+  for (int i = 0; i < n; ++i) {
+    select(learnedPolicy, uniqueData);
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(ManualDictionary, n) {
+  for (int i = 0; i < n; ++i) {
+    select(manualPolicy, dictionaryData);
+  }
+}
+
+BENCHMARK_RELATIVE(LearnedDictionary, n) {
+  for (int i = 0; i < n; ++i) {
+    select(learnedPolicy, dictionaryData);
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(ManualRuns, n) {
+  for (int i = 0; i < n; ++i) {
+    select(manualPolicy, runData);
+  }
+}
+
+BENCHMARK_RELATIVE(LearnedRuns, n) {
+  for (int i = 0; i < n; ++i) {
+    select(learnedPolicy, runData);
+  }
+}
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  uniqueData.resize(kDataSize);
+  dictionaryData.resize(kDataSize);
+  runData.reserve(kDataSize);
+  std::vector<uint32_t> dictionary(kDictionarySize);
+  for (auto& value : dictionary) {
+    value = folly::Random::rand32();
+  }
+  for (auto i = 0; i < kDataSize; ++i) {
+    uniqueData[i] = folly::Random::rand32();
+    dictionaryData[i] = dictionary[folly::Random::rand32(kDictionarySize)];
+  }
+  while (runData.size() < kDataSize) {
+    const auto value = folly::Random::rand32();
+    auto runLength = 1 + folly::Random::rand32(kMaxRunLength);
+    while (runLength-- > 0 && runData.size() < kDataSize) {
+      runData.push_back(value);
+    }
+  }
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -28,7 +28,8 @@ using namespace ::facebook;
 namespace {
 template <typename T, bool FixedByteWidth = false>
 std::unique_ptr<nimble::ManualEncodingSelectionPolicy<T, FixedByteWidth>>
-getRootManualSelectionPolicy() {
+getRootManualSelectionPolicy(
+    nimble::EncodingSelectionOptions selectionOptions = {}) {
   return std::make_unique<
       nimble::ManualEncodingSelectionPolicy<T, FixedByteWidth>>(
       std::vector<std::pair<nimble::EncodingType, float>>{
@@ -47,7 +48,8 @@ getRootManualSelectionPolicy() {
           .internalDecompressionLevel = 2,
           .useVariableBitWidthCompressor = false,
       },
-      std::nullopt);
+      std::nullopt,
+      std::move(selectionOptions));
 }
 } // namespace
 
@@ -104,9 +106,12 @@ typename nimble::TypeTraits<T>::physicalType asPhysicalType(T value) {
 }
 
 template <typename T>
-void test(std::span<const T> values, std::vector<EncodingDetails> expected) {
+void test(
+    std::span<const T> values,
+    std::vector<EncodingDetails> expected,
+    nimble::EncodingSelectionOptions selectionOptions = {}) {
   auto pool = facebook::velox::memory::deprecatedAddDefaultLeafMemoryPool();
-  auto policy = getRootManualSelectionPolicy<T>();
+  auto policy = getRootManualSelectionPolicy<T>(std::move(selectionOptions));
   nimble::Buffer buffer{*pool};
 
   auto serialized =
@@ -331,6 +336,58 @@ TYPED_TEST(EncodingSelectionNumericTests, SelectFixedBitWidth) {
   }
 }
 
+TYPED_TEST(EncodingSelectionNumericTests, SelectReadCostAware) {
+  using T = TypeParam;
+
+  auto seed = folly::Random::rand32();
+  LOG(INFO) << "seed: " << seed;
+  std::mt19937 rng(seed);
+
+  // Make decoding all encodings, except Trivial, very expensive.
+  auto readCostModel = std::make_shared<nimble::ReadCostModel>();
+  for (auto encodingType :
+       {nimble::EncodingType::Constant,
+        nimble::EncodingType::FixedBitWidth,
+        nimble::EncodingType::MainlyConstant,
+        nimble::EncodingType::Dictionary,
+        nimble::EncodingType::RLE,
+        nimble::EncodingType::Varint}) {
+    readCostModel->setCost(
+        encodingType, nimble::TypeTraits<T>::dataType, 64, 100.0f);
+  }
+  readCostModel->setCost(
+      nimble::EncodingType::Trivial, nimble::TypeTraits<T>::dataType, 64, 1.0f);
+
+  std::vector<T> values;
+  values.resize(10000);
+  for (auto i = 0; i < values.size(); ++i) {
+    auto random = folly::Random::rand64(rng) % 16;
+    values[i] = *reinterpret_cast<const T*>(&random);
+  }
+
+  // With zero read cost weight, the model is ignored, and the data is bit
+  // packed.
+  test<T>(
+      values,
+      {
+          {.encodingType = nimble::EncodingType::FixedBitWidth,
+           .dataType = nimble::TypeTraits<T>::dataType,
+           .level = 0,
+           .nestedEncodingName = ""},
+      },
+      {.readCostModel = readCostModel});
+
+  test<T>(
+      values,
+      {
+          {.encodingType = nimble::EncodingType::Trivial,
+           .dataType = nimble::TypeTraits<T>::dataType,
+           .level = 0,
+           .nestedEncodingName = ""},
+      },
+      {.readCostModel = readCostModel, .readCostWeight = 1.0f});
+}
+
 TYPED_TEST(EncodingSelectionNumericTests, SelectDictionary) {
   using T = TypeParam;
 
@@ -366,6 +423,197 @@ TYPED_TEST(EncodingSelectionNumericTests, SelectDictionary) {
       });
 }
 
+TYPED_TEST(EncodingSelectionNumericTests, SelectApproximate) {
+  using T = TypeParam;
+
+  auto seed = folly::Random::rand32();
+  LOG(INFO) << "seed: " << seed;
+  std::mt19937 rng(seed);
+
+  // Force approximate statistics on all streams.
+  const nimble::EncodingSelectionOptions selectionOptions{
+      .approximateStatisticsThreshold = 1};
+
+  std::vector<T> values;
+  values.resize(10000);
+  for (auto i = 0; i < values.size(); ++i) {
+    auto random = folly::Random::rand64(rng);
+    values[i] = *reinterpret_cast<const T*>(&random);
+  }
+
+  test<T>(
+      values,
+      {
+          {.encodingType = nimble::EncodingType::Trivial,
+           .dataType = nimble::TypeTraits<T>::dataType,
+           .level = 0,
+           .nestedEncodingName = ""},
+      },
+      selectionOptions);
+
+  // Dictionary is a close winner, so selection falls back to exact
+  // statistics.
+  std::array<T, 3> uniqueValues{
+      std::numeric_limits<T>::min(), 0, std::numeric_limits<T>::max()};
+  for (auto i = 0; i < values.size(); ++i) {
+    values[i] = uniqueValues[folly::Random::rand32(rng) % uniqueValues.size()];
+  }
+
+  test<T>(
+      values,
+      {
+          {.encodingType = nimble::EncodingType::Dictionary,
+           .dataType = nimble::TypeTraits<T>::dataType,
+           .level = 0,
+           .nestedEncodingName = ""},
+          {.encodingType = nimble::EncodingType::Trivial,
+           .dataType = nimble::TypeTraits<
+               typename nimble::EncodingPhysicalType<T>::type>::dataType,
+           .level = 1,
+           .nestedEncodingName = "Alphabet"},
+          {.encodingType = nimble::EncodingType::FixedBitWidth,
+           .dataType = nimble::DataType::Uint32,
+           .level = 1,
+           .nestedEncodingName = "Indices"},
+      },
+      selectionOptions);
+}
+
+TYPED_TEST(EncodingSelectionNumericTests, SelectSampled) {
+  using T = TypeParam;
+
+  auto seed = folly::Random::rand32();
+  LOG(INFO) << "seed: " << seed;
+  std::mt19937 rng(seed);
+
+  auto pool = facebook::velox::memory::deprecatedAddDefaultLeafMemoryPool();
+  for (auto* trialEncodingPool : {(velox::memory::MemoryPool*)nullptr,
+                                  pool.get()}) {
+    // Sample all streams larger than the sample itself.
+    const nimble::EncodingSelectionOptions selectionOptions{
+        .samplingThreshold = 1,
+        .sampleSliceCount = 4,
+        .sampleSliceSize = 1000,
+        .trialEncodingPool = trialEncodingPool,
+    };
+
+    std::vector<T> values;
+    values.resize(100000);
+    for (auto i = 0; i < values.size(); ++i) {
+      auto random = folly::Random::rand64(rng);
+      values[i] = *reinterpret_cast<const T*>(&random);
+    }
+
+    test<T>(
+        values,
+        {
+            {.encodingType = nimble::EncodingType::Trivial,
+             .dataType = nimble::TypeTraits<T>::dataType,
+             .level = 0,
+             .nestedEncodingName = ""},
+        },
+        selectionOptions);
+
+    std::array<T, 3> uniqueValues{
+        std::numeric_limits<T>::min(), 0, std::numeric_limits<T>::max()};
+    for (auto i = 0; i < values.size(); ++i) {
+      values[i] =
+          uniqueValues[folly::Random::rand32(rng) % uniqueValues.size()];
+    }
+
+    test<T>(
+        values,
+        {
+            {.encodingType = nimble::EncodingType::Dictionary,
+             .dataType = nimble::TypeTraits<T>::dataType,
+             .level = 0,
+             .nestedEncodingName = ""},
+            {.encodingType = nimble::EncodingType::Trivial,
+             .dataType = nimble::TypeTraits<
+                 typename nimble::EncodingPhysicalType<T>::type>::dataType,
+             .level = 1,
+             .nestedEncodingName = "Alphabet"},
+            {.encodingType = nimble::EncodingType::FixedBitWidth,
+             .dataType = nimble::DataType::Uint32,
+             .level = 1,
+             .nestedEncodingName = "Indices"},
+        },
+        selectionOptions);
+
+    // Constant streams are never sampled.
+    std::fill(values.begin(), values.end(), uniqueValues[0]);
+    test<T>(
+        values,
+        {
+            {.encodingType = nimble::EncodingType::Constant,
+             .dataType = nimble::TypeTraits<T>::dataType,
+             .level = 0,
+             .nestedEncodingName = ""},
+        },
+        selectionOptions);
+  }
+}
+
+TYPED_TEST(EncodingSelectionNumericTests, SelectLearned) {
+  using T = TypeParam;
+
+  auto seed = folly::Random::rand32();
+  LOG(INFO) << "seed: " << seed;
+  std::mt19937 rng(seed);
+
+  auto pool = facebook::velox::memory::deprecatedAddDefaultLeafMemoryPool();
+  nimble::Buffer buffer{*pool};
+
+  auto verifyPrediction = [&](const std::vector<T>& values,
+                              nimble::EncodingType expected) {
+    auto serialized = nimble::EncodingFactory::encode<T>(
+        std::make_unique<nimble::LearnedEncodingSelectionPolicy<T>>(),
+        values,
+        buffer);
+    EXPECT_EQ(
+        expected,
+        nimble::EncodingFactory::decode(*pool, serialized)->encodingType());
+  };
+
+  std::vector<T> values(10000);
+  for (auto i = 0; i < values.size(); ++i) {
+    auto random = folly::Random::rand64(rng);
+    values[i] = *reinterpret_cast<const T*>(&random);
+  }
+  verifyPrediction(values, nimble::EncodingType::Trivial);
+
+  for (auto i = 0; i < values.size(); ++i) {
+    auto random = folly::Random::rand64(rng) % 16;
+    values[i] = *reinterpret_cast<const T*>(&random);
+  }
+  verifyPrediction(values, nimble::EncodingType::FixedBitWidth);
+
+  std::array<T, 3> uniqueValues{
+      std::numeric_limits<T>::min(), 0, std::numeric_limits<T>::max()};
+  for (auto i = 0; i < values.size(); ++i) {
+    values[i] = uniqueValues[folly::Random::rand32(rng) % uniqueValues.size()];
+  }
+  verifyPrediction(values, nimble::EncodingType::Dictionary);
+
+  for (auto i = 0; i < values.size(); ++i) {
+    values[i] = folly::Random::oneIn(20, rng) ? uniqueValues[0] : 1;
+  }
+  verifyPrediction(values, nimble::EncodingType::MainlyConstant);
+
+  values.clear();
+  while (values.size() < 10000) {
+    auto random = folly::Random::rand64(rng);
+    const auto value = *reinterpret_cast<const T*>(&random);
+    const auto runLength = std::min<size_t>(
+        50 + folly::Random::rand32(50, rng), 10000 - values.size());
+    values.insert(values.end(), runLength, value);
+  }
+  verifyPrediction(values, nimble::EncodingType::RLE);
+
+  std::fill(values.begin(), values.end(), uniqueValues[2]);
+  verifyPrediction(values, nimble::EncodingType::Constant);
+}
+
 TYPED_TEST(EncodingSelectionNumericTests, SelectRunLength) {
   using T = TypeParam;
 
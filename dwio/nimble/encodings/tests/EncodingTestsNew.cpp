@@ -34,6 +34,7 @@
 #include "dwio/nimble/encodings/MainlyConstantEncoding.h"
 #include "dwio/nimble/encodings/RleEncoding.h"
 #include "dwio/nimble/encodings/SparseBoolEncoding.h"
+#include "dwio/nimble/encodings/StreamVByteEncoding.h"
 #include "dwio/nimble/encodings/TrivialEncoding.h"
 #include "dwio/nimble/encodings/VarintEncoding.h"
 #include "folly/Random.h"
@@ -195,10 +196,25 @@ class EncodingTests : public ::testing::Test {
         nimble::EncodingType::Varint;
   };
 
+  template <>
+  struct EncodingTypeTraits<nimble::StreamVByteEncoding<E>> {
+    static inline nimble::EncodingType encodingType =
+        nimble::EncodingType::StreamVByte;
+  };
+
   std::unique_ptr<nimble::Encoding> createEncoding(
       const nimble::Vector<E>& values,
       bool compress,
       bool useVariableBitWidthCompressor) {
+    return std::make_unique<C>(
+        *this->pool_,
+        encode(values, compress, useVariableBitWidthCompressor));
+  }
+
+  std::string_view encode(
+      const nimble::Vector<E>& values,
+      bool compress,
+      bool useVariableBitWidthCompressor) {
     using physicalType = typename nimble::TypeTraits<E>::physicalType;
     auto physicalValues = std::span<const physicalType>(
         reinterpret_cast<const physicalType*>(values.data()), values.size());
@@ -213,8 +229,7 @@ class EncodingTests : public ::testing::Test {
         std::make_unique<TestTrivialEncodingSelectionPolicy<E>>(
             compress, useVariableBitWidthCompressor)};
 
-    auto encoded = C::encode(selection, physicalValues, *buffer_);
-    return std::make_unique<C>(*this->pool_, encoded);
+    return C::encode(selection, physicalValues, *buffer_);
   }
 
   // Each unit test runs on randomized data this many times before
@@ -231,6 +246,9 @@ class EncodingTests : public ::testing::Test {
   std::unique_ptr<nimble::testing::Util> util_;
 };
 
+#define STREAM_VBYTE_TYPES(EncodingName) \
+  EncodingName<int32_t>, EncodingName<uint32_t>, EncodingName<float>
+
 #define VARINT_TYPES(EncodingName)                                      \
   EncodingName<int32_t>, EncodingName<int64_t>, EncodingName<uint32_t>, \
       EncodingName<uint64_t>, EncodingName<float>, EncodingName<double>
@@ -247,6 +265,7 @@ class EncodingTests : public ::testing::Test {
 using TestTypes = ::testing::Types<
     nimble::SparseBoolEncoding,
     VARINT_TYPES(nimble::VarintEncoding),
+    STREAM_VBYTE_TYPES(nimble::StreamVByteEncoding),
     NUMERIC_TYPES(nimble::FixedBitWidthEncoding),
     NON_BOOL_TYPES(nimble::DictionaryEncoding),
     NON_BOOL_TYPES(nimble::MainlyConstantEncoding),
@@ -338,6 +357,58 @@ TYPED_TEST(EncodingTests, Materialize) {
   }
 }
 
+TYPED_TEST(EncodingTests, Reinitialize) {
+  auto seed = folly::Random::rand32();
+  LOG(INFO) << "seed: " << seed;
+  std::mt19937 rng(seed);
+
+  using E = typename TypeParam::cppDataType;
+
+  for (int run = 0; run < this->kNumRandomRuns; ++run) {
+    const std::vector<nimble::Vector<E>> dataPatterns =
+        this->util_->template makeDataPatterns<E>(
+            rng, this->kMaxRows, this->buffer_.get());
+    for (auto compress : {false, true}) {
+      // Each pattern is decoded by re-initializing the encoding of the
+      // previous one.
+      std::unique_ptr<nimble::Encoding> encoding;
+      for (const auto& data : dataPatterns) {
+        const int rowCount = data.size();
+        std::string_view encoded;
+        try {
+          encoded = this->encode(data, compress, false);
+        } catch (const nimble::NimbleUserError& e) {
+          if (e.errorCode() == nimble::error_code::IncompatibleEncoding) {
+            continue;
+          }
+          throw;
+        }
+        const auto* previous = encoding.get();
+        encoding = nimble::EncodingFactory::decode(
+            *this->pool_, encoded, std::move(encoding));
+        if (previous != nullptr) {
+          ASSERT_EQ(previous, encoding.get());
+        }
+        ASSERT_EQ(rowCount, encoding->rowCount());
+
+        nimble::Vector<E> buffer(this->pool_.get(), rowCount);
+        encoding->materialize(rowCount, buffer.data());
+        for (int i = 0; i < rowCount; ++i) {
+          ASSERT_EQ(buffer[i], data[i]) << "i: " << i;
+        }
+
+        const int offset = rowCount / 2;
+        encoding->reset();
+        encoding->skip(offset);
+        encoding->materialize(rowCount - offset, buffer.data());
+        for (int i = offset; i < rowCount; ++i) {
+          ASSERT_EQ(buffer[i - offset], data[i]) << "i: " << i;
+        }
+      }
+    }
+  }
+}
+
 template <typename T>
 void checkScatteredOutput(
     bool hasNulls,
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dwio/nimble/common/Bits.h"
+#include "dwio/nimble/common/Buffer.h"
+#include "dwio/nimble/encodings/EncodingFactory.h"
+#include "dwio/nimble/encodings/EncodingLayout.h"
+#include "dwio/nimble/encodings/EncodingSelectionPolicy.h"
+#include "folly/Benchmark.h"
+#include "folly/Random.h"
+#include "folly/init/Init.h"
+#include "velox/common/memory/Memory.h"
+
+using namespace ::facebook;
+
+// Measures batch decoding of common composite encoding trees (Dictionary and
+// Nullable over Trivial/FixedBitWidth children), whose nested encodings are
+// decoded through their concrete types (see NestedEncoding).
+
+constexpr uint32_t kRowCount = 1024 * 1024;
+constexpr uint32_t kBatchSize = 1024;
+constexpr uint32_t kNarrowBatchSize = 16;
+constexpr uint32_t kAlphabetSize = 1000;
+
+std::shared_ptr<velox::memory::MemoryPool> pool;
+std::vector<std::string> encoded;
+
+nimble::EncodingLayout layout(nimble::EncodingType encodingType) {
+  return {encodingType, nimble::CompressionType::Uncompressed};
+}
+
+nimble::EncodingLayout dictionary(nimble::EncodingType indicesType) {
+  return {
+      nimble::EncodingType::Dictionary,
+      nimble::CompressionType::Uncompressed,
+      {layout(nimble::EncodingType::Trivial), layout(indicesType)}};
+}
+
+// Encodes |kRowCount| values (with ~10% nulls if |nullable|), replaying
+// |expected|. Nulls are always trivially encoded.
+std::string encode(nimble::EncodingLayout expected, bool nullable) {
+  nimble::EncodingSelectionPolicyFactory encodingSelectionPolicyFactory =
+      [encodingFactory = nimble::ManualEncodingSelectionPolicyFactory{
+           {{nimble::EncodingType::Trivial, 1.0}}}](nimble::DataType dataType)
+      -> std::unique_ptr<nimble::EncodingSelectionPolicyBase> {
+    return encodingFactory.createPolicy(dataType);
+  };
+
+  std::vector<uint32_t> values;
+  auto nonNulls = std::make_unique<bool[]>(kRowCount);
+  values.reserve(kRowCount);
+  for (auto i = 0; i < kRowCount; ++i) {
+    nonNulls[i] = !nullable || !folly::Random::oneIn(10);
+    if (nonNulls[i]) {
+      values.push_back(folly::Random::rand32(kAlphabetSize));
+    }
+  }
+
+  auto policy =
+      std::make_unique<nimble::ReplayedEncodingSelectionPolicy<uint32_t>>(
+          std::move(expected),
+          nimble::CompressionOptions{.compressionAcceptRatio = 100},
+          encodingSelectionPolicyFactory);
+  nimble::Buffer buffer{*pool};
+  auto result = nullable
+      ? nimble::EncodingFactory::encodeNullable<uint32_t>(
+            std::move(policy),
+            values,
+            std::span<const bool>{nonNulls.get(), kRowCount},
+            buffer)
+      : nimble::EncodingFactory::encode<uint32_t>(
+            std::move(policy), values, buffer);
+  return std::string{result};
+}
+
+void decode(const std::string& data) {
+  auto encoding = nimble::EncodingFactory::decode(*pool, data);
+  std::vector<uint32_t> output(kBatchSize);
+  for (auto row = 0; row < kRowCount; row += kBatchSize) {
+    encoding->materialize(kBatchSize, output.data());
+    folly::doNotOptimizeAway(output);
+  }
+}
+
+// Nullable decoding in narrow batches, where the per batch cost of the nulls
+// callback dominates. Compares passing a lambda (referenced without allocation
+// through folly::FunctionRef) against a std::function, as callers used to.
+template <bool useStdFunction>
+void decodeNullableNarrow(const std::string& data) {
+  auto encoding = nimble::EncodingFactory::decode(*pool, data);
+  std::vector<uint32_t> output(kNarrowBatchSize);
+  std::vector<char> nulls(nimble::bits::bytesRequired(kNarrowBatchSize));
+  auto lambda = [&]() -> void* { return nulls.data(); };
+  for (auto row = 0; row < kRowCount; row += kNarrowBatchSize) {
+    if constexpr (useStdFunction) {
+      std::function<void*()> function = lambda;
+      folly::doNotOptimizeAway(encoding->materializeNullable(
+          kNarrowBatchSize, output.data(), function));
+    } else {
+      folly::doNotOptimizeAway(encoding->materializeNullable(
+          kNarrowBatchSize, output.data(), lambda));
+    }
+  }
+}
+
+BENCHMARK(Trivial) {
+  decode(encoded[0]);
+}
+
+BENCHMARK(DictionaryTrivialIndices) {
+  decode(encoded[1]);
+}
+
+BENCHMARK(DictionaryFixedBitWidthIndices) {
+  decode(encoded[2]);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(NullableTrivial) {
+  decode(encoded[3]);
+}
+
+BENCHMARK(NullableFixedBitWidth) {
+  decode(encoded[4]);
+}
+
+BENCHMARK(NullableDictionary) {
+  decode(encoded[5]);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(NullableNarrowStdFunction) {
+  decodeNullableNarrow<true>(encoded[3]);
+}
+
+BENCHMARK_RELATIVE(NullableNarrowFunctionRef) {
+  decodeNullableNarrow<false>(encoded[3]);
+}
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  pool = velox::memory::deprecatedAddDefaultLeafMemoryPool();
+  encoded = {
+      encode(layout(nimble::EncodingType::Trivial), false),
+      encode(dictionary(nimble::EncodingType::Trivial), false),
+      encode(dictionary(nimble::EncodingType::FixedBitWidth), false),
+      encode(layout(nimble::EncodingType::Trivial), true),
+      encode(layout(nimble::EncodingType::FixedBitWidth), true),
+      encode(dictionary(nimble::EncodingType::FixedBitWidth), true),
+  };
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include "dwio/nimble/common/Exceptions.h"
+#include "dwio/nimble/encodings/ReadCostModel.h"
+
+using namespace ::facebook;
+
+TEST(ReadCostModelTests, Lookup) {
+  nimble::ReadCostModel model;
+  EXPECT_TRUE(model.empty());
+  EXPECT_FALSE(model
+                   .cost(
+                       nimble::EncodingType::Trivial,
+                       nimble::DataType::Int32,
+                       /* bitWidth */ 8)
+                   .has_value());
+
+  model.setCost(
+      nimble::EncodingType::FixedBitWidth, nimble::DataType::Int32, 4, 1.0f);
+  model.setCost(
+      nimble::EncodingType::FixedBitWidth, nimble::DataType::Int32, 16, 2.0f);
+  model.setCost(
+      nimble::EncodingType::Trivial, nimble::DataType::String, 0, 3.0f);
+  EXPECT_FALSE(model.empty());
+
+  auto cost = [&](nimble::EncodingType encodingType,
+                  nimble::DataType dataType,
+                  uint32_t bitWidth) {
+    return model.cost(encodingType, dataType, bitWidth);
+  };
+
+  // Exact match.
+  EXPECT_EQ(
+      1.0f,
+      cost(nimble::EncodingType::FixedBitWidth, nimble::DataType::Int32, 4));
+  EXPECT_EQ(
+      2.0f,
+      cost(nimble::EncodingType::FixedBitWidth, nimble::DataType::Int32, 16));
+  // Closest wider measurement.
+  EXPECT_EQ(
+      1.0f,
+      cost(nimble::EncodingType::FixedBitWidth, nimble::DataType::Int32, 1));
+  EXPECT_EQ(
+      2.0f,
+      cost(nimble::EncodingType::FixedBitWidth, nimble::DataType::Int32, 5));
+  // Widest measurement.
+  EXPECT_EQ(
+      2.0f,
+      cost(nimble::EncodingType::FixedBitWidth, nimble::DataType::Int32, 32));
+  EXPECT_EQ(
+      3.0f, cost(nimble::EncodingType::Trivial, nimble::DataType::String, 0));
+  // Missing measurements.
+  EXPECT_FALSE(
+      cost(nimble::EncodingType::FixedBitWidth, nimble::DataType::Int64, 4)
+          .has_value());
+  EXPECT_FALSE(cost(nimble::EncodingType::Trivial, nimble::DataType::Int32, 4)
+                   .has_value());
+  EXPECT_FALSE(cost(nimble::EncodingType::RLE, nimble::DataType::String, 0)
+                   .has_value());
+}
+
+TEST(ReadCostModelTests, Serialization) {
+  nimble::ReadCostModel model;
+  model.setCost(
+      nimble::EncodingType::FixedBitWidth, nimble::DataType::Uint64, 7, 1.5f);
+  model.setCost(
+      nimble::EncodingType::Dictionary, nimble::DataType::String, 0, 4.25f);
+
+  auto serialized = model.serialize();
+  EXPECT_EQ("Dictionary:String:0=4.25;FixedBitWidth:Uint64:7=1.5", serialized);
+
+  auto parsed = nimble::ReadCostModel::parse(serialized);
+  EXPECT_EQ(serialized, parsed.serialize());
+  EXPECT_EQ(
+      1.5f,
+      parsed.cost(
+          nimble::EncodingType::FixedBitWidth, nimble::DataType::Uint64, 7));
+
+  EXPECT_TRUE(nimble::ReadCostModel::parse("").empty());
+  EXPECT_THROW(
+      nimble::ReadCostModel::parse("Trivial:Int32=1.0"),
+      nimble::NimbleUserError);
+  EXPECT_THROW(
+      nimble::ReadCostModel::parse("Trivial:Int32:8=abc"),
+      nimble::NimbleUserError);
+  EXPECT_THROW(
+      nimble::ReadCostModel::parse("Unknown:Int32:8=1.0"),
+      nimble::NimbleUserError);
+  EXPECT_THROW(
+      nimble::ReadCostModel::parse("Trivial:Unknown:8=1.0"),
+      nimble::NimbleUserError);
+}
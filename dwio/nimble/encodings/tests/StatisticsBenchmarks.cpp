@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "dwio/nimble/encodings/Statistics.h"
+#include "folly/Benchmark.h"
+#include "folly/Random.h"
+#include "folly/init/Init.h"
+
+using namespace ::facebook;
+
+constexpr size_t kDataSize = 4 * 1024 * 1024; // 4M
+constexpr size_t kMaxRunLength = 16;
+
+std::vector<uint32_t> uniqueData;
+std::vector<uint32_t> runData;
+std::vector<uint32_t> constantData;
+
+// Reference implementation, computing min/max and repeats in separate passes
+// (this is how Statistics used to compute them).
+template <typename T>
+void separatePasses(const std::vector<T>& data) {
+  const auto [min, max] = std::minmax_element(data.begin(), data.end());
+  folly::doNotOptimizeAway(*min);
+  folly::doNotOptimizeAway(*max);
+
+  uint64_t consecutiveRepeatCount = 0;
+  uint64_t minRepeat = std::numeric_limits<uint64_t>::max();
+  uint64_t maxRepeat = 0;
+  T currentValue = data[0];
+  uint64_t currentRepeat = 0;
+  for (auto i = 0; i < data.size(); ++i) {
+    if (data[i] == currentValue) {
+      ++currentRepeat;
+    } else {
+      maxRepeat = std::max(maxRepeat, currentRepeat);
+      minRepeat = std::min(minRepeat, currentRepeat);
+      currentRepeat = 1;
+      currentValue = data[i];
+      ++consecutiveRepeatCount;
+    }
+  }
+  maxRepeat = std::max(maxRepeat, currentRepeat);
+  minRepeat = std::min(minRepeat, currentRepeat);
+  folly::doNotOptimizeAway(consecutiveRepeatCount + 1);
+  folly::doNotOptimizeAway(minRepeat);
+  folly::doNotOptimizeAway(maxRepeat);
+}
+
+template <typename T>
+void fused(const std::vector<T>& data) {
+  auto statistics = nimble::Statistics<T>::create(data);
+  folly::doNotOptimizeAway(statistics.min());
+  folly::doNotOptimizeAway(statistics.max());
+  folly::doNotOptimizeAway(statistics.consecutiveRepeatCount());
+  folly::doNotOptimizeAway(statistics.minRepeat());
+  folly::doNotOptimizeAway(statistics.maxRepeat());
+}
+
+BENCHMARK(SeparatePassesUnique, n) {
+  for (int i = 0; i < n; ++i) {
+    separatePasses(uniqueData);
+  }
+}
+
+BENCHMARK_RELATIVE(FusedUnique, n) {
+  for (int i = 0; i < n; ++i) {
+    fused(uniqueData);
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(SeparatePassesRuns, n) {
+  for (int i = 0; i < n; ++i) {
+    separatePasses(runData);
+  }
+}
+
+BENCHMARK_RELATIVE(FusedRuns, n) {
+  for (int i = 0; i < n; ++i) {
+    fused(runData);
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(SeparatePassesConstant, n) {
+  for (int i = 0; i < n; ++i) {
+    separatePasses(constantData);
+  }
+}
+
+BENCHMARK_RELATIVE(FusedConstant, n) {
+  for (int i = 0; i < n; ++i) {
+    fused(constantData);
+  }
+}
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  uniqueData.resize(kDataSize);
+  runData.reserve(kDataSize);
+  constantData.resize(kDataSize, 7);
+  for (auto i = 0; i < kDataSize; ++i) {
+    uniqueData[i] = folly::Random::rand32();
+  }
+  while (runData.size() < kDataSize) {
+    const auto value = folly::Random::rand32();
+    auto runLength = 1 + folly::Random::rand32(kMaxRunLength);
+    while (runLength-- > 0 && runData.size() < kDataSize) {
+      runData.push_back(value);
+    }
+  }
+
+  folly::runBenchmarks();
+  return 0;
+}
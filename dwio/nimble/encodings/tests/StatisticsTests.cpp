@@ -16,6 +16,7 @@
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <limits>
+#include <random>
 #include <string_view>
 #include <type_traits>
 
@@ -246,6 +247,14 @@ void verifyString(
         statistics.uniqueCounts().at(std::string(i + 1, 'a' + i)),
         currentRepeat--);
   }
+
+  EXPECT_EQ(
+      statistics.uniqueCounts().size(),
+      statistics.approximateUniqueCounts().size());
+  EXPECT_EQ(
+      std::string(1, 'a'),
+      statistics.approximateUniqueCounts().mostCommonValue());
+  EXPECT_EQ(maxRepeat, statistics.approximateUniqueCounts().mostCommonCount());
 }
 
 TYPED_TEST(StatisticsStringTests, Create) {
@@ -306,6 +315,14 @@ TYPED_TEST(StatisticsStringTests, Create) {
         statistics.uniqueCounts().at(std::string(i + 1, 'a' + i)),
         currentRepeat--);
   }
+
+  EXPECT_EQ(
+      statistics.uniqueCounts().size(),
+      statistics.approximateUniqueCounts().size());
+  EXPECT_EQ(
+      std::string(1, 'a'),
+      statistics.approximateUniqueCounts().mostCommonValue());
+  EXPECT_EQ(maxRepeat, statistics.approximateUniqueCounts().mostCommonCount());
 }
 
 TYPED_TEST(StatisticsNumericTests, Repeat) {
@@ -347,6 +364,105 @@ TYPED_TEST(StatisticsNumericTests, Repeat) {
   }
 }
 
+TYPED_TEST(StatisticsIntegerTests, LargeRuns) {
+  using T = TypeParam;
+  using ValueType = typename T::valueType;
+
+  // Data sizes are chosen to exercise fully repeating blocks, fully unique
+  // blocks, mixed blocks and partial tail blocks in the statistics kernel.
+  std::mt19937 rng{1234};
+  for (auto maxRunLength : {1, 2, 7, 64, 65, 200}) {
+    for (auto dataSize : {1, 63, 64, 65, 129, 1000, 4097}) {
+      std::vector<ValueType> data;
+      data.reserve(dataSize);
+      while (data.size() < dataSize) {
+        const auto value = static_cast<ValueType>(rng());
+        const auto runLength = 1 + rng() % maxRunLength;
+        for (auto i = 0; i < runLength && data.size() < dataSize; ++i) {
+          data.push_back(value);
+        }
+      }
+
+      uint64_t expectedConsecutiveRepeatCount = 0;
+      uint64_t expectedMinRepeat = std::numeric_limits<uint64_t>::max();
+      uint64_t expectedMaxRepeat = 0;
+      uint64_t currentRepeat = 0;
+      for (auto i = 0; i < data.size(); ++i) {
+        ++currentRepeat;
+        if (i + 1 == data.size() || data[i] != data[i + 1]) {
+          ++expectedConsecutiveRepeatCount;
+          expectedMinRepeat = std::min(expectedMinRepeat, currentRepeat);
+          expectedMaxRepeat = std::max(expectedMaxRepeat, currentRepeat);
+          currentRepeat = 0;
+        }
+      }
+
+      auto statistics = T::create({data});
+      EXPECT_EQ(
+          *std::min_element(data.begin(), data.end()), statistics.min());
+      EXPECT_EQ(
+          *std::max_element(data.begin(), data.end()), statistics.max());
+      EXPECT_EQ(
+          expectedConsecutiveRepeatCount, statistics.consecutiveRepeatCount());
+      EXPECT_EQ(expectedMinRepeat, statistics.minRepeat());
+      EXPECT_EQ(expectedMaxRepeat, statistics.maxRepeat());
+    }
+  }
+}
+
+TYPED_TEST(StatisticsNumericTests, ApproximateUniques) {
+  using T = TypeParam;
+  using ValueType = typename T::valueType;
+
+  constexpr auto dataSize = 20000;
+  // Keep distinct values representable in all types (including int8).
+  constexpr auto uniqueValues = 100;
+  const ValueType commonValue = 7;
+
+  std::mt19937 rng{1234};
+  std::vector<ValueType> data;
+  data.reserve(dataSize);
+  for (auto i = 0; i < dataSize; ++i) {
+    // Half of the values are the common value.
+    data.push_back(
+        i % 2 == 0 ? commonValue
+                   : static_cast<ValueType>(rng() % uniqueValues + 10));
+  }
+
+  auto statistics = T::create({data});
+  const auto& approximate = statistics.approximateUniqueCounts();
+  const auto& exact = statistics.uniqueCounts();
+  EXPECT_NEAR(exact.size(), approximate.size(), exact.size() * 0.05);
+  EXPECT_EQ(commonValue, approximate.mostCommonValue());
+  EXPECT_EQ(exact.at(commonValue), approximate.mostCommonCount());
+
+  // Constant data
+  data.assign(dataSize, commonValue);
+  statistics = T::create({data});
+  EXPECT_EQ(1, statistics.approximateUniqueCounts().size());
+  EXPECT_EQ(
+      commonValue, statistics.approximateUniqueCounts().mostCommonValue());
+  EXPECT_EQ(dataSize, statistics.approximateUniqueCounts().mostCommonCount());
+}
+
+TYPED_TEST(StatisticsIntegerTests, ApproximateUniquesHighCardinality) {
+  using T = TypeParam;
+  using ValueType = typename T::valueType;
+
+  if constexpr (sizeof(ValueType) >= 4) {
+    constexpr auto dataSize = 200000;
+    std::vector<ValueType> data(dataSize);
+    for (auto i = 0; i < dataSize; ++i) {
+      data[i] = i;
+    }
+
+    auto statistics = T::create({data});
+    EXPECT_NEAR(
+        dataSize, statistics.approximateUniqueCounts().size(), dataSize * 0.05);
+    EXPECT_EQ(1, statistics.approximateUniqueCounts().mostCommonCount());
+  }
+}
+
 TYPED_TEST(StatisticsIntegerTests, Buckets) {
   using T = TypeParam;
   using ValueType = typename T::valueType;
@@ -13,16 +13,69 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <glog/logging.h>
+#include <zdict.h>
 #include <zstd.h>
 #include <zstd_errors.h>
 #include <optional>
+#include <string>
+#include <vector>
 
 #include "dwio/nimble/common/EncodingPrimitives.h"
 #include "dwio/nimble/common/Exceptions.h"
+#include "dwio/nimble/common/ZstdContext.h"
 #include "dwio/nimble/tablet/Compression.h"
 
 namespace facebook::nimble {
 
+ZstdDictionary::ZstdDictionary(
+    std::string content,
+    std::optional<int32_t> compressionLevel)
+    : content_{std::move(content)},
+      id_{ZSTD_getDictID_fromDict(content_.data(), content_.size())},
+      compressionDictionary_{nullptr, [](ZSTD_CDict* dictionary) {
+                               ZSTD_freeCDict(dictionary);
+                             }},
+      decompressionDictionary_{
+          ZSTD_createDDict(content_.data(), content_.size()),
+          [](ZSTD_DDict* dictionary) { ZSTD_freeDDict(dictionary); }} {
+  NIMBLE_CHECK(
+      decompressionDictionary_ != nullptr, "Invalid zstd dictionary.");
+  if (compressionLevel.has_value()) {
+    compressionDictionary_.reset(ZSTD_createCDict(
+        content_.data(), content_.size(), compressionLevel.value()));
+    NIMBLE_CHECK(
+        compressionDictionary_ != nullptr, "Invalid zstd dictionary.");
+  }
+}
+
+/* static */ std::optional<std::string> ZstdDictionary::train(
+    std::span<const std::string_view> samples,
+    uint32_t maxSize) {
+  std::string samplesBuffer;
+  std::vector<size_t> sampleSizes;
+  sampleSizes.reserve(samples.size());
+  for (const auto& sample : samples) {
+    samplesBuffer.append(sample);
+    sampleSizes.push_back(sample.size());
+  }
+
+  std::string dictionary(maxSize, '\0');
+  auto ret = ZDICT_trainFromBuffer(
+      dictionary.data(),
+      dictionary.size(),
+      samplesBuffer.data(),
+      sampleSizes.data(),
+      sampleSizes.size());
+  if (ZDICT_isError(ret)) {
+    VLOG(1) << "Unable to train zstd dictionary: " << ZDICT_getErrorName(ret);
+    return std::nullopt;
+  }
+
+  dictionary.resize(ret);
+  return dictionary;
+}
+
 std::optional<Vector<char>> ZstdCompression::compress(
     velox::memory::MemoryPool& memoryPool,
     std::string_view source,
@@ -30,7 +83,8 @@ std::optional<Vector<char>> ZstdCompression::compress(
   Vector<char> buffer{&memoryPool, source.size() + sizeof(uint32_t)};
   auto pos = buffer.data();
   encoding::writeUint32(source.size(), pos);
-  auto ret = ZSTD_compress(
+  auto ret = ZSTD_compressCCtx(
+      zstd::compressionContext(),
       pos,
       source.size() - sizeof(uint32_t),
       source.data(),
@@ -48,18 +102,81 @@ std::optional<Vector<char>> ZstdCompression::compress(
   return {buffer};
 }
 
+std::optional<Vector<char>> ZstdCompression::compress(
+    velox::memory::MemoryPool& memoryPool,
+    std::string_view source,
+    const ZstdDictionary& dictionary) {
+  NIMBLE_DASSERT(
+      dictionary.compressionDictionary_ != nullptr,
+      "Dictionary is not enabled for compression.");
+  Vector<char> buffer{&memoryPool, source.size() + sizeof(uint32_t)};
+  auto pos = buffer.data();
+  encoding::writeUint32(source.size(), pos);
+  auto ret = ZSTD_compress_usingCDict(
+      zstd::compressionContext(),
+      pos,
+      source.size(),
+      source.data(),
+      source.size(),
+      dictionary.compressionDictionary_.get());
+  if (ZSTD_isError(ret)) {
+    NIMBLE_ASSERT(
+        ZSTD_getErrorCode(ret) == ZSTD_ErrorCode::ZSTD_error_dstSize_tooSmall,
+        fmt::format(
+            "Error while compressing data: {}", ZSTD_getErrorName(ret)));
+    return std::nullopt;
+  }
+
+  buffer.resize(ret + sizeof(uint32_t));
+  return {std::move(buffer)};
+}
+
 Vector<char> ZstdCompression::uncompress(
     velox::memory::MemoryPool& memoryPool,
-    std::string_view source) {
+    std::string_view source,
+    const ZstdDictionary* dictionary) {
+  Vector<char> buffer{&memoryPool};
+  uncompress(source, buffer, dictionary);
+  return buffer;
+}
+
+void ZstdCompression::uncompress(
+    std::string_view source,
+    Vector<char>& output,
+    const ZstdDictionary* dictionary) {
   auto pos = source.data();
   const uint32_t uncompressedSize = encoding::readUint32(pos);
-  Vector<char> buffer{&memoryPool, uncompressedSize};
-  auto ret = ZSTD_decompress(
-      buffer.data(), buffer.size(), pos, source.size() - sizeof(uint32_t));
+  const auto compressedSize = source.size() - sizeof(uint32_t);
+  // Previous content is overwritten, so avoid copying it if we need to grow.
+  output.update_size(0);
+  output.resize(uncompressedSize);
+  size_t ret;
+  const auto dictionaryId = ZSTD_getDictID_fromFrame(pos, compressedSize);
+  if (dictionaryId != 0) {
+    NIMBLE_CHECK(
+        dictionary != nullptr && dictionary->id() == dictionaryId,
+        fmt::format(
+            "Data was compressed using zstd dictionary {}, which is not "
+            "available.",
+            dictionaryId));
+    ret = ZSTD_decompress_usingDDict(
+        zstd::decompressionContext(),
+        output.data(),
+        output.size(),
+        pos,
+        compressedSize,
+        dictionary->decompressionDictionary_.get());
+  } else {
+    ret = ZSTD_decompressDCtx(
+        zstd::decompressionContext(),
+        output.data(),
+        output.size(),
+        pos,
+        compressedSize);
+  }
   NIMBLE_CHECK(
       !ZSTD_isError(ret),
       fmt::format("Error uncompressing data: {}", ZSTD_getErrorName(ret)));
-  return buffer;
 }
 
 } // namespace facebook::nimble
@@ -15,10 +15,54 @@
  */
 #pragma once
 
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+
 #include "dwio/nimble/common/Vector.h"
 
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
 namespace facebook::nimble {
 
+// A trained zstd dictionary. Small payloads don't compress well on their own,
+// as they don't contain enough data for zstd to learn from. A dictionary,
+// trained on samples of similar payloads, primes the compressor instead.
+class ZstdDictionary {
+ public:
+  // Creates a dictionary usable for decompression. If |compressionLevel| is
+  // provided, the dictionary is also usable for compression (at this level).
+  explicit ZstdDictionary(
+      std::string content,
+      std::optional<int32_t> compressionLevel = std::nullopt);
+
+  // Trains a dictionary (of up to |maxSize| bytes) from |samples|. Returns
+  // std::nullopt if training failed (e.g. not enough samples).
+  static std::optional<std::string> train(
+      std::span<const std::string_view> samples,
+      uint32_t maxSize);
+
+  std::string_view content() const {
+    return content_;
+  }
+
+  // Id recorded in each frame compressed using this dictionary.
+  uint32_t id() const {
+    return id_;
+  }
+
+ private:
+  std::string content_;
+  uint32_t id_;
+  std::unique_ptr<ZSTD_CDict_s, void (*)(ZSTD_CDict_s*)> compressionDictionary_;
+  std::unique_ptr<ZSTD_DDict_s, void (*)(ZSTD_DDict_s*)>
+      decompressionDictionary_;
+
+  friend class ZstdCompression;
+};
+
 class ZstdCompression {
  public:
   static std::optional<Vector<char>> compress(
@@ -26,9 +70,25 @@ class ZstdCompression {
       std::string_view source,
       int32_t level = 1);
 
+  // Compresses using a (compression enabled) dictionary.
+  static std::optional<Vector<char>> compress(
+      velox::memory::MemoryPool& memoryPool,
+      std::string_view source,
+      const ZstdDictionary& dictionary);
+
+  // |dictionary| is only required if the data was compressed using a
+  // dictionary.
   static Vector<char> uncompress(
       velox::memory::MemoryPool& memoryPool,
-      std::string_view source);
+      std::string_view source,
+      const ZstdDictionary* dictionary = nullptr);
+
+  // Same as above, but uncompresses into |output|, reusing its allocation if
+  // it is large enough to hold the uncompressed data.
+  static void uncompress(
+      std::string_view source,
+      Vector<char>& output,
+      const ZstdDictionary* dictionary = nullptr);
 };
 
 } // namespace facebook::nimble
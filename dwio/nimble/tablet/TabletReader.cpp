@@ -25,6 +25,7 @@
 #include "folly/io/Cursor.h"
 
 #include <algorithm>
+#include <chrono>
 #include <limits>
 #include <numeric>
 #include <optional>
@@ -580,7 +581,8 @@ TabletReader::StripeIdentifier TabletReader::getStripeIdentifier(
 std::vector<std::unique_ptr<StreamLoader>> TabletReader::load(
     const StripeIdentifier& stripe,
     std::span<const uint32_t> streamIdentifiers,
-    std::function<std::string_view(uint32_t)> streamLabel) const {
+    std::function<std::string_view(uint32_t)> streamLabel,
+    LoadStats* stats) const {
   NIMBLE_CHECK(stripe.stripeId_ < stripeCount_, "Stripe is out of range.");
 
   const uint64_t stripeOffset = this->stripeOffset(stripe.stripeId_);
@@ -616,7 +618,18 @@ std::vector<std::unique_ptr<StreamLoader>> TabletReader::load(
   }
   if (!regions.empty()) {
     std::vector<folly::IOBuf> iobufs(regions.size());
+    const auto start = std::chrono::steady_clock::now();
     file_->preadv(regions, {iobufs.data(), iobufs.size()});
+    if (stats) {
+      stats->regionCount += regions.size();
+      stats->wallTimeNanos +=
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - start)
+              .count();
+      for (const auto& region : regions) {
+        stats->bytesRequested += region.length;
+      }
+    }
     NIMBLE_DASSERT(iobufs.size() == streamIdx.size(), "Buffer size mismatch.");
     for (uint32_t i = 0; i < streamIdx.size(); ++i) {
       const auto size = iobufs[i].computeChainDataLength();
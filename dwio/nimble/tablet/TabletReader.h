@@ -236,16 +236,25 @@ class TabletReader {
       std::shared_ptr<velox::ReadFile> readFile,
       const std::vector<std::string>& preloadOptionalSections = {});
 
+  // I/O performed by load().
+  struct LoadStats {
+    // Number of file regions requested. Regions are not coalesced: there is
+    // one region per loaded (i.e. present) stream.
+    uint32_t regionCount{0};
+    uint64_t bytesRequested{0};
+    uint64_t wallTimeNanos{0};
+  };
+
   // Returns a collection of stream loaders for the given stripe. The stream
   // loaders are returned in the same order as the input stream identifiers
   // span. If a stream was not present in the given stripe a nullptr is returned
-  // in its slot.
+  // in its slot. If |stats| is provided, it is filled with the I/O performed.
   std::vector<std::unique_ptr<StreamLoader>> load(
       const StripeIdentifier& stripe,
       std::span<const uint32_t> streamIdentifiers,
-      std::function<std::string_view(uint32_t)> streamLabel = [](uint32_t) {
-        return std::string_view{};
-      }) const;
+      std::function<std::string_view(uint32_t)> streamLabel =
+          [](uint32_t) { return std::string_view{}; },
+      LoadStats* stats = nullptr) const;
 
   uint64_t getTotalStreamSize(
       const StripeIdentifier& stripe,
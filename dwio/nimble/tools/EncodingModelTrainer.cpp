@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <fstream>
+#include <iostream>
+#include <map>
+#include "common/init/light.h"
+#include "dwio/nimble/encodings/EncodingPredictionModel.h"
+
+// Trains the encoding prediction model used by the learned encoding selection
+// policy (see LearnedEncodingSelectionPolicy). Input is a list of training
+// samples, one per line, as written by the encoding selection logger
+// (EncodingSelectionLogger --log_features). The trained model can be loaded
+// using EncodingPredictionModel::parse.
+
+DEFINE_string(
+    file,
+    "",
+    "If provided, training samples are read from this file. "
+    "Otherwise, they are read from stdin.");
+DEFINE_string(
+    output,
+    "",
+    "If provided, the trained model is written to this file. "
+    "Otherwise, it is written to stdout.");
+DEFINE_uint32(rounds, 16, "Number of boosting rounds.");
+DEFINE_double(learning_rate, 0.5, "Learning rate (shrinkage) of each tree.");
+DEFINE_uint32(
+    min_split_samples,
+    8,
+    "Tree nodes with fewer training samples are not split.");
+
+using namespace ::facebook;
+
+int main(int argc, char* argv[]) {
+  auto init = init::InitFacebookLight{&argc, &argv};
+
+  std::istream* stream{&std::cin};
+  std::ifstream file;
+  if (!FLAGS_file.empty()) {
+    file = std::ifstream{FLAGS_file};
+    stream = &file;
+  }
+
+  std::vector<nimble::EncodingTrainingSample> samples;
+  std::string line;
+  while (std::getline(*stream, line)) {
+    if (!line.empty()) {
+      samples.push_back(nimble::EncodingTrainingSample::parse(line));
+    }
+  }
+
+  auto model = nimble::EncodingPredictionModel::train(
+      samples,
+      {.roundCount = FLAGS_rounds,
+       .learningRate = static_cast<float>(FLAGS_learning_rate),
+       .minSplitSampleCount = FLAGS_min_split_samples});
+
+  // Training accuracy, per selected encoding.
+  std::map<nimble::EncodingType, std::pair<uint32_t, uint32_t>> accuracy;
+  for (const auto& sample : samples) {
+    auto& [correct, total] = accuracy[sample.encodingType];
+    correct += model.predict(sample.features, [](nimble::EncodingType) {
+      return true;
+    }) == sample.encodingType;
+    ++total;
+  }
+  for (const auto& [encodingType, counts] : accuracy) {
+    LOG(INFO) << "Encoding: " << encodingType << ", Samples: " << counts.second
+              << ", Accuracy: "
+              << static_cast<double>(counts.first) / counts.second;
+  }
+
+  if (FLAGS_output.empty()) {
+    std::cout << model.serialize() << std::endl;
+  } else {
+    std::ofstream output{FLAGS_output};
+    output << model.serialize();
+  }
+}
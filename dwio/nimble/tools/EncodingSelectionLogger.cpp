@@ -35,6 +35,13 @@ DEFINE_string(
 
 DEFINE_string(read_factors, "", "Read factors to use for encoding selection.");
 DEFINE_double(compression_acceptance_ratio, 0.9, "");
+DEFINE_bool(
+    log_features,
+    false,
+    "If set, a training sample for the learned encoding selection model (the "
+    "selected encoding and the model features) is written to stdout. Samples "
+    "from many streams can be collected and passed to the encoding model "
+    "trainer (dwio/nimble/tools/EncodingModelTrainer).");
 
 using namespace ::facebook;
 
@@ -67,6 +74,19 @@ void logEncodingSelection(const std::vector<std::string>& source) {
 
   LOG(INFO) << "Encoding: " << GREEN
             << nimble::tools::getEncodingLabel(serialized) << RESET_COLOR;
+
+  if (FLAGS_log_features) {
+    using physicalType = typename nimble::TypeTraits<T>::physicalType;
+    std::span<const physicalType> physicalValues{
+        reinterpret_cast<const physicalType*>(values.data()), values.size()};
+    auto statistics = nimble::Statistics<physicalType>::create(physicalValues);
+    nimble::EncodingTrainingSample sample{
+        .encodingType =
+            nimble::EncodingFactory::decode(*pool, serialized)->encodingType(),
+        .features = nimble::extractEncodingFeatures(
+            physicalValues.size(), statistics)};
+    std::cout << sample.serialize() << std::endl;
+  }
 }
 
 int main(int argc, char* argv[]) {
@@ -45,6 +45,7 @@ void extractCompressionType(
     case EncodingType::Nullable:
     case EncodingType::SparseBool:
     case EncodingType::Varint:
+    case EncodingType::StreamVByte:
     case EncodingType::Delta:
     case EncodingType::Constant:
     case EncodingType::MainlyConstant:
@@ -99,6 +100,7 @@ void traverseEncodings(
   switch (encodingType) {
     case EncodingType::FixedBitWidth:
     case EncodingType::Varint:
+    case EncodingType::StreamVByte:
     case EncodingType::Constant: {
       // don't have any nested encoding
       break;
@@ -17,6 +17,7 @@
 #include <iostream>
 #include <memory>
 #include <optional>
+#include <thread>
 
 #include "common/base/BuildInfo.h"
 #include "common/init/light.h"
@@ -304,6 +305,177 @@ int main(int argc, char* argv[]) {
               );
   // clang-format on
 
+  app.addCommand(
+         "profile",
+         "<file>",
+         "Print stream decoding costs",
+         "Decodes all streams, timing chunk decompression, encoding creation "
+         "and materialization separately, and prints the most expensive "
+         "streams (by CPU time and by size), along with their encodings.",
+         [](const po::variables_map& options,
+            const std::vector<std::string>& /*args*/) {
+           nimble::tools::NimbleDumpLib{
+               std::cout, options["file"].as<std::string>()}
+               .emitProfile(
+                   options["no_header"].as<bool>(),
+                   options["top"].as<uint32_t>(),
+                   options["sample"].as<uint32_t>(),
+                   getOptional<uint32_t>(options["stripe"]));
+         },
+         positionalArgs)
+      // clang-format off
+        .add_options()
+            (
+                "file",
+                po::value<std::string>()->required(),
+                "Nimble file path. Can be a local path or a Warm Storage path."
+            )(
+                "stripe,s",
+                po::value<uint32_t>(),
+                "Limit analysis to a single stripe with the provided stripe id. "
+                "Default is to analyze sampled stripes (see --sample)."
+            )(
+                "sample",
+                po::value<uint32_t>()->default_value(1),
+                "Analyze only every Nth stripe. Default is to analyze all "
+                "stripes."
+            )(
+                "top,t",
+                po::value<uint32_t>()->default_value(20),
+                "Number of streams to print in each list."
+            )(
+                "no_header,n",
+                po::bool_switch()->default_value(false),
+                "Don't print column names. Default is to include column names."
+            );
+  // clang-format on
+
+  app.addCommand(
+         "advise",
+         "<file>",
+         "Print re-encoding what-if analysis",
+         "Re-encodes the data of each stream with alternate encoding selection "
+         "settings, and prints, per stream label, the encoded size and "
+         "decoding CPU time deltas. 'Reselected' re-runs encoding selection with the "
+         "provided read factors and compression options. 'Replayed' keeps the "
+         "current encodings (or, with --layouts, the encodings captured in the "
+         "provided layout file for the streams it covers), and only applies "
+         "the compression options.",
+         [](const po::variables_map& options,
+            const std::vector<std::string>& /*args*/) {
+           nimble::CompressionOptions compressionOptions{
+               .compressionAcceptRatio =
+                   options["compression_accept_ratio"].as<float>(),
+               .zstdCompressionLevel = options["zstd_level"].as<uint32_t>(),
+           };
+           if (!options["compression"].empty()) {
+             const auto compression = options["compression"].as<std::string>();
+             for (auto type :
+                  {nimble::CompressionType::Uncompressed,
+                   nimble::CompressionType::Zstd,
+                   nimble::CompressionType::MetaInternal,
+                   nimble::CompressionType::Lz4}) {
+               if (nimble::toString(type) == compression) {
+                 compressionOptions.compressionType = type;
+               }
+             }
+             if (!compressionOptions.compressionType.has_value()) {
+               throw folly::ProgramExit(
+                   -1, fmt::format("Unknown compression: {}\n", compression));
+             }
+           }
+           nimble::tools::NimbleDumpLib{
+               std::cout, options["file"].as<std::string>()}
+               .emitAdvise(
+                   options["no_header"].as<bool>(),
+                   options["sample"].as<uint32_t>(),
+                   getOptional<uint32_t>(options["stripe"]),
+                   options["read_factors"].as<std::string>(),
+                   compressionOptions,
+                   getOptional<std::string>(options["layouts"]),
+                   !options["layouts_uncompressed"].as<bool>(),
+                   options["parallelism"].as<uint32_t>());
+         },
+         positionalArgs)
+      // clang-format off
+        .add_options()
+            (
+                "file",
+                po::value<std::string>()->required(),
+                "Nimble file path. Can be a local path or a Warm Storage path."
+            )(
+                "stripe,s",
+                po::value<uint32_t>(),
+                "Limit analysis to a single stripe with the provided stripe id. "
+                "Default is to analyze sampled stripes (see --sample)."
+            )(
+                "sample",
+                po::value<uint32_t>()->default_value(1),
+                "Analyze only every Nth stripe. Default is to analyze all "
+                "stripes."
+            )(
+                "read_factors",
+                po::value<std::string>()->default_value(""),
+                "Read factors used to re-select encodings, in the format "
+                "accepted by ManualEncodingSelectionPolicyFactory. Default is "
+                "to use the default read factors."
+            )(
+                "compression",
+                po::value<std::string>(),
+                "Compression algorithm (e.g. Zstd or Lz4). Default is the "
+                "writer default."
+            )(
+                "zstd_level",
+                po::value<uint32_t>()->default_value(3),
+                "Zstd compression level."
+            )(
+                "compression_accept_ratio",
+                po::value<float>()->default_value(0.98f),
+                "Compression is only kept if it reduces the size below this "
+                "ratio."
+            )(
+                "layouts",
+                po::value<std::string>(),
+                "Encoding layout file (see the layout command) to replay. "
+                "Layouts are matched to streams by schema position (and flat "
+                "map key). Default is to replay the current encodings."
+            )(
+                "layouts_uncompressed",
+                po::bool_switch()->default_value(false),
+                "Is the layout file uncompressed. Default is false, which means "
+                "the layout file is compressed."
+            )(
+                "parallelism,p",
+                po::value<uint32_t>()->default_value(
+                    std::thread::hardware_concurrency()),
+                "Number of streams to re-encode in parallel."
+            )(
+                "no_header,n",
+                po::bool_switch()->default_value(false),
+                "Don't print column names. Default is to include column names."
+            );
+  // clang-format on
+
+  app.addCommand(
+         "kernels",
+         "",
+         "Print active kernel variants",
+         "Prints the detected CPU features and, for each dispatched kernel, the "
+         "implementation selected for this machine.",
+         [](const po::variables_map& options,
+            const std::vector<std::string>& /*args*/) {
+           nimble::tools::NimbleDumpLib::emitKernels(
+               std::cout, options["no_header"].as<bool>());
+         })
+      // clang-format off
+        .add_options()
+        (
+            "no_header,n",
+            po::bool_switch()->default_value(false),
+            "Don't print column names. Default is to include column names."
+        );
+  // clang-format on
+
   app.addAlias("i", "info");
   app.addAlias("b", "binary");
   app.addAlias("c", "content");
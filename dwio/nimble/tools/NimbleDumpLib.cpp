@@ -23,16 +23,24 @@
 
 #include "common/strings/Zstd.h"
 #include "dwio/common/filesystem/FileSystem.h"
+#include "dwio/nimble/common/CpuFeatures.h"
 #include "dwio/nimble/common/EncodingPrimitives.h"
 #include "dwio/nimble/common/FixedBitArray.h"
 #include "dwio/nimble/common/Types.h"
 #include "dwio/nimble/encodings/EncodingFactory.h"
+#include "dwio/nimble/encodings/EncodingIdentifier.h"
 #include "dwio/nimble/encodings/EncodingLayout.h"
+#include "dwio/nimble/encodings/EncodingLayoutCapture.h"
 #include "dwio/nimble/tools/EncodingUtilities.h"
 #include "dwio/nimble/tools/NimbleDumpLib.h"
 #include "dwio/nimble/velox/EncodingLayoutTree.h"
+#include "dwio/nimble/velox/StreamLabels.h"
 #include "dwio/nimble/velox/VeloxReader.h"
+#include "folly/String.h"
 #include "folly/cli/NestedCommandLineApp.h"
+#include "folly/executors/CPUThreadPoolExecutor.h"
+#include "velox/common/time/CpuWallTimer.h"
+#include "velox/dwio/common/ExecutorBarrier.h"
 
 namespace facebook::nimble::tools {
 #define RED "\033[31m"
@@ -108,37 +116,54 @@ class TableFormatter {
       fields_;
 };
 
+using StreamVisitor = std::function<void(
+    ChunkedStream& /*stream*/,
+    uint32_t /*stripeId*/,
+    uint32_t /* streamId*/)>;
+
+// Loads all streams of |stripeId| and passes each present one to
+// |streamVisitor|. |zstdDictionary| is the file dictionary (see
+// loadZstdDictionary()), loaded once by the caller.
+void traverseStripe(
+    velox::memory::MemoryPool& memoryPool,
+    const TabletReader& tabletReader,
+    uint32_t stripeId,
+    const ZstdDictionary* zstdDictionary,
+    const StreamVisitor& streamVisitor) {
+  auto stripeIdentifier = tabletReader.getStripeIdentifier(stripeId);
+  std::vector<uint32_t> streamIdentifiers(
+      tabletReader.streamCount(stripeIdentifier));
+  std::iota(streamIdentifiers.begin(), streamIdentifiers.end(), 0);
+  auto streams = tabletReader.load(
+      stripeIdentifier, {streamIdentifiers.cbegin(), streamIdentifiers.cend()});
+  for (uint32_t j = 0; j < streams.size(); ++j) {
+    auto& stream = streams[j];
+    if (stream) {
+      InMemoryChunkedStream chunkedStream{
+          memoryPool, std::move(stream), zstdDictionary};
+      streamVisitor(chunkedStream, stripeId, j);
+    }
+  }
+}
+
 void traverseTablet(
     velox::memory::MemoryPool& memoryPool,
     const TabletReader& tabletReader,
     std::optional<int32_t> stripeIndex,
     std::function<void(uint32_t /* stripeId */)> stripeVisitor = nullptr,
-    std::function<void(
-        ChunkedStream& /*stream*/,
-        uint32_t /*stripeId*/,
-        uint32_t /* streamId*/)> streamVisitor = nullptr) {
+    StreamVisitor streamVisitor = nullptr) {
   uint32_t startStripe = stripeIndex ? *stripeIndex : 0;
   uint32_t endStripe =
       stripeIndex ? *stripeIndex : tabletReader.stripeCount() - 1;
+  auto zstdDictionary =
+      streamVisitor ? loadZstdDictionary(tabletReader) : nullptr;
   for (uint32_t i = startStripe; i <= endStripe; ++i) {
     if (stripeVisitor) {
       stripeVisitor(i);
     }
     if (streamVisitor) {
-      auto stripeIdentifier = tabletReader.getStripeIdentifier(i);
-      std::vector<uint32_t> streamIdentifiers(
-          tabletReader.streamCount(stripeIdentifier));
-      std::iota(streamIdentifiers.begin(), streamIdentifiers.end(), 0);
-      auto streams = tabletReader.load(
-          stripeIdentifier,
-          {streamIdentifiers.cbegin(), streamIdentifiers.cend()});
-      for (uint32_t j = 0; j < streams.size(); ++j) {
-        auto& stream = streams[j];
-        if (stream) {
-          InMemoryChunkedStream chunkedStream{memoryPool, std::move(stream)};
-          streamVisitor(chunkedStream, i, j);
-        }
-      }
+      traverseStripe(
+          memoryPool, tabletReader, i, zstdDictionary.get(), streamVisitor);
     }
   }
 }
@@ -203,6 +228,340 @@ void printScalarType(
   }
 }
 
+template <typename T>
+void materializeScalarData(velox::memory::MemoryPool& pool, Encoding& stream) {
+  nimble::Vector<T> buffer(&pool, kBufferSize);
+  nimble::Vector<char> nulls(
+      &pool, nimble::FixedBitArray::bufferSize(kBufferSize, 1));
+  uint32_t totalRows = stream.rowCount();
+  while (totalRows > 0) {
+    auto currentReadSize = std::min(kBufferSize, totalRows);
+    if (stream.isNullable()) {
+      stream.materializeNullable(
+          currentReadSize, buffer.data(), [&]() { return nulls.data(); });
+    } else {
+      stream.materialize(currentReadSize, buffer.data());
+    }
+    totalRows -= currentReadSize;
+  }
+}
+
+// Materializes all the rows of the stream (and discards them).
+void materializeScalarType(velox::memory::MemoryPool& pool, Encoding& stream) {
+  switch (stream.dataType()) {
+#define CASE(KIND, cppType)                       \
+  case DataType::KIND: {                          \
+    materializeScalarData<cppType>(pool, stream); \
+    break;                                        \
+  }
+    CASE(Int8, int8_t);
+    CASE(Uint8, uint8_t);
+    CASE(Int16, int16_t);
+    CASE(Uint16, uint16_t);
+    CASE(Int32, int32_t);
+    CASE(Uint32, uint32_t);
+    CASE(Int64, int64_t);
+    CASE(Uint64, uint64_t);
+    CASE(Float, float);
+    CASE(Double, double);
+    CASE(Bool, bool);
+    CASE(String, std::string_view);
+#undef CASE
+    case DataType::Undefined: {
+      NIMBLE_UNREACHABLE(
+          fmt::format("Undefined type for stream: {}", stream.dataType()));
+    }
+  }
+}
+
+struct StreamProfile {
+  uint32_t streamId;
+  uint64_t bytes{0};
+  uint64_t itemCount{0};
+  // Chunk decompression (see ChunkedStream::nextChunk).
+  velox::CpuWallTiming decompressTiming;
+  // Encoding creation. Includes decompressing compressed nested encodings.
+  velox::CpuWallTiming initTiming;
+  velox::CpuWallTiming materializeTiming;
+  // Encoding tree of the first chunk.
+  std::string encoding;
+
+  uint64_t cpuNanos() const {
+    return decompressTiming.cpuNanos + initTiming.cpuNanos +
+        materializeTiming.cpuNanos;
+  }
+};
+
+// Encoded size and decoding CPU time of stream data.
+struct EncodingCost {
+  uint64_t bytes{0};
+  uint64_t cpuNanos{0};
+
+  void add(const EncodingCost& other) {
+    bytes += other.bytes;
+    cpuNanos += other.cpuNanos;
+  }
+};
+
+struct StreamAdvice {
+  EncodingCost current;
+  // Encoding selection re-run with the alternate read factors and compression
+  // options.
+  EncodingCost reselected;
+  // Current encoding layout (or the layout provided for the stream, see
+  // emitAdvise()), replayed with the alternate compression options.
+  EncodingCost replayed;
+
+  void add(const StreamAdvice& other) {
+    current.add(other.current);
+    reselected.add(other.reselected);
+    replayed.add(other.replayed);
+  }
+};
+
+struct AdviseOptions {
+  std::vector<std::pair<EncodingType, float>> readFactors;
+  CompressionOptions compressionOptions;
+};
+
+EncodingCost decodingCost(
+    velox::memory::MemoryPool& pool,
+    std::string_view data) {
+  velox::CpuWallTiming timing;
+  {
+    velox::CpuWallTimer timer{timing};
+    auto encoding = EncodingFactory::decode(pool, data);
+    materializeScalarType(pool, *encoding);
+  }
+  return {.bytes = data.size(), .cpuNanos = timing.cpuNanos};
+}
+
+template <typename T>
+StreamAdvice adviseScalarData(
+    velox::memory::MemoryPool& pool,
+    std::string_view chunk,
+    Encoding& encoding,
+    const AdviseOptions& options,
+    const EncodingLayout* replayedLayout) {
+  const uint32_t rowCount = encoding.rowCount();
+  nimble::Vector<T> values(&pool, rowCount);
+  nimble::Vector<char> nulls(
+      &pool, nimble::FixedBitArray::bufferSize(rowCount, 1));
+  bool hasNulls = false;
+  if (encoding.isNullable()) {
+    const auto nonNullCount = encoding.materializeNullable(
+        rowCount, values.data(), [&]() { return nulls.data(); });
+    hasNulls = nonNullCount != rowCount;
+  } else {
+    encoding.materialize(rowCount, values.data());
+  }
+
+  // Nullable encodings take the non-null values, and a non-null flag per row.
+  nimble::Vector<bool> nonNulls(&pool);
+  if (hasNulls) {
+    nonNulls.reserve(rowCount);
+    uint32_t nonNullCount = 0;
+    for (uint32_t i = 0; i < rowCount; ++i) {
+      nonNulls.push_back(nimble::bits::getBit(i, nulls.data()));
+      if (nonNulls.back()) {
+        values[nonNullCount++] = values[i];
+      }
+    }
+    values.resize(nonNullCount);
+  }
+
+  ManualEncodingSelectionPolicyFactory manualFactory{
+      options.readFactors, options.compressionOptions};
+  EncodingSelectionPolicyFactory encodingSelectionPolicyFactory =
+      [&manualFactory](DataType dataType)
+      -> std::unique_ptr<EncodingSelectionPolicyBase> {
+    return manualFactory.createPolicy(dataType);
+  };
+  auto encodingCost = [&](std::unique_ptr<EncodingSelectionPolicy<T>> policy) {
+    Buffer buffer{pool};
+    return decodingCost(
+        pool,
+        hasNulls ? EncodingFactory::encodeNullable<T>(
+                       std::move(policy), values, nonNulls, buffer)
+                 : EncodingFactory::encode<T>(
+                       std::move(policy), values, buffer));
+  };
+
+  StreamAdvice advice;
+  advice.current = decodingCost(pool, chunk);
+  advice.reselected = encodingCost(std::unique_ptr<EncodingSelectionPolicy<T>>(
+      static_cast<EncodingSelectionPolicy<T>*>(
+          manualFactory.createPolicy(TypeTraits<T>::dataType).release())));
+
+  // The nullable wrapper (and its nulls) are re-selected when encoding
+  // nullable data (see ReplayedEncodingSelectionPolicy::selectNullable).
+  auto captured = replayedLayout ? *replayedLayout
+                                 : EncodingLayoutCapture::capture(chunk);
+  auto layout = captured.encodingType() == EncodingType::Nullable
+      ? captured.child(EncodingIdentifiers::Nullable::Data).value()
+      : captured;
+  advice.replayed = encodingCost(
+      std::make_unique<ReplayedEncodingSelectionPolicy<T>>(
+          std::move(layout),
+          options.compressionOptions,
+          encodingSelectionPolicyFactory));
+  return advice;
+}
+
+StreamAdvice adviseScalarType(
+    velox::memory::MemoryPool& pool,
+    std::string_view chunk,
+    const AdviseOptions& options,
+    const EncodingLayout* replayedLayout) {
+  auto encoding = EncodingFactory::decode(pool, chunk);
+  switch (encoding->dataType()) {
+#define CASE(KIND, cppType)                               \
+  case DataType::KIND: {                                  \
+    return adviseScalarData<cppType>(                     \
+        pool, chunk, *encoding, options, replayedLayout); \
+  }
+    CASE(Int8, int8_t);
+    CASE(Uint8, uint8_t);
+    CASE(Int16, int16_t);
+    CASE(Uint16, uint16_t);
+    CASE(Int32, int32_t);
+    CASE(Uint32, uint32_t);
+    CASE(Int64, int64_t);
+    CASE(Uint64, uint64_t);
+    CASE(Float, float);
+    CASE(Double, double);
+    CASE(Bool, bool);
+    CASE(String, std::string_view);
+#undef CASE
+    case DataType::Undefined: {
+      NIMBLE_UNREACHABLE(fmt::format(
+          "Undefined type for stream: {}", encoding->dataType()));
+    }
+  }
+}
+
+// Maps the stream offsets of |type| to the encoding layouts captured for them
+// in |encodingLayoutTree|, the same way VeloxWriter applies a captured tree.
+// Flat map keys are matched by name, other children by position. Streams the
+// tree doesn't cover are left out.
+void mapEncodingLayouts(
+    const Type& type,
+    const EncodingLayoutTree& encodingLayoutTree,
+    std::unordered_map<offset_size, const EncodingLayout*>& layouts) {
+  using StreamIdentifiers = EncodingLayoutTree::StreamIdentifiers;
+  auto mapStream = [&](const StreamDescriptor& descriptor,
+                       EncodingLayoutTree::StreamIdentifier identifier) {
+    if (auto* encodingLayout = encodingLayoutTree.encodingLayout(identifier)) {
+      layouts[descriptor.offset()] = encodingLayout;
+    }
+  };
+
+  if (type.kind() != encodingLayoutTree.schemaKind()) {
+    // Schema evolution (e.g. a map converted to a flat map). There is nothing
+    // to replay.
+    return;
+  }
+  switch (type.kind()) {
+    case Kind::Scalar: {
+      mapStream(
+          type.asScalar().scalarDescriptor(),
+          StreamIdentifiers::Scalar::ScalarStream);
+      break;
+    }
+    case Kind::Row: {
+      auto& row = type.asRow();
+      mapStream(row.nullsDescriptor(), StreamIdentifiers::Row::NullsStream);
+      for (auto i = 0; i < row.childrenCount() &&
+           i < encodingLayoutTree.childrenCount();
+           ++i) {
+        mapEncodingLayouts(
+            *row.childAt(i), encodingLayoutTree.child(i), layouts);
+      }
+      break;
+    }
+    case Kind::Array: {
+      auto& array = type.asArray();
+      mapStream(
+          array.lengthsDescriptor(), StreamIdentifiers::Array::LengthsStream);
+      if (encodingLayoutTree.childrenCount() > 0) {
+        mapEncodingLayouts(
+            *array.elements(), encodingLayoutTree.child(0), layouts);
+      }
+      break;
+    }
+    case Kind::ArrayWithOffsets: {
+      auto& array = type.asArrayWithOffsets();
+      mapStream(
+          array.offsetsDescriptor(),
+          StreamIdentifiers::ArrayWithOffsets::OffsetsStream);
+      mapStream(
+          array.lengthsDescriptor(),
+          StreamIdentifiers::ArrayWithOffsets::LengthsStream);
+      if (encodingLayoutTree.childrenCount() > 0) {
+        mapEncodingLayouts(
+            *array.elements(), encodingLayoutTree.child(0), layouts);
+      }
+      break;
+    }
+    case Kind::Map: {
+      auto& map = type.asMap();
+      mapStream(map.lengthsDescriptor(), StreamIdentifiers::Map::LengthsStream);
+      if (encodingLayoutTree.childrenCount() == 2) {
+        mapEncodingLayouts(*map.keys(), encodingLayoutTree.child(0), layouts);
+        mapEncodingLayouts(*map.values(), encodingLayoutTree.child(1), layouts);
+      }
+      break;
+    }
+    case Kind::SlidingWindowMap: {
+      auto& map = type.asSlidingWindowMap();
+      mapStream(
+          map.offsetsDescriptor(),
+          StreamIdentifiers::SlidingWindowMap::OffsetsStream);
+      mapStream(
+          map.lengthsDescriptor(),
+          StreamIdentifiers::SlidingWindowMap::LengthsStream);
+      if (encodingLayoutTree.childrenCount() == 2) {
+        mapEncodingLayouts(*map.keys(), encodingLayoutTree.child(0), layouts);
+        mapEncodingLayouts(*map.values(), encodingLayoutTree.child(1), layouts);
+      }
+      break;
+    }
+    case Kind::FlatMap: {
+      auto& flatMap = type.asFlatMap();
+      mapStream(
+          flatMap.nullsDescriptor(), StreamIdentifiers::FlatMap::NullsStream);
+      std::unordered_map<std::string_view, const EncodingLayoutTree*>
+          keyLayouts;
+      for (auto i = 0; i < encodingLayoutTree.childrenCount(); ++i) {
+        auto& child = encodingLayoutTree.child(i);
+        keyLayouts.emplace(child.name(), &child);
+      }
+      for (auto i = 0; i < flatMap.childrenCount(); ++i) {
+        auto it = keyLayouts.find(flatMap.nameAt(i));
+        if (it != keyLayouts.end()) {
+          mapEncodingLayouts(*flatMap.childAt(i), *it->second, layouts);
+        }
+      }
+      break;
+    }
+  }
+}
+
+// Reads a captured encoding layout tree file (zstd compressed, unless
+// |compressed| is false).
+std::string readEncodingLayoutFile(velox::ReadFile& file, bool compressed) {
+  auto size = file.size();
+  std::string buffer;
+  buffer.resize(size);
+  file.pread(0, size, buffer.data());
+  if (compressed) {
+    std::string uncompressed;
+    strings::zstdDecompress(buffer, &uncompressed);
+    buffer = std::move(uncompressed);
+  }
+  return buffer;
+}
+
 template <typename T>
 auto commaSeparated(T value) {
   return fmt::format(std::locale("en_US.UTF-8"), "{:L}", value);
@@ -426,6 +785,7 @@ void NimbleDumpLib::emitHistogram(
       {toString(CompressionType::Uncompressed), CompressionType::Uncompressed},
       {toString(CompressionType::Zstd), CompressionType::Zstd},
       {toString(CompressionType::MetaInternal), CompressionType::MetaInternal},
+      {toString(CompressionType::Lz4), CompressionType::Lz4},
   };
   traverseTablet(
       *pool_,
@@ -489,6 +849,7 @@ void NimbleDumpLib::emitContent(
     uint32_t streamId,
     std::optional<uint32_t> stripeId) {
   TabletReader tabletReader{*pool_, file_.get()};
+  auto zstdDictionary = loadZstdDictionary(tabletReader);
 
   uint32_t maxStreamCount;
   bool found = false;
@@ -505,7 +866,8 @@ void NimbleDumpLib::emitContent(
     auto streams = tabletReader.load(stripeIdentifier, std::vector{streamId});
 
     if (auto& stream = streams[0]) {
-      InMemoryChunkedStream chunkedStream{*pool_, std::move(stream)};
+      InMemoryChunkedStream chunkedStream{
+          *pool_, std::move(stream), zstdDictionary.get()};
       while (chunkedStream.hasNext()) {
         auto encoding =
             EncodingFactory::decode(*pool_, chunkedStream.nextChunk());
@@ -675,17 +1037,8 @@ std::string getEncodingLayoutLabel(
 }
 
 void NimbleDumpLib::emitLayout(bool noHeader, bool compressed) {
-  auto size = file_->size();
-  std::string buffer;
-  buffer.resize(size);
-  file_->pread(0, size, buffer.data());
-  if (compressed) {
-    std::string uncompressed;
-    strings::zstdDecompress(buffer, &uncompressed);
-    buffer = std::move(uncompressed);
-  }
-
-  auto layout = nimble::EncodingLayoutTree::create(buffer);
+  auto layout = nimble::EncodingLayoutTree::create(
+      readEncodingLayoutFile(*file_, compressed));
 
   TableFormatter formatter(
       ostream_,
@@ -733,4 +1086,258 @@ void NimbleDumpLib::emitLayout(bool noHeader, bool compressed) {
       });
 }
 
+void NimbleDumpLib::emitProfile(
+    bool noHeader,
+    uint32_t topN,
+    uint32_t stripeInterval,
+    std::optional<uint32_t> stripeId) {
+  NIMBLE_CHECK(stripeInterval > 0, "Stripe interval must be positive.");
+  auto tabletReader = std::make_shared<TabletReader>(*pool_, file_.get());
+  VeloxReader reader{*pool_, tabletReader};
+  StreamLabels labels{reader.schema()};
+  // Sampled stripes are traversed one at a time, so load the dictionary once
+  // for all of them.
+  auto zstdDictionary = loadZstdDictionary(*tabletReader);
+
+  std::unordered_map<uint32_t, StreamProfile> profiles;
+  auto profileStripe = [&](uint32_t stripe) {
+    auto stripeIdentifier = tabletReader->getStripeIdentifier(stripe);
+    auto streamSizes = tabletReader->streamSizes(stripeIdentifier);
+    traverseStripe(
+        *pool_,
+        *tabletReader,
+        stripe,
+        zstdDictionary.get(),
+        [&](ChunkedStream& stream, uint32_t /* stripeId */, uint32_t streamId) {
+          auto& profile = profiles[streamId];
+          profile.streamId = streamId;
+          profile.bytes += streamSizes[streamId];
+          while (stream.hasNext()) {
+            std::string_view chunk;
+            std::unique_ptr<Encoding> encoding;
+            {
+              velox::CpuWallTimer timer{profile.decompressTiming};
+              chunk = stream.nextChunk();
+            }
+            {
+              velox::CpuWallTimer timer{profile.initTiming};
+              encoding = EncodingFactory::decode(*pool_, chunk);
+            }
+            {
+              velox::CpuWallTimer timer{profile.materializeTiming};
+              materializeScalarType(*pool_, *encoding);
+            }
+            profile.itemCount += encoding->rowCount();
+            if (profile.encoding.empty()) {
+              profile.encoding = getEncodingLabel(chunk);
+            }
+          }
+        });
+  };
+
+  if (stripeId.has_value()) {
+    profileStripe(*stripeId);
+  } else {
+    for (uint32_t stripe = 0; stripe < tabletReader->stripeCount();
+         stripe += stripeInterval) {
+      profileStripe(stripe);
+    }
+  }
+
+  std::vector<const StreamProfile*> sorted;
+  sorted.reserve(profiles.size());
+  for (const auto& [_, profile] : profiles) {
+    sorted.push_back(&profile);
+  }
+
+  auto emitTop = [&](std::string_view title, auto compare) {
+    std::sort(sorted.begin(), sorted.end(), compare);
+    if (!noHeader) {
+      ostream_ << CYAN << title << RESET_COLOR << std::endl;
+    }
+    TableFormatter formatter(
+        ostream_,
+        {{"Stream Id", 11},
+         {"Stream Label", 30},
+         {"Stream Size", 13},
+         {"Item Count", 13},
+         {"Decompress (us)", 15},
+         {"Init (us)", 11},
+         {"Materialize (us)", 16},
+         {"ns/Item", 9},
+         {"Encoding", 30}},
+        noHeader);
+    for (auto i = 0; i < std::min<size_t>(topN, sorted.size()); ++i) {
+      const auto& profile = *sorted[i];
+      formatter.writeRow({
+          folly::to<std::string>(profile.streamId),
+          std::string{labels.streamLabel(profile.streamId)},
+          folly::to<std::string>(profile.bytes),
+          folly::to<std::string>(profile.itemCount),
+          folly::to<std::string>(profile.decompressTiming.cpuNanos / 1000),
+          folly::to<std::string>(profile.initTiming.cpuNanos / 1000),
+          folly::to<std::string>(profile.materializeTiming.cpuNanos / 1000),
+          fmt::format(
+              "{:.1f}",
+              static_cast<double>(profile.cpuNanos()) /
+                  std::max<uint64_t>(profile.itemCount, 1)),
+          profile.encoding,
+      });
+    }
+  };
+
+  emitTop(
+      fmt::format("Top {} streams by CPU time", topN),
+      [](const StreamProfile* lhs, const StreamProfile* rhs) {
+        return lhs->cpuNanos() > rhs->cpuNanos();
+      });
+  ostream_ << std::endl;
+  emitTop(
+      fmt::format("Top {} streams by size", topN),
+      [](const StreamProfile* lhs, const StreamProfile* rhs) {
+        return lhs->bytes > rhs->bytes;
+      });
+}
+
+void NimbleDumpLib::emitAdvise(
+    bool noHeader,
+    uint32_t stripeInterval,
+    std::optional<uint32_t> stripeId,
+    const std::string& readFactors,
+    const CompressionOptions& compressionOptions,
+    const std::optional<std::string>& layoutsFile,
+    bool layoutsCompressed,
+    uint32_t parallelism) {
+  NIMBLE_CHECK(stripeInterval > 0, "Stripe interval must be positive.");
+  auto tabletReader = std::make_shared<TabletReader>(*pool_, file_.get());
+  VeloxReader reader{*pool_, tabletReader};
+  StreamLabels labels{reader.schema()};
+
+  // Layouts to replay, by stream offset. Streams without one replay their
+  // current layout.
+  std::optional<EncodingLayoutTree> layoutTree;
+  std::unordered_map<offset_size, const EncodingLayout*> replayedLayouts;
+  if (layoutsFile.has_value()) {
+    auto file = dwio::file_system::FileSystem::openForRead(
+        *layoutsFile,
+        dwio::common::request::AccessDescriptorBuilder()
+            .withClientId("nimble_dump")
+            .build());
+    layoutTree.emplace(EncodingLayoutTree::create(
+        readEncodingLayoutFile(*file, layoutsCompressed)));
+    mapEncodingLayouts(*reader.schema(), *layoutTree, replayedLayouts);
+  }
+  const AdviseOptions options{
+      .readFactors = readFactors.empty()
+          ? ManualEncodingSelectionPolicyFactory::defaultReadFactors()
+          : ManualEncodingSelectionPolicyFactory::parseReadFactors(readFactors),
+      .compressionOptions = compressionOptions,
+  };
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(
+      std::max(parallelism, 1U));
+
+  struct ChunkTask {
+    uint32_t streamId;
+    // Chunks only live as long as their stream is loaded, so they are copied.
+    std::string chunk;
+    StreamAdvice advice;
+  };
+
+  // Sampled stripes are traversed one at a time, so load the dictionary once
+  // for all of them.
+  auto zstdDictionary = loadZstdDictionary(*tabletReader);
+
+  // Ordered by label, for a stable output.
+  std::map<std::string, StreamAdvice> columns;
+  auto adviseStripe = [&](uint32_t stripe) {
+    std::vector<ChunkTask> tasks;
+    traverseStripe(
+        *pool_,
+        *tabletReader,
+        stripe,
+        zstdDictionary.get(),
+        [&](ChunkedStream& stream, uint32_t /* stripeId */, uint32_t streamId) {
+          while (stream.hasNext()) {
+            tasks.push_back(
+                {.streamId = streamId,
+                 .chunk = std::string{stream.nextChunk()}});
+          }
+        });
+
+    velox::dwio::common::ExecutorBarrier barrier{executor};
+    for (auto& task : tasks) {
+      barrier.add([&]() {
+        auto it = replayedLayouts.find(task.streamId);
+        task.advice = adviseScalarType(
+            *pool_,
+            task.chunk,
+            options,
+            it == replayedLayouts.end() ? nullptr : it->second);
+      });
+    }
+    barrier.waitAll();
+
+    for (const auto& task : tasks) {
+      columns[std::string{labels.streamLabel(task.streamId)}].add(task.advice);
+    }
+  };
+
+  if (stripeId.has_value()) {
+    adviseStripe(*stripeId);
+  } else {
+    for (uint32_t stripe = 0; stripe < tabletReader->stripeCount();
+         stripe += stripeInterval) {
+      adviseStripe(stripe);
+    }
+  }
+
+  auto delta = [](uint64_t current, uint64_t alternate) {
+    return current == 0 ? std::string{"N/A"}
+                        : fmt::format(
+                              "{:+.1f}%",
+                              (static_cast<double>(alternate) - current) *
+                                  100 / current);
+  };
+
+  TableFormatter formatter(
+      ostream_,
+      {{"Stream Label", 30},
+       {"Current Size", 13},
+       {"Reselected", 11},
+       {"Replayed", 11},
+       {"Current CPU (us)", 16},
+       {"Reselected", 11},
+       {"Replayed", 11}},
+      noHeader);
+  StreamAdvice total;
+  auto writeRow = [&](const std::string& label, const StreamAdvice& advice) {
+    formatter.writeRow({
+        label,
+        folly::to<std::string>(advice.current.bytes),
+        delta(advice.current.bytes, advice.reselected.bytes),
+        delta(advice.current.bytes, advice.replayed.bytes),
+        folly::to<std::string>(advice.current.cpuNanos / 1000),
+        delta(advice.current.cpuNanos, advice.reselected.cpuNanos),
+        delta(advice.current.cpuNanos, advice.replayed.cpuNanos),
+    });
+  };
+  for (const auto& [label, advice] : columns) {
+    writeRow(label, advice);
+    total.add(advice);
+  }
+  writeRow("Total", total);
+}
+
+void NimbleDumpLib::emitKernels(std::ostream& ostream, bool noHeader) {
+  if (!noHeader) {
+    ostream << "CPU Features: " << cpu::toString(cpu::features()) << std::endl;
+  }
+  TableFormatter formatter(
+      ostream, {{"Kernel", 40}, {"Variant", 10}, {"Variants", 30}}, noHeader);
+  for (const auto& kernel : cpu::activeKernels()) {
+    formatter.writeRow(
+        {kernel.name, kernel.variant, folly::join(",", kernel.variants)});
+  }
+}
+
 } // namespace facebook::nimble::tools
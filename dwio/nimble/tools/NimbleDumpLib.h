@@ -18,6 +18,7 @@
 #include <ostream>
 
 #include "dwio/nimble/encodings/Encoding.h"
+#include "dwio/nimble/encodings/EncodingSelectionPolicy.h"
 #include "velox/common/file/File.h"
 
 namespace facebook::nimble::tools {
@@ -41,6 +42,37 @@ class NimbleDumpLib {
       uint32_t streamId,
       uint32_t stripeId);
   void emitLayout(bool noHeader, bool compressed);
+  // Decodes every stream, in every |stripeInterval|th stripe (or only in
+  // |stripeId|), and prints the |topN| streams with the highest decoding CPU
+  // time, and the |topN| largest streams.
+  void emitProfile(
+      bool noHeader,
+      uint32_t topN,
+      uint32_t stripeInterval,
+      std::optional<uint32_t> stripeId);
+  // Re-encodes the data of every stream (in every |stripeInterval|th stripe,
+  // or only in |stripeId|), and prints, for each stream label, the encoded
+  // size and decoding CPU time of the current encodings, of encodings selected
+  // with |readFactors| (see ManualEncodingSelectionPolicyFactory) and
+  // |compressionOptions|, and of replayed encoding layouts with
+  // |compressionOptions|. If |layoutsFile| is provided, it holds a captured
+  // encoding layout tree (zstd compressed if |layoutsCompressed|), whose
+  // layouts are replayed for the streams it covers. Other streams replay their
+  // current layouts. Streams are processed in parallel, on |parallelism|
+  // threads.
+  void emitAdvise(
+      bool noHeader,
+      uint32_t stripeInterval,
+      std::optional<uint32_t> stripeId,
+      const std::string& readFactors,
+      const CompressionOptions& compressionOptions,
+      const std::optional<std::string>& layoutsFile,
+      bool layoutsCompressed,
+      uint32_t parallelism);
+
+  // Prints the CPU features and the kernel variants selected for them. Not
+  // tied to a file.
+  static void emitKernels(std::ostream& ostream, bool noHeader);
 
  private:
   std::shared_ptr<velox::memory::MemoryPool> pool_;
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include "common/init/light.h"
+#include "dwio/nimble/encodings/EncodingFactory.h"
+#include "dwio/nimble/encodings/EncodingSelectionPolicy.h"
+#include "dwio/nimble/encodings/ReadCostModel.h"
+
+// Measures the decode cost of each encoding, on each data type and bit width,
+// on the current machine. The produced read cost model can be loaded by the
+// writer (see EncodingSelectionOptions::readCostModel), to make encoding
+// selection aware of read CPU.
+
+DEFINE_string(
+    output,
+    "",
+    "If provided, the read cost model is written to this file. "
+    "Otherwise, it is written to stdout.");
+
+DEFINE_uint32(row_count, 64 * 1024, "Number of values in each encoding.");
+DEFINE_uint32(
+    min_time_ms,
+    100,
+    "Minimal time to spend decoding each encoding, in milliseconds.");
+DEFINE_uint32(seed, 0, "Random seed used to generate the data.");
+
+using namespace ::facebook;
+
+namespace {
+
+// Read factor used to discourage all non-measured encodings (at the top level
+// of the encoding tree).
+constexpr float kDiscouragedReadFactor = 1e6;
+constexpr uint32_t kDictionarySize = 256;
+constexpr uint32_t kMaxRunLength = 32;
+
+std::mt19937 rng;
+
+template <typename T>
+std::unique_ptr<nimble::EncodingSelectionPolicy<T>> forcedPolicy(
+    nimble::EncodingType encodingType) {
+  // All decodable encodings are listed (not only the ones with a default read
+  // factor), so the measured encoding is always a selection candidate.
+  const auto defaultReadFactors =
+      nimble::ManualEncodingSelectionPolicyFactory::defaultReadFactors();
+  std::vector<std::pair<nimble::EncodingType, float>> readFactors;
+  for (auto type :
+       nimble::ManualEncodingSelectionPolicyFactory::possibleEncodings()) {
+    float readFactor = 1.0;
+    for (const auto& pair : defaultReadFactors) {
+      if (pair.first == type) {
+        readFactor = pair.second;
+      }
+    }
+    if (type != encodingType) {
+      readFactor *= kDiscouragedReadFactor;
+    }
+    readFactors.emplace_back(type, readFactor);
+  }
+  return std::unique_ptr<nimble::EncodingSelectionPolicy<T>>(
+      static_cast<nimble::EncodingSelectionPolicy<T>*>(
+          nimble::ManualEncodingSelectionPolicyFactory{std::move(readFactors)}
+              .createPolicy(nimble::TypeTraits<T>::dataType)
+              .release()));
+}
+
+// Generates values shaped to fit the measured encoding. Values are generated
+// by |generator| (which returns a random value in the measured bit width).
+template <typename T, typename Generator>
+std::vector<T> generate(
+    nimble::EncodingType encodingType,
+    Generator generator) {
+  std::vector<T> values;
+  values.reserve(FLAGS_row_count);
+  switch (encodingType) {
+    case nimble::EncodingType::Constant: {
+      values.resize(FLAGS_row_count, generator());
+      break;
+    }
+    case nimble::EncodingType::RLE: {
+      while (values.size() < FLAGS_row_count) {
+        const auto value = generator();
+        const auto runLength = std::min<size_t>(
+            1 + rng() % kMaxRunLength, FLAGS_row_count - values.size());
+        values.insert(values.end(), runLength, value);
+      }
+      break;
+    }
+    case nimble::EncodingType::Dictionary: {
+      std::vector<T> alphabet;
+      for (auto i = 0; i < kDictionarySize; ++i) {
+        alphabet.push_back(generator());
+      }
+      for (auto i = 0; i < FLAGS_row_count; ++i) {
+        values.push_back(alphabet[rng() % alphabet.size()]);
+      }
+      break;
+    }
+    case nimble::EncodingType::MainlyConstant:
+    case nimble::EncodingType::SparseBool: {
+      const auto common = generator();
+      for (auto i = 0; i < FLAGS_row_count; ++i) {
+        values.push_back(rng() % 20 == 0 ? generator() : common);
+      }
+      break;
+    }
+    default: {
+      for (auto i = 0; i < FLAGS_row_count; ++i) {
+        values.push_back(generator());
+      }
+      break;
+    }
+  }
+  return values;
+}
+
+// Encodes the values using the measured encoding, and returns the decode time
+// per value (in nanoseconds), or std::nullopt if the encoding is incompatible
+// with the data.
+template <typename T>
+std::optional<float> measure(
+    velox::memory::MemoryPool& pool,
+    nimble::EncodingType encodingType,
+    std::span<const T> values) {
+  nimble::Buffer buffer{pool};
+  std::string_view serialized;
+  try {
+    serialized = nimble::EncodingFactory::encode<T>(
+        forcedPolicy<T>(encodingType), values, buffer);
+  } catch (const nimble::NimbleUserError& e) {
+    if (e.errorCode() != nimble::error_code::IncompatibleEncoding) {
+      throw;
+    }
+    return std::nullopt;
+  }
+
+  auto encoding = nimble::EncodingFactory::decode(pool, serialized);
+  if (encoding->encodingType() != encodingType) {
+    return std::nullopt;
+  }
+
+  using physicalType = typename nimble::TypeTraits<T>::physicalType;
+  auto output = std::make_unique<physicalType[]>(values.size());
+  const auto minTime = std::chrono::milliseconds(FLAGS_min_time_ms);
+  uint64_t iterations = 0;
+  const auto start = std::chrono::steady_clock::now();
+  auto elapsed = std::chrono::steady_clock::duration::zero();
+  do {
+    encoding->reset();
+    encoding->materialize(values.size(), output.get());
+    ++iterations;
+    elapsed = std::chrono::steady_clock::now() - start;
+  } while (elapsed < minTime);
+
+  return std::chrono::duration<float, std::nano>(elapsed).count() /
+      (iterations * values.size());
+}
+
+template <typename T>
+void calibrate(velox::memory::MemoryPool& pool, nimble::ReadCostModel& model) {
+  using physicalType = typename nimble::TypeTraits<T>::physicalType;
+  const auto dataType = nimble::TypeTraits<T>::dataType;
+  for (auto encodingType :
+       nimble::ManualEncodingSelectionPolicyFactory::possibleEncodings()) {
+    // Integers are measured at power of two bit widths (encoding selection
+    // rounds up to them). Bit widths don't apply to floating point values.
+    std::vector<uint32_t> bitWidths;
+    if constexpr (
+        nimble::isNumericType<physicalType>() &&
+        !nimble::isFloatingPointType<T>()) {
+      for (auto bitWidth = 1; bitWidth <= sizeof(physicalType) * 8;
+           bitWidth *= 2) {
+        bitWidths.push_back(bitWidth);
+      }
+    } else {
+      bitWidths.push_back(0);
+    }
+
+    for (auto bitWidth : bitWidths) {
+      std::optional<float> nanosPerValue;
+      if constexpr (nimble::isFloatingPointType<T>()) {
+        const auto values = generate<T>(encodingType, []() {
+          return static_cast<T>(rng()) / static_cast<T>(1 + rng() % 1000);
+        });
+        nanosPerValue = measure<T>(pool, encodingType, values);
+      } else if constexpr (nimble::isNumericType<physicalType>()) {
+        const uint64_t mask =
+            bitWidth == 64 ? ~0ULL : ((1ULL << bitWidth) - 1);
+        const auto values = generate<T>(encodingType, [mask]() {
+          const auto value = static_cast<physicalType>(
+              ((uint64_t{rng()} << 32) | rng()) & mask);
+          return *reinterpret_cast<const T*>(&value);
+        });
+        nanosPerValue = measure<T>(pool, encodingType, values);
+      } else if constexpr (nimble::isBoolType<physicalType>()) {
+        // std::vector<bool> is bit packed, so we copy the values to a plain
+        // bool array.
+        const auto values =
+            generate<bool>(encodingType, []() { return rng() % 2 == 0; });
+        auto bools = std::make_unique<bool[]>(values.size());
+        std::copy(values.begin(), values.end(), bools.get());
+        nanosPerValue = measure<T>(
+            pool,
+            encodingType,
+            std::span<const bool>{bools.get(), values.size()});
+      } else {
+        const auto strings = generate<std::string>(encodingType, []() {
+          std::string value(8 + rng() % 16, ' ');
+          for (auto& c : value) {
+            c = 'a' + rng() % 26;
+          }
+          return value;
+        });
+        const std::vector<std::string_view> values{
+            strings.begin(), strings.end()};
+        nanosPerValue = measure<T>(pool, encodingType, values);
+      }
+
+      if (!nanosPerValue.has_value()) {
+        continue;
+      }
+      LOG(INFO) << "Encoding: " << encodingType << ", Data Type: " << dataType
+                << ", Bit Width: " << bitWidth
+                << ", Nanos Per Value: " << nanosPerValue.value();
+      model.setCost(encodingType, dataType, bitWidth, nanosPerValue.value());
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  auto init = init::InitFacebookLight{&argc, &argv};
+  rng.seed(FLAGS_seed);
+
+  auto pool = facebook::velox::memory::deprecatedAddDefaultLeafMemoryPool();
+  nimble::ReadCostModel model;
+  calibrate<int8_t>(*pool, model);
+  calibrate<uint8_t>(*pool, model);
+  calibrate<int16_t>(*pool, model);
+  calibrate<uint16_t>(*pool, model);
+  calibrate<int32_t>(*pool, model);
+  calibrate<uint32_t>(*pool, model);
+  calibrate<int64_t>(*pool, model);
+  calibrate<uint64_t>(*pool, model);
+  calibrate<float>(*pool, model);
+  calibrate<double>(*pool, model);
+  calibrate<bool>(*pool, model);
+  calibrate<std::string_view>(*pool, model);
+
+  if (FLAGS_output.empty()) {
+    std::cout << model.serialize() << std::endl;
+  } else {
+    std::ofstream file{FLAGS_output};
+    file << model.serialize();
+  }
+}
@@ -16,6 +16,7 @@
 #include "dwio/nimble/velox/ChunkedStream.h"
 #include "dwio/nimble/common/EncodingPrimitives.h"
 #include "dwio/nimble/common/Exceptions.h"
+#include "dwio/nimble/tablet/Constants.h"
 #include "dwio/nimble/tablet/Compression.h"
 #include "folly/io/Cursor.h"
 
@@ -35,7 +36,6 @@ bool InMemoryChunkedStream::hasNext() {
 
 std::string_view InMemoryChunkedStream::nextChunk() {
   ensureLoaded();
-  uncompressed_.clear();
   NIMBLE_ASSERT(
       sizeof(uint32_t) + sizeof(char) <=
           stream_.size() - (pos_ - stream_.data()),
@@ -51,15 +51,28 @@ std::string_view InMemoryChunkedStream::nextChunk() {
       chunk = {pos_, length};
       break;
     }
+    // Chunks are decompressed into the same buffer, so its allocation is
+    // reused across chunks (the previous chunk is no longer accessible).
     case CompressionType::Zstd: {
-      uncompressed_ = ZstdCompression::uncompress(
-          *uncompressed_.memoryPool(), {pos_, length});
+      ZstdCompression::uncompress({pos_, length}, uncompressed_);
+      chunk = {uncompressed_.data(), uncompressed_.size()};
+      break;
+    }
+    case CompressionType::ZstdDictionary: {
+      NIMBLE_CHECK(
+          dictionary_ != nullptr,
+          fmt::format(
+              "Stream chunk is compressed using the file's zstd dictionary, "
+              "but the dictionary (section '{}') was not loaded.",
+              kZstdDictionarySection));
+      ZstdCompression::uncompress({pos_, length}, uncompressed_, dictionary_);
       chunk = {uncompressed_.data(), uncompressed_.size()};
       break;
     }
     default: {
-      NIMBLE_UNREACHABLE(fmt::format(
-          "Unexpected stream compression type: ", toString(compressionType)));
+      NIMBLE_NOT_SUPPORTED(fmt::format(
+          "Unsupported stream compression type: {}",
+          toString(compressionType)));
     }
   }
   pos_ += length;
@@ -77,8 +90,18 @@ CompressionType InMemoryChunkedStream::peekCompressionType() {
 }
 
 void InMemoryChunkedStream::reset() {
-  uncompressed_.clear();
   pos_ = stream_.data();
 }
 
+std::shared_ptr<const ZstdDictionary> loadZstdDictionary(
+    const TabletReader& tabletReader) {
+  auto section =
+      tabletReader.loadOptionalSection(std::string(kZstdDictionarySection));
+  if (!section.has_value()) {
+    return nullptr;
+  }
+  return std::make_shared<const ZstdDictionary>(
+      std::string(section->content()));
+}
+
 } // namespace facebook::nimble
@@ -21,6 +21,7 @@
 
 #include "dwio/nimble/common/Types.h"
 #include "dwio/nimble/common/Vector.h"
+#include "dwio/nimble/tablet/Compression.h"
 #include "dwio/nimble/tablet/TabletReader.h"
 #include "folly/io/IOBuf.h"
 
@@ -41,10 +42,14 @@ class ChunkedStream {
 
 class InMemoryChunkedStream : public ChunkedStream {
  public:
+  // |dictionary| is required if the stream contains chunks compressed using
+  // the file zstd dictionary (see loadZstdDictionary()).
   InMemoryChunkedStream(
       velox::memory::MemoryPool& memoryPool,
-      std::unique_ptr<StreamLoader> streamLoader)
+      std::unique_ptr<StreamLoader> streamLoader,
+      const ZstdDictionary* dictionary = nullptr)
       : streamLoader_{std::move(streamLoader)},
+        dictionary_{dictionary},
         pos_{nullptr},
         uncompressed_{&memoryPool} {}
 
@@ -60,9 +65,15 @@ class InMemoryChunkedStream : public ChunkedStream {
   void ensureLoaded();
 
   std::unique_ptr<StreamLoader> streamLoader_;
+  const ZstdDictionary* dictionary_;
   std::string_view stream_;
   const char* pos_;
   Vector<char> uncompressed_;
 };
 
+// Loads the zstd dictionary used to compress small streams in the file.
+// Returns nullptr if the file has no dictionary.
+std::shared_ptr<const ZstdDictionary> loadZstdDictionary(
+    const TabletReader& tabletReader);
+
 } // namespace facebook::nimble
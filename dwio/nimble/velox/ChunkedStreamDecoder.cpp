@@ -72,7 +72,7 @@ void bufferStringContent(
 uint32_t ChunkedStreamDecoder::next(
     uint32_t count,
     void* output,
-    std::function<void*()> nulls,
+    folly::FunctionRef<void*()> nulls,
     const bits::Bitmap* scatterBitmap) {
   stringBuffers_.clear();
 
@@ -91,7 +91,7 @@ uint32_t ChunkedStreamDecoder::next(
   bool hasNulls = false;
   uint32_t offset = 0;
   void* nullsPtr = nullptr;
-  std::function<void*()> initNulls = [&]() {
+  auto initNulls = [&]() {
     if (!nullsPtr) {
       nullsPtr = nulls();
     }
@@ -174,12 +174,60 @@ void ChunkedStreamDecoder::reset() {
   remaining_ = 0;
 }
 
+void ChunkedStreamDecoder::resetStream(
+    std::unique_ptr<ChunkedStream> stream,
+    std::shared_ptr<DecodingArena> arena) {
+  stream_ = std::move(stream);
+  arena_ = std::move(arena);
+  remaining_ = 0;
+  // The buffers of an encoding created from another stream's arena live in
+  // that arena. Drop the encoding rather than recycling it, so the previous
+  // stripe's arena is released along with the stripe.
+  if (encodingArena_ != nullptr && encodingArena_ != arena_) {
+    encoding_.reset();
+    encodingArena_.reset();
+  }
+}
+
 void ChunkedStreamDecoder::ensureLoaded() {
   if (UNLIKELY(remaining_ == 0)) {
-    encoding_ = EncodingFactory::decode(pool_, stream_->nextChunk());
-    remaining_ = encoding_->rowCount();
-    NIMBLE_ASSERT(remaining_ > 0, "Empty chunk");
+    decodeChunk(stream_->nextChunk());
+  }
+}
+
+void ChunkedStreamDecoder::ensureLoaded(
+    velox::CpuWallTiming& decompressTiming,
+    velox::CpuWallTiming& decodeTiming) {
+  if (remaining_ == 0) {
+    std::string_view chunk;
+    {
+      velox::CpuWallTimer timer{decompressTiming};
+      chunk = stream_->nextChunk();
+    }
+    velox::CpuWallTimer timer{decodeTiming};
+    decodeChunk(chunk);
+  }
+}
+
+void ChunkedStreamDecoder::decodeChunk(std::string_view chunk) {
+  if (!reuseEncodings_ || !reinitializeEncoding(chunk)) {
+    DecodingArenaScope scope{arena_.get()};
+    encoding_ = EncodingFactory::decode(pool_, chunk);
+    encodingArena_ = arena_;
+  }
+  remaining_ = encoding_->rowCount();
+  NIMBLE_ASSERT(remaining_ > 0, "Empty chunk");
+}
+
+bool ChunkedStreamDecoder::reinitializeEncoding(std::string_view chunk) {
+  if (encoding_ == nullptr) {
+    return false;
   }
+  // New nested encodings may only allocate from the arena the encoding was
+  // created with (encodings created from another arena are dropped in
+  // resetStream()).
+  DecodingArenaScope scope{encodingArena_.get()};
+  return EncodingFactory::reinitialize(*encoding_, chunk);
 }
 
 } // namespace facebook::nimble
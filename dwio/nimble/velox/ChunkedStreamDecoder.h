@@ -15,10 +15,12 @@
  */
 #pragma once
 
+#include "dwio/nimble/common/DecodingArena.h"
 #include "dwio/nimble/common/MetricsLogger.h"
 #include "dwio/nimble/encodings/Encoding.h"
 #include "dwio/nimble/velox/ChunkedStream.h"
 #include "dwio/nimble/velox/Decoder.h"
+#include "velox/common/time/CpuWallTimer.h"
 
 namespace facebook::nimble {
 
@@ -27,13 +29,19 @@ class ChunkedStreamDecoder : public Decoder {
   ChunkedStreamDecoder(
       velox::memory::MemoryPool& pool,
       std::unique_ptr<ChunkedStream> stream,
-      const MetricsLogger& logger)
-      : pool_{pool}, stream_{std::move(stream)}, logger_{logger} {}
+      const MetricsLogger& logger,
+      std::shared_ptr<DecodingArena> arena = nullptr,
+      bool reuseEncodings = false)
+      : pool_{pool},
+        arena_{std::move(arena)},
+        stream_{std::move(stream)},
+        logger_{logger},
+        reuseEncodings_{reuseEncodings} {}
 
   uint32_t next(
       uint32_t count,
       void* output,
-      std::function<void*()> nulls = nullptr,
+      folly::FunctionRef<void*()> nulls = {},
       const bits::Bitmap* scatterBitmap = nullptr) override;
 
   void skip(uint32_t count) override;
@@ -42,17 +50,49 @@ class ChunkedStreamDecoder : public Decoder {
 
   void ensureLoaded();
 
+  // Same as ensureLoaded(), adding the time spent loading (i.e.
+  // decompressing) the chunk to |decompressTiming|, and the time spent
+  // decoding it (i.e. creating or re-initializing its encoding) to
+  // |decodeTiming|. Meant for the first chunk of a stripe; reads use the
+  // untimed version.
+  void ensureLoaded(
+      velox::CpuWallTiming& decompressTiming,
+      velox::CpuWallTiming& decodeTiming);
+
+  // Starts decoding |stream| (e.g. the same stream, in the next stripe) from
+  // its first chunk. The current encoding is kept, and re-initialized on the
+  // new chunks when their layout matches (if |reuseEncodings|), unless it was
+  // created from another arena than |arena|.
+  void resetStream(
+      std::unique_ptr<ChunkedStream> stream,
+      std::shared_ptr<DecodingArena> arena = nullptr);
+
   const Encoding* encoding() const override {
     return encoding_.get();
   }
 
  private:
+  // Creates (or re-initializes) encoding_ on |chunk|.
+  void decodeChunk(std::string_view chunk);
+
+  // Re-initializes encoding_ on |chunk|. Returns false if encoding_ can't be
+  // reused, i.e. a new encoding must be created.
+  bool reinitializeEncoding(std::string_view chunk);
+
   velox::memory::MemoryPool& pool_;
+  // Optional arena for the encodings' buffers.
+  std::shared_ptr<DecodingArena> arena_;
+  // The arena encoding_ was created with, if any. Either nullptr or arena_.
+  // Declared before encoding_, so it outlives it.
+  std::shared_ptr<DecodingArena> encodingArena_;
   std::unique_ptr<ChunkedStream> stream_;
   std::unique_ptr<Encoding> encoding_;
   uint32_t remaining_{0};
   const MetricsLogger& logger_;
   std::vector<Vector<char>> stringBuffers_;
+  // Re-initialize encoding_ on new chunks (when their layout matches),
+  // instead of creating a new encoding for each chunk.
+  const bool reuseEncodings_;
 };
 
 } // namespace facebook::nimble
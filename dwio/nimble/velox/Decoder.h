@@ -16,8 +16,8 @@
 #pragma once
 
 #include <cstdint>
-#include <functional>
 #include "dwio/nimble/common/Bits.h"
+#include "folly/Function.h"
 
 namespace facebook::nimble {
 
@@ -30,7 +30,7 @@ class Decoder {
   virtual uint32_t next(
       uint32_t count,
       void* output,
-      std::function<void*()> nulls = nullptr,
+      folly::FunctionRef<void*()> nulls = {},
       const bits::Bitmap* scatterBitmap = nullptr) = 0;
 
   virtual void skip(uint32_t count) = 0;
@@ -1195,7 +1195,7 @@ class ArrayWithOffsetsFieldReader final : public MultiValueFieldReader {
 
   uint32_t getIndicesDeduplicated(
       OffsetType* indices,
-      std::function<void*()> nulls,
+      folly::FunctionRef<void*()> nulls,
       uint32_t& nonNullCount,
       uint32_t count,
       const bits::Bitmap* scatterBitmap = nullptr) {
@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <optional>
 #include <vector>
+#include "dwio/nimble/common/DecodingArena.h"
 #include "dwio/nimble/common/Exceptions.h"
 #include "dwio/nimble/tablet/Constants.h"
 #include "dwio/nimble/velox/ChunkedStreamDecoder.h"
@@ -115,6 +116,7 @@ class NimbleUnit : public velox::dwio::common::LoadUnit {
 
 void NimbleUnit::load() {
   velox::CpuWallTiming timing{};
+  TabletReader::LoadStats loadStats;
   {
     velox::CpuWallTimer timer{timing};
     if (!stripeIdentifier_.has_value()) {
@@ -125,10 +127,14 @@ void NimbleUnit::load() {
         streamIdentifiers_,
         [this](offset_size offset) {
           return streamLabels_.streamLabel(offset);
-        });
+        },
+        &loadStats);
   }
   metrics_.cpuUsec = timing.cpuNanos / 1000;
   metrics_.wallTimeUsec = timing.wallNanos / 1000;
+  metrics_.ioRegionCount = loadStats.regionCount;
+  metrics_.ioBytesRequested = loadStats.bytesRequested;
+  metrics_.ioWallTimeUsec = loadStats.wallTimeNanos / 1000;
 }
 
 void NimbleUnit::unload() {
@@ -151,7 +157,8 @@ uint64_t NimbleUnit::getIoSize() {
 } // namespace
 
 const std::vector<std::string>& VeloxReader::preloadedOptionalSections() {
-  static std::vector<std::string> sections{std::string(kSchemaSection)};
+  static std::vector<std::string> sections{
+      std::string(kSchemaSection), std::string(kZstdDictionarySection)};
   return sections;
 }
 
@@ -192,6 +199,7 @@ VeloxReader::VeloxReader(
       tabletReader_{std::move(tabletReader)},
       parameters_{std::move(params)},
       schema_{loadSchema(*tabletReader_)},
+      zstdDictionary_{loadZstdDictionary(*tabletReader_)},
       type_{
           selector ? selector->getSchema()
                    : std::dynamic_pointer_cast<const velox::RowType>(
@@ -304,8 +312,17 @@ void VeloxReader::loadNextStripe() {
   try {
     StripeLoadMetrics metrics;
     velox::CpuWallTiming timing{};
+    velox::CpuWallTiming waitTiming{};
+    // Summed across the stripe's streams.
+    velox::CpuWallTiming decompressTiming{};
+    velox::CpuWallTiming decodeTiming{};
     {
-      auto& unit = unitLoader_->getLoadedUnit(getUnitIndex(nextStripe_));
+      velox::dwio::common::LoadUnit* loadedUnit;
+      {
+        velox::CpuWallTimer timer{waitTiming};
+        loadedUnit = &unitLoader_->getLoadedUnit(getUnitIndex(nextStripe_));
+      }
+      auto& unit = *loadedUnit;
 
       velox::CpuWallTimer timer{timing};
       auto* nimbleUnit = dynamic_cast<NimbleUnit*>(&unit);
@@ -315,6 +332,10 @@ void VeloxReader::loadNextStripe() {
       metrics.totalStreamSize = nimbleUnit->getIoSize();
 
       auto streams = nimbleUnit->extractStreamLoaders();
+      // Shared by the stripe's decoders. Released with the last of them.
+      auto arena = parameters_.useDecodingArena
+          ? std::make_shared<DecodingArena>(pool_)
+          : nullptr;
       for (uint32_t i = 0; i < streams.size(); ++i) {
         if (!streams[i]) {
           // As this stream is not present in current stripe (might be present
@@ -324,22 +345,43 @@ void VeloxReader::loadNextStripe() {
           decoders_[offsets_[i]] = nullptr;
         } else {
           ++metrics.streamCount;
-          decoders_[offsets_[i]] = std::make_unique<ChunkedStreamDecoder>(
-              pool_,
-              std::make_unique<InMemoryChunkedStream>(
-                  pool_, std::move(streams[i])),
-              *logger_);
-          dynamic_cast<ChunkedStreamDecoder*>(decoders_[offsets_[i]].get())
-              ->ensureLoaded();
+          auto stream = std::make_unique<InMemoryChunkedStream>(
+              pool_, std::move(streams[i]), zstdDictionary_.get());
+          auto& decoder = decoders_[offsets_[i]];
+          if (decoder && parameters_.reuseEncodings) {
+            dynamic_cast<ChunkedStreamDecoder*>(decoder.get())
+                ->resetStream(std::move(stream), arena);
+          } else {
+            decoder = std::make_unique<ChunkedStreamDecoder>(
+                pool_,
+                std::move(stream),
+                *logger_,
+                arena,
+                parameters_.reuseEncodings);
+          }
+          auto* chunkedDecoder =
+              dynamic_cast<ChunkedStreamDecoder*>(decoder.get());
+          chunkedDecoder->ensureLoaded(decompressTiming, decodeTiming);
+          ++metrics.encodingHistogram[chunkedDecoder->encoding()
+                                          ->encodingType()];
         }
       }
       loadedStripe_ = nextStripe_++;
       rootReader_ = rootFieldReaderFactory_->createReader(decoders_);
+      if (arena) {
+        auto arenaStats = arena->stats();
+        metrics.arenaAllocationCount = arenaStats.allocationCount;
+        metrics.arenaChunkCount = arenaStats.chunkCount;
+        metrics.arenaChunkBytes = arenaStats.chunkBytes;
+      }
     }
     metrics.stripeIndex = loadedStripe_.value();
     metrics.rowsInStripe = rowsRemainingInStripe_;
     metrics.cpuUsec += timing.cpuNanos / 1000;
     metrics.wallTimeUsec += timing.wallNanos / 1000;
+    metrics.ioWaitUsec = waitTiming.wallNanos / 1000;
+    metrics.decompressCpuUsec = decompressTiming.cpuNanos / 1000;
+    metrics.decodeCpuUsec = decodeTiming.cpuNanos / 1000;
     logger_->logStripeLoad(metrics);
   } catch (const std::exception& e) {
     logger_->logException(LogOperation::StripeLoad, e.what());
@@ -19,6 +19,7 @@
 #include "dwio/nimble/common/MetricsLogger.h"
 #include "dwio/nimble/common/Types.h"
 #include "dwio/nimble/common/Vector.h"
+#include "dwio/nimble/tablet/Compression.h"
 #include "dwio/nimble/tablet/TabletReader.h"
 #include "dwio/nimble/velox/FieldReader.h"
 #include "dwio/nimble/velox/SchemaReader.h"
@@ -65,6 +66,14 @@ struct VeloxReadParams : public FieldReaderParams {
   // Factory with the algorithm to load stripes (units).
   // If nullptr we'll use the default one, that doesn't pre-load stripes.
   std::shared_ptr<velox::dwio::common::UnitLoaderFactory> unitLoaderFactory;
+
+  // Allocate the small buffers of the stripe's encodings from a per-stripe
+  // arena, released when the stripe is unloaded.
+  bool useDecodingArena = false;
+
+  // Reuse the encodings of the previous stripe (and chunk) of each stream,
+  // when the next chunk has the same layout, instead of creating new ones.
+  bool reuseEncodings = false;
 };
 
 class VeloxReader {
@@ -168,6 +177,7 @@ class VeloxReader {
   std::optional<TabletReader::StripeIdentifier> stripeIdentifier_;
   const VeloxReadParams parameters_;
   std::shared_ptr<const Type> schema_;
+  std::shared_ptr<const ZstdDictionary> zstdDictionary_;
   std::shared_ptr<const velox::RowType> type_;
   std::vector<uint32_t> offsets_;
   folly::F14FastMap<offset_size, std::unique_ptr<Decoder>> decoders_;
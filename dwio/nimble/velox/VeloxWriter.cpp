@@ -15,14 +15,17 @@
  */
 #include "dwio/nimble/velox/VeloxWriter.h"
 
+#include <algorithm>
 #include <ios>
 #include <memory>
 
+#include "dwio/nimble/common/EncodingPrimitives.h"
 #include "dwio/nimble/common/Exceptions.h"
 #include "dwio/nimble/common/Types.h"
 #include "dwio/nimble/encodings/Encoding.h"
 #include "dwio/nimble/encodings/EncodingSelectionPolicy.h"
 #include "dwio/nimble/encodings/SentinelEncoding.h"
+#include "dwio/nimble/tablet/Compression.h"
 #include "dwio/nimble/tablet/Constants.h"
 #include "dwio/nimble/velox/BufferGrowthPolicy.h"
 #include "dwio/nimble/velox/ChunkedStreamWriter.h"
@@ -211,6 +214,115 @@ std::string_view encodeStream(
   }
 }
 
+uint32_t scalarKindSize(ScalarKind scalarKind) {
+  switch (scalarKind) {
+    case ScalarKind::Bool:
+    case ScalarKind::Int8:
+    case ScalarKind::UInt8:
+      return 1;
+    case ScalarKind::Int16:
+    case ScalarKind::UInt16:
+      return 2;
+    case ScalarKind::Int32:
+    case ScalarKind::UInt32:
+    case ScalarKind::Float:
+      return 4;
+    case ScalarKind::Int64:
+    case ScalarKind::UInt64:
+    case ScalarKind::Double:
+      return 8;
+    case ScalarKind::String:
+    case ScalarKind::Binary:
+      return sizeof(std::string_view);
+    default:
+      NIMBLE_UNREACHABLE(
+          fmt::format("Unsupported scalar kind {}", toString(scalarKind)));
+  }
+}
+
+// A view over a range of rows of a stream. Used to split large streams into
+// several chunks, which can be encoded independently.
+class StreamDataSlice : public StreamData {
+ public:
+  StreamDataSlice(
+      const StreamData& streamData,
+      std::string_view data,
+      std::span<const bool> nonNulls)
+      : StreamData(streamData.descriptor()),
+        data_{data},
+        nonNulls_{nonNulls},
+        hasNulls_{
+            std::find(nonNulls.begin(), nonNulls.end(), false) !=
+            nonNulls.end()} {}
+
+  std::string_view data() const override {
+    return data_;
+  }
+
+  std::span<const bool> nonNulls() const override {
+    return nonNulls_;
+  }
+
+  bool hasNulls() const override {
+    return hasNulls_;
+  }
+
+  bool empty() const override {
+    return data_.empty() && nonNulls_.empty();
+  }
+
+  uint64_t memoryUsed() const override {
+    return data_.size() + nonNulls_.size();
+  }
+
+  // The sliced stream is reset once all its slices are encoded.
+  void reset() override {}
+
+ private:
+  const std::string_view data_;
+  const std::span<const bool> nonNulls_;
+  const bool hasNulls_;
+};
+
+// Splits a stream into (up to) |sliceCount| slices, with the same number of
+// rows. Returns an empty vector if the stream can't be split.
+std::vector<std::unique_ptr<StreamData>> sliceStream(
+    const StreamData& streamData,
+    uint64_t sliceCount) {
+  const auto elementSize =
+      scalarKindSize(streamData.descriptor().scalarKind());
+  const auto data = streamData.data();
+  const auto hasNulls = streamData.hasNulls();
+  const auto nonNulls =
+      hasNulls ? streamData.nonNulls() : std::span<const bool>{};
+  const uint64_t rowCount =
+      hasNulls ? nonNulls.size() : data.size() / elementSize;
+  sliceCount = std::min(sliceCount, rowCount);
+
+  std::vector<std::unique_ptr<StreamData>> slices;
+  if (sliceCount <= 1) {
+    return slices;
+  }
+
+  slices.reserve(sliceCount);
+  uint64_t valueOffset = 0;
+  for (uint64_t i = 0; i < sliceCount; ++i) {
+    const auto rowBegin = rowCount * i / sliceCount;
+    const auto rowEnd = rowCount * (i + 1) / sliceCount;
+    const uint64_t valueCount = hasNulls
+        ? std::count(
+              nonNulls.begin() + rowBegin, nonNulls.begin() + rowEnd, true)
+        : rowEnd - rowBegin;
+    slices.push_back(std::make_unique<StreamDataSlice>(
+        streamData,
+        data.substr(valueOffset * elementSize, valueCount * elementSize),
+        hasNulls ? nonNulls.subspan(rowBegin, rowEnd - rowBegin)
+                 : std::span<const bool>{}));
+    valueOffset += valueCount;
+  }
+  return slices;
+}
+
 template <typename Set>
 void findNodeIds(
     const velox::dwio::common::TypeWithId& typeWithId,
@@ -561,6 +673,11 @@ void VeloxWriter::close() {
             serializer.serialize(context_->schemaBuilder));
       }
 
+      if (zstdDictionary_) {
+        writer_.writeOptionalSection(
+            std::string(kZstdDictionarySection), zstdDictionary_->content());
+      }
+
       writer_.close();
       file_->close();
       context_->bytesWritten = file_->size();
@@ -656,18 +773,42 @@ void VeloxWriter::writeChunk(bool lastChunk) {
       StreamData& streamData_;
     };
 
-    auto encode = [&](StreamData& streamData) {
-      const auto offset = streamData.descriptor().offset();
+    // Encodes a stream (or a slice of it) into chunks.
+    auto encode = [&](StreamData& streamData,
+                      std::vector<std::string_view>& chunks) {
       auto encoded = encodeStream(*context_, *encodingBuffer_, streamData);
       if (!encoded.empty()) {
         ChunkedStreamWriter chunkWriter{*encodingBuffer_};
-        NIMBLE_DASSERT(offset < streams_.size(), "Stream offset out of range.");
-        auto& stream = streams_[offset];
         for (auto& buffer : chunkWriter.encode(encoded)) {
           chunkSize += buffer.size();
-          stream.content.push_back(std::move(buffer));
+          chunks.push_back(std::move(buffer));
         }
       }
+    };
+
+    // Appends the encoded chunks to the stripe stream, and reports the
+    // stream encoding metrics.
+    auto commit = [&](StreamData& streamData,
+                      std::vector<std::string_view>& chunks,
+                      uint32_t sliceCount,
+                      const velox::CpuWallTiming& timing) {
+      const auto offset = streamData.descriptor().offset();
+      NIMBLE_DASSERT(offset < streams_.size(), "Stream offset out of range.");
+      auto& content = streams_[offset].content;
+      uint64_t encodedSize = 0;
+      for (auto& chunk : chunks) {
+        encodedSize += chunk.size();
+        content.push_back(chunk);
+      }
+      context_->logger->logStreamEncode(StreamEncodeMetrics{
+          .stripeIndex = context_->getStripeIndex(),
+          .streamOffset = offset,
+          .rawSize = streamData.memoryUsed(),
+          .encodedSize = encodedSize,
+          .sliceCount = sliceCount,
+          .cpuUsec = timing.cpuNanos / 1000,
+          .wallTimeUsec = timing.wallNanos / 1000,
+      });
       streamData.reset();
     };
 
@@ -700,35 +841,108 @@ void VeloxWriter::writeChunk(bool lastChunk) {
       }
     };
 
+    std::vector<std::unique_ptr<NullsAsDataStreamData>> nullsStreams;
+    std::vector<StreamData*> streamsToEncode;
+    for (auto& streamData : context_->streams()) {
+      processStream(
+          *streamData, [&](StreamData& innerStreamData, bool isNullStream) {
+            if (isNullStream) {
+              nullsStreams.push_back(
+                  std::make_unique<NullsAsDataStreamData>(innerStreamData));
+              streamsToEncode.push_back(nullsStreams.back().get());
+            } else {
+              streamsToEncode.push_back(&innerStreamData);
+            }
+          });
+    }
+
     if (context_->options.encodingExecutor) {
+      // Each task encodes a stream, or a slice of a large stream. Tasks are
+      // scheduled largest first, so large streams don't end up serializing
+      // the tail of the flush. Slices of the same stream are encoded into
+      // separate chunks, which are committed in order once all tasks
+      // complete.
+      struct EncodingTask {
+        StreamData* stream;
+        StreamData* slice;
+        uint32_t sliceCount;
+        uint64_t size;
+        std::vector<std::string_view> chunks;
+        velox::CpuWallTiming timing;
+      };
+
+      const auto splitSize = context_->options.encodingSplitRawSize;
+      std::vector<std::unique_ptr<StreamData>> slices;
+      std::vector<EncodingTask> tasks;
+      tasks.reserve(streamsToEncode.size());
+      for (auto* streamData : streamsToEncode) {
+        const auto size = streamData->memoryUsed();
+        auto streamSlices = splitSize > 0 && size > splitSize
+            ? sliceStream(*streamData, (size + splitSize - 1) / splitSize)
+            : std::vector<std::unique_ptr<StreamData>>{};
+        if (streamSlices.empty()) {
+          tasks.push_back({
+              .stream = streamData,
+              .slice = streamData,
+              .sliceCount = 1,
+              .size = size,
+          });
+          continue;
+        }
+
+        const uint32_t sliceCount = streamSlices.size();
+        for (auto& slice : streamSlices) {
+          tasks.push_back({
+              .stream = streamData,
+              .slice = slice.get(),
+              .sliceCount = sliceCount,
+              .size = slice->memoryUsed(),
+          });
+          slices.push_back(std::move(slice));
+        }
+      }
+
+      std::vector<EncodingTask*> schedule;
+      schedule.reserve(tasks.size());
+      for (auto& task : tasks) {
+        schedule.push_back(&task);
+      }
+      std::stable_sort(
+          schedule.begin(), schedule.end(), [](const auto* a, const auto* b) {
+            return a->size > b->size;
+          });
+
       velox::dwio::common::ExecutorBarrier barrier{
           context_->options.encodingExecutor};
-      for (auto& streamData : context_->streams()) {
-        processStream(
-            *streamData, [&](StreamData& innerStreamData, bool isNullStream) {
-              barrier.add([&innerStreamData, isNullStream, &encode]() {
-                if (isNullStream) {
-                  NullsAsDataStreamData nullsStreamData{innerStreamData};
-                  encode(nullsStreamData);
-                } else {
-                  encode(innerStreamData);
-                }
-              });
-            });
+      for (auto* task : schedule) {
+        barrier.add([task, &encode]() {
+          velox::CpuWallTimer timer{task->timing};
+          encode(*task->slice, task->chunks);
+        });
       }
       barrier.waitAll();
+
+      // Tasks are ordered by stream, and by slice within each stream.
+      for (size_t i = 0; i < tasks.size();) {
+        auto* stream = tasks[i].stream;
+        std::vector<std::string_view> chunks;
+        velox::CpuWallTiming timing;
+        for (; i < tasks.size() && tasks[i].stream == stream; ++i) {
+          chunks.insert(
+              chunks.end(), tasks[i].chunks.begin(), tasks[i].chunks.end());
+          timing.add(tasks[i].timing);
+        }
+        commit(*stream, chunks, tasks[i - 1].sliceCount, timing);
+      }
     } else {
-      for (auto& streamData : context_->streams()) {
-        processStream(
-            *streamData,
-            [&encode](StreamData& innerStreamData, bool isNullStream) {
-              if (isNullStream) {
-                NullsAsDataStreamData nullsStreamData{innerStreamData};
-                encode(nullsStreamData);
-              } else {
-                encode(innerStreamData);
-              }
-            });
+      for (auto* streamData : streamsToEncode) {
+        std::vector<std::string_view> chunks;
+        velox::CpuWallTiming timing;
+        {
+          velox::CpuWallTimer timer{timing};
+          encode(*streamData, chunks);
+        }
+        commit(*streamData, chunks, 1, timing);
       }
     }
 
@@ -756,6 +970,10 @@ uint32_t VeloxWriter::writeStripe() {
     LoggingScope scope{*context_->logger};
     velox::CpuWallTimer veloxTimer{context_->stripeFlushTiming};
 
+    if (context_->options.enableZstdDictionary) {
+      compressSmallStreams();
+    }
+
     size_t nonEmptyCount = 0;
     for (auto i = 0; i < streams_.size(); ++i) {
       auto& source = streams_[i];
@@ -793,6 +1011,79 @@ uint32_t VeloxWriter::writeStripe() {
   return static_cast<uint32_t>(stripeSize);
 }
 
+void VeloxWriter::compressSmallStreams() {
+  // Stream content is a sequence of chunks, each made of a header (chunk size
+  // and compression type) followed by the chunk payload (see
+  // ChunkedStreamWriter).
+  constexpr uint32_t kHeaderSize = sizeof(uint32_t) + sizeof(CompressionType);
+  const auto& options = context_->options;
+  auto isUncompressedChunk = [](std::string_view header) {
+    NIMBLE_DASSERT(header.size() == kHeaderSize, "Unexpected chunk header.");
+    return static_cast<CompressionType>(header[sizeof(uint32_t)]) ==
+        CompressionType::Uncompressed;
+  };
+
+  std::vector<Stream*> smallStreams;
+  for (auto& stream : streams_) {
+    if (stream.content.empty()) {
+      continue;
+    }
+    NIMBLE_DASSERT(
+        stream.content.size() % 2 == 0, "Unexpected stream content.");
+    uint64_t size = 0;
+    for (auto i = 1; i < stream.content.size(); i += 2) {
+      size += stream.content[i].size();
+    }
+    if (size <= options.zstdDictionaryMaxStreamSize) {
+      smallStreams.push_back(&stream);
+    }
+  }
+
+  if (!zstdDictionary_) {
+    std::vector<std::string_view> samples;
+    for (auto* stream : smallStreams) {
+      for (auto i = 0; i < stream->content.size(); i += 2) {
+        if (isUncompressedChunk(stream->content[i])) {
+          samples.push_back(stream->content[i + 1]);
+        }
+      }
+    }
+    auto dictionary =
+        ZstdDictionary::train(samples, options.zstdDictionaryMaxSize);
+    if (!dictionary.has_value()) {
+      // Not enough samples. Try again on the next stripe.
+      return;
+    }
+    zstdDictionary_ = std::make_unique<ZstdDictionary>(
+        std::move(dictionary.value()),
+        options.zstdDictionaryCompressionLevel);
+  }
+
+  for (auto* stream : smallStreams) {
+    for (auto i = 0; i < stream->content.size(); i += 2) {
+      auto payload = stream->content[i + 1];
+      if (payload.empty() || !isUncompressedChunk(stream->content[i])) {
+        continue;
+      }
+      auto compressed = ZstdCompression::compress(
+          *encodingMemoryPool_, payload, *zstdDictionary_);
+      if (!compressed.has_value() ||
+          compressed->size() >= payload.size() *
+                  options.compressionOptions.compressionAcceptRatio) {
+        continue;
+      }
+
+      auto* header = encodingBuffer_->reserve(kHeaderSize);
+      auto* pos = header;
+      encoding::writeUint32(compressed->size(), pos);
+      encoding::write(CompressionType::ZstdDictionary, pos);
+      stream->content[i] = {header, kHeaderSize};
+      stream->content[i + 1] =
+          encodingBuffer_->takeOwnership(compressed->releaseOwnership());
+    }
+  }
+}
+
 bool VeloxWriter::tryWriteStripe(bool force) {
   if (context_->rowsInStripe == 0) {
     return false;
@@ -16,6 +16,7 @@
 #pragma once
 
 #include "dwio/nimble/common/Buffer.h"
+#include "dwio/nimble/tablet/Compression.h"
 #include "dwio/nimble/tablet/TabletWriter.h"
 #include "dwio/nimble/velox/FieldWriter.h"
 #include "dwio/nimble/velox/VeloxWriterOptions.h"
@@ -79,6 +80,7 @@ class VeloxWriter {
 
   std::unique_ptr<Buffer> encodingBuffer_;
   std::vector<Stream> streams_;
+  std::unique_ptr<ZstdDictionary> zstdDictionary_;
   std::exception_ptr lastException_;
   const velox::common::SpillConfig* const spillConfig_;
 
@@ -86,6 +88,7 @@ class VeloxWriter {
   bool tryWriteStripe(bool force = false);
   void writeChunk(bool lastChunk = true);
   uint32_t writeStripe();
+  void compressSmallStreams();
 };
 
 } // namespace facebook::nimble
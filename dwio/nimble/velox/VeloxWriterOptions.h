@@ -127,7 +127,24 @@ struct VeloxWriterOptions {
   // this executor.
   std::shared_ptr<folly::Executor> encodingExecutor;
 
+  // When encoding in parallel (using encodingExecutor), streams with raw size
+  // larger than this threshold are split into several chunks, which are
+  // encoded in parallel. This changes the file layout (split streams have
+  // more, smaller chunks). Zero (the default) disables splitting.
+  uint64_t encodingSplitRawSize = 0;
+
   bool enableChunking = false;
+
+  // When enabled, a zstd dictionary is trained from samples of the small
+  // streams written in the (first) stripe, and is then used to compress all
+  // small streams in the file. The dictionary is stored once, in an optional
+  // section. Small streams (e.g. sparse flat map features) barely compress
+  // on their own, as they don't contain enough data for zstd to learn from.
+  bool enableZstdDictionary = false;
+  // Streams with encoded size up to this threshold are considered small.
+  uint32_t zstdDictionaryMaxStreamSize = 4 * 1024;
+  uint32_t zstdDictionaryMaxSize = 64 * 1024;
+  int32_t zstdDictionaryCompressionLevel = 3;
 };
 
 } // namespace facebook::nimble
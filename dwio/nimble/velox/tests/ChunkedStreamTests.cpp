@@ -15,6 +15,9 @@
  */
 #include <gtest/gtest.h>
 
+#include "dwio/nimble/common/EncodingPrimitives.h"
+#include "dwio/nimble/common/Exceptions.h"
+#include "dwio/nimble/tablet/Compression.h"
 #include "dwio/nimble/velox/ChunkedStream.h"
 #include "dwio/nimble/velox/ChunkedStreamWriter.h"
 
@@ -186,3 +189,48 @@ TEST(ChunkedStreamTests, MultiChunkWithCompression) {
     reader.reset();
   }
 }
+
+TEST(ChunkedStreamTests, DictionaryCompression) {
+  auto memoryPool = velox::memory::deprecatedAddDefaultLeafMemoryPool();
+  std::vector<std::string> samples;
+  for (auto i = 0; i < 1000; ++i) {
+    samples.push_back(fmt::format("category_{}_value_{}", i % 13, i % 7));
+  }
+  auto content = nimble::ZstdDictionary::train(
+      std::vector<std::string_view>{samples.begin(), samples.end()},
+      /* maxSize */ 4096);
+  ASSERT_TRUE(content.has_value());
+  nimble::ZstdDictionary dictionary{
+      std::move(content.value()), /* compressionLevel */ 3};
+
+  std::string data;
+  for (auto i = 0; i < 50; ++i) {
+    data += samples[i];
+  }
+  auto compressed =
+      nimble::ZstdCompression::compress(*memoryPool, data, dictionary);
+  ASSERT_TRUE(compressed.has_value());
+
+  std::string stream(sizeof(uint32_t) + sizeof(char), '\0');
+  auto* pos = stream.data();
+  nimble::encoding::writeUint32(compressed->size(), pos);
+  nimble::encoding::write(nimble::CompressionType::ZstdDictionary, pos);
+  stream.append(compressed->data(), compressed->size());
+
+  // Readers which didn't load the dictionary fail with a clear error, instead
+  // of a zstd error.
+  {
+    nimble::InMemoryChunkedStream reader{
+        *memoryPool, std::make_unique<TestStreamLoader>(stream)};
+    ASSERT_TRUE(reader.hasNext());
+    EXPECT_EQ(
+        nimble::CompressionType::ZstdDictionary, reader.peekCompressionType());
+    EXPECT_THROW(reader.nextChunk(), nimble::NimbleUserError);
+  }
+
+  nimble::InMemoryChunkedStream reader{
+      *memoryPool, std::make_unique<TestStreamLoader>(stream), &dictionary};
+  ASSERT_TRUE(reader.hasNext());
+  EXPECT_EQ(data, reader.nextChunk());
+  EXPECT_FALSE(reader.hasNext());
+}
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "dwio/nimble/velox/VeloxReader.h"
+#include "dwio/nimble/velox/VeloxWriter.h"
+#include "folly/Benchmark.h"
+#include "folly/executors/CPUThreadPoolExecutor.h"
+#include "folly/init/Init.h"
+#include "velox/common/file/File.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+#include "velox/vector/tests/utils/VectorMaker.h"
+
+using namespace ::facebook;
+
+// End to end write/read benchmarks, over datasets shaped like common
+// production tables, and a few writer configurations. Besides time, each
+// benchmark reports (as user counters):
+//  - write_mbps: Raw (flat in-memory) input size written per second.
+//  - read_krps: Thousands of rows read per second.
+//  - peak_mb: Peak memory used by the writer (or reader).
+//  - file_kb: Size of the written file.
+//
+// Run with --bm_min_iters to stabilize the measurements of the larger
+// datasets.
+
+DEFINE_uint32(batch_count, 20, "Batches per dataset.");
+DEFINE_uint32(batch_size, 10000, "Rows per (written) batch.");
+DEFINE_uint32(read_batch_size, 10000, "Rows per read batch.");
+
+namespace {
+
+constexpr uint32_t kSeed = 20240517;
+
+struct Dataset {
+  std::string name;
+  velox::RowTypePtr type;
+  std::vector<velox::RowVectorPtr> batches;
+  // Columns to write as flat maps.
+  folly::F14FastSet<std::string> flatMapColumns;
+};
+
+struct Config {
+  std::string name;
+  std::function<nimble::VeloxWriterOptions()> writerOptions;
+};
+
+std::shared_ptr<velox::memory::MemoryPool> leafPool;
+std::vector<Dataset> datasets;
+std::vector<Config> configs;
+
+std::vector<velox::RowVectorPtr> fuzz(
+    const velox::RowTypePtr& type,
+    double nullRatio,
+    size_t stringLength = 20) {
+  velox::VectorFuzzer::Options options;
+  options.vectorSize = FLAGS_batch_size;
+  options.nullRatio = nullRatio;
+  options.stringLength = stringLength;
+  options.stringVariableLength = true;
+  options.containerLength = 10;
+  options.containerVariableLength = true;
+  velox::VectorFuzzer fuzzer(options, leafPool.get(), kSeed);
+  std::vector<velox::RowVectorPtr> batches;
+  batches.reserve(FLAGS_batch_count);
+  for (auto i = 0; i < FLAGS_batch_count; ++i) {
+    batches.push_back(fuzzer.fuzzInputFlatRow(type));
+  }
+  return batches;
+}
+
+velox::RowTypePtr wideScalarType(size_t columnCount) {
+  const std::vector<velox::TypePtr> types{
+      velox::BIGINT(),
+      velox::INTEGER(),
+      velox::SMALLINT(),
+      velox::DOUBLE(),
+      velox::REAL(),
+      velox::BOOLEAN()};
+  std::vector<std::string> names;
+  std::vector<velox::TypePtr> columnTypes;
+  for (auto i = 0; i < columnCount; ++i) {
+    names.push_back(fmt::format("c{}", i));
+    columnTypes.push_back(types[i % types.size()]);
+  }
+  return velox::ROW(std::move(names), std::move(columnTypes));
+}
+
+// Feature maps, with a fixed universe of |keyCount| keys, of which each row
+// contains a window of up to 100 keys. Written as flat maps.
+std::vector<velox::RowVectorPtr> featureMaps(uint32_t keyCount) {
+  velox::test::VectorMaker maker{leafPool.get()};
+  std::vector<velox::RowVectorPtr> batches;
+  for (auto i = 0; i < FLAGS_batch_count; ++i) {
+    batches.push_back(maker.rowVector(
+        {"id", "features"},
+        {maker.flatVector<int64_t>(
+             FLAGS_batch_size, [i](auto row) { return i * 1'000'000L + row; }),
+         maker.mapVector<int32_t, float>(
+             FLAGS_batch_size,
+             [i](auto row) { return (row + i) % 100; },
+             [keyCount](auto index) { return index % keyCount; },
+             [](auto index) { return index * 0.5f; },
+             [](auto row) { return row % 50 == 0; })}));
+  }
+  return batches;
+}
+
+void initDatasets() {
+  auto wide = wideScalarType(200);
+  datasets.push_back({"WideScalar", wide, fuzz(wide, 0.05)});
+  datasets.push_back({"HighNull", wide, fuzz(wide, 0.9)});
+
+  auto strings = velox::ROW({
+      {"id", velox::BIGINT()},
+      {"url", velox::VARCHAR()},
+      {"title", velox::VARCHAR()},
+      {"body", velox::VARCHAR()},
+      {"tags", velox::ARRAY(velox::VARCHAR())},
+  });
+  datasets.push_back({"StringHeavy", strings, fuzz(strings, 0.05, 200)});
+
+  auto nested = velox::ROW({
+      {"id", velox::BIGINT()},
+      {"events",
+       velox::ARRAY(velox::ROW({
+           {"ts", velox::BIGINT()},
+           {"kind", velox::INTEGER()},
+           {"attributes", velox::MAP(velox::VARCHAR(), velox::DOUBLE())},
+       }))},
+      {"scores", velox::MAP(velox::INTEGER(), velox::ARRAY(velox::REAL()))},
+  });
+  datasets.push_back({"Nested", nested, fuzz(nested, 0.1)});
+
+  auto maps = featureMaps(5000);
+  datasets.push_back(
+      {"FlatMap",
+       velox::asRowType(maps.front()->type()),
+       std::move(maps),
+       {"features"}});
+}
+
+void initConfigs() {
+  configs.push_back({"Default", []() { return nimble::VeloxWriterOptions{}; }});
+  configs.push_back({"Chunking", []() {
+                       nimble::VeloxWriterOptions options;
+                       options.enableChunking = true;
+                       options.flushPolicyFactory = []() {
+                         return std::make_unique<nimble::LambdaFlushPolicy>(
+                             [](const nimble::StripeProgress& progress) {
+                               if (progress.rawStripeSize > 256 << 20) {
+                                 return nimble::FlushDecision::Stripe;
+                               }
+                               return progress.bufferSize > 16 << 20
+                                   ? nimble::FlushDecision::Chunk
+                                   : nimble::FlushDecision::None;
+                             });
+                       };
+                       return options;
+                     }});
+  // Created once, so thread start up isn't measured.
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(8);
+  configs.push_back({"Executor", [executor]() {
+                       nimble::VeloxWriterOptions options;
+                       options.encodingExecutor = executor;
+                       // Large streams are split into several chunks, so
+                       // reading these files is benchmarked as well.
+                       options.encodingSplitRawSize = 16 << 20;
+                       return options;
+                     }});
+  for (auto level : {1, 7}) {
+    configs.push_back({fmt::format("Zstd{}", level), [level]() {
+                         nimble::VeloxWriterOptions options;
+                         options.compressionOptions.compressionType =
+                             nimble::CompressionType::Zstd;
+                         options.compressionOptions.zstdCompressionLevel =
+                             level;
+                         return options;
+                       }});
+  }
+}
+
+uint64_t rawSize(const Dataset& dataset) {
+  uint64_t size = 0;
+  for (const auto& batch : dataset.batches) {
+    size += batch->estimateFlatSize();
+  }
+  return size;
+}
+
+nimble::VeloxWriterOptions writerOptions(
+    const Dataset& dataset,
+    const Config& config) {
+  auto options = config.writerOptions();
+  options.flatMapColumns = dataset.flatMapColumns;
+  return options;
+}
+
+std::string write(
+    const Dataset& dataset,
+    nimble::VeloxWriterOptions options,
+    velox::memory::MemoryPool& rootPool) {
+  std::string file;
+  nimble::VeloxWriter writer{
+      rootPool,
+      dataset.type,
+      std::make_unique<velox::InMemoryWriteFile>(&file),
+      std::move(options)};
+  for (const auto& batch : dataset.batches) {
+    writer.write(batch);
+  }
+  writer.close();
+  return file;
+}
+
+double seconds(std::chrono::steady_clock::duration duration) {
+  return std::chrono::duration<double>(duration).count();
+}
+
+unsigned benchmarkWrite(
+    const Dataset& dataset,
+    const Config& config,
+    folly::UserCounters& counters,
+    unsigned iters) {
+  std::chrono::steady_clock::duration elapsed{};
+  int64_t peakBytes = 0;
+  size_t fileSize = 0;
+  for (auto i = 0; i < iters; ++i) {
+    std::shared_ptr<velox::memory::MemoryPool> rootPool;
+    // Writer options are not assignable.
+    std::optional<nimble::VeloxWriterOptions> options;
+    BENCHMARK_SUSPEND {
+      rootPool = velox::memory::memoryManager()->addRootPool();
+      options.emplace(writerOptions(dataset, config));
+    }
+    auto start = std::chrono::steady_clock::now();
+    fileSize = write(dataset, std::move(options.value()), *rootPool).size();
+    elapsed += std::chrono::steady_clock::now() - start;
+    peakBytes = std::max(peakBytes, rootPool->peakBytes());
+  }
+
+  folly::BenchmarkSuspender suspender;
+  counters["write_mbps"] = static_cast<int64_t>(
+      rawSize(dataset) * iters / seconds(elapsed) / (1 << 20));
+  counters["peak_mb"] = peakBytes >> 20;
+  counters["file_kb"] = static_cast<int64_t>(fileSize >> 10);
+  return iters;
+}
+
+unsigned benchmarkRead(
+    const Dataset& dataset,
+    const Config& config,
+    folly::UserCounters& counters,
+    unsigned iters) {
+  folly::BenchmarkSuspender suspender;
+  auto writePool = velox::memory::memoryManager()->addRootPool();
+  auto file = write(dataset, writerOptions(dataset, config), *writePool);
+  velox::InMemoryReadFile readFile{file};
+  suspender.dismiss();
+
+  std::chrono::steady_clock::duration elapsed{};
+  int64_t peakBytes = 0;
+  uint64_t rowCount = 0;
+  for (auto i = 0; i < iters; ++i) {
+    auto readPool =
+        velox::memory::memoryManager()->addRootPool()->addLeafChild("read");
+    auto start = std::chrono::steady_clock::now();
+    nimble::VeloxReader reader{*readPool, &readFile};
+    velox::VectorPtr result;
+    while (reader.next(FLAGS_read_batch_size, result)) {
+      rowCount += result->size();
+    }
+    elapsed += std::chrono::steady_clock::now() - start;
+    peakBytes = std::max(peakBytes, readPool->peakBytes());
+  }
+
+  suspender.rehire();
+  counters["read_krps"] =
+      static_cast<int64_t>(rowCount / seconds(elapsed) / 1000);
+  counters["peak_mb"] = peakBytes >> 20;
+  counters["file_kb"] = static_cast<int64_t>(file.size() >> 10);
+  return iters;
+}
+
+void registerBenchmarks() {
+  for (const auto& dataset : datasets) {
+    for (const auto& config : configs) {
+      folly::addBenchmark(
+          __FILE__,
+          fmt::format("Write{}_{}", dataset.name, config.name),
+          [&](folly::UserCounters& counters, unsigned iters) {
+            return benchmarkWrite(dataset, config, counters, iters);
+          });
+    }
+  }
+  for (const auto& dataset : datasets) {
+    for (const auto& config : configs) {
+      folly::addBenchmark(
+          __FILE__,
+          fmt::format("Read{}_{}", dataset.name, config.name),
+          [&](folly::UserCounters& counters, unsigned iters) {
+            return benchmarkRead(dataset, config, counters, iters);
+          });
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  velox::memory::MemoryManager::initialize({});
+  leafPool = velox::memory::memoryManager()->addLeafPool();
+
+  initDatasets();
+  initConfigs();
+  registerBenchmarks();
+
+  folly::runBenchmarks();
+  return 0;
+}
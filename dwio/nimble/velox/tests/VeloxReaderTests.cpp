@@ -4978,3 +4978,177 @@ TEST_F(VeloxReaderTests, ReadNonExistingFlatMapFeature) {
       /* readFlatMapFieldAsStruct= */ true,
       /* hasNulls= */ true);
 }
+
+namespace {
+
+class StripeLoadLogger : public nimble::MetricsLogger {
+ public:
+  void logStripeLoad(const nimble::StripeLoadMetrics& metrics) const override {
+    metrics_.push_back(metrics);
+  }
+
+  mutable std::vector<nimble::StripeLoadMetrics> metrics_;
+};
+
+} // namespace
+
+TEST_F(VeloxReaderTests, DecodingArenaWithReusedEncodings) {
+  constexpr auto kStripeCount = 4;
+  constexpr auto kBatchSize = 1000;
+  velox::test::VectorMaker vectorMaker{leafPool_.get()};
+  auto vector = vectorMaker.rowVector(
+      {"int", "string"},
+      {
+          vectorMaker.flatVector<int64_t>(
+              kBatchSize, [](auto row) { return row % 100; }),
+          vectorMaker.flatVector<std::string>(
+              kBatchSize, [](auto row) { return std::to_string(row % 11); }),
+      });
+  auto file = nimble::test::createNimbleFile(
+      *rootPool_, std::vector<velox::VectorPtr>(kStripeCount, vector));
+
+  auto logger = std::make_shared<StripeLoadLogger>();
+  nimble::VeloxReadParams params;
+  params.metricsLogger = logger;
+  params.useDecodingArena = true;
+  params.reuseEncodings = true;
+  velox::InMemoryReadFile readFile(file);
+  nimble::VeloxReader reader(
+      *leafPool_, &readFile, /* selector */ nullptr, std::move(params));
+
+  velox::VectorPtr result;
+  std::vector<int64_t> usedBytes;
+  for (auto stripe = 0; stripe < kStripeCount; ++stripe) {
+    ASSERT_TRUE(reader.next(kBatchSize, result));
+    ASSERT_EQ(kBatchSize, result->size());
+    for (auto i = 0; i < kBatchSize; ++i) {
+      ASSERT_TRUE(result->equalValueAt(vector.get(), i, i));
+    }
+    usedBytes.push_back(leafPool_->usedBytes());
+  }
+  ASSERT_FALSE(reader.next(1, result));
+
+  // Encodings created from a previous stripe's arena are not recycled, so
+  // each stripe decodes into its own arena, and previous arenas are released.
+  ASSERT_EQ(kStripeCount, logger->metrics_.size());
+  const auto& first = logger->metrics_.front();
+  EXPECT_GT(first.arenaAllocationCount, 0);
+  for (const auto& metrics : logger->metrics_) {
+    EXPECT_EQ(first.arenaAllocationCount, metrics.arenaAllocationCount);
+    EXPECT_EQ(first.arenaChunkBytes, metrics.arenaChunkBytes);
+  }
+  for (auto stripe = 2; stripe < kStripeCount; ++stripe) {
+    EXPECT_LE(usedBytes[stripe], usedBytes[1]);
+  }
+}
+
+TEST_F(VeloxReaderTests, StripeLoadMetrics) {
+  constexpr auto kStripeCount = 3;
+  constexpr auto kBatchSize = 1000;
+  velox::test::VectorMaker vectorMaker{leafPool_.get()};
+  auto vector = vectorMaker.rowVector(
+      {"int", "string", "nullable"},
+      {
+          vectorMaker.flatVector<int64_t>(
+              kBatchSize, [](auto row) { return row % 100; }),
+          vectorMaker.flatVector<std::string>(
+              kBatchSize, [](auto row) { return std::to_string(row % 11); }),
+          vectorMaker.flatVector<double>(
+              kBatchSize,
+              [](auto row) { return row * 0.5; },
+              [](auto row) { return row % 3 == 0; }),
+      });
+  auto file = nimble::test::createNimbleFile(
+      *rootPool_, std::vector<velox::VectorPtr>(kStripeCount, vector));
+
+  auto logger = std::make_shared<StripeLoadLogger>();
+  nimble::VeloxReadParams params;
+  params.metricsLogger = logger;
+  velox::InMemoryReadFile readFile(file);
+  nimble::VeloxReader reader(
+      *leafPool_, &readFile, /* selector */ nullptr, std::move(params));
+
+  velox::VectorPtr result;
+  while (reader.next(kBatchSize, result)) {
+  }
+
+  ASSERT_EQ(kStripeCount, logger->metrics_.size());
+  for (auto stripe = 0; stripe < kStripeCount; ++stripe) {
+    const auto& metrics = logger->metrics_[stripe];
+    EXPECT_EQ(stripe, metrics.stripeIndex);
+    EXPECT_GT(metrics.streamCount, 0);
+    // Streams are not coalesced: one region is read per loaded stream.
+    EXPECT_EQ(metrics.streamCount, metrics.ioRegionCount);
+    EXPECT_EQ(metrics.totalStreamSize, metrics.ioBytesRequested);
+
+    uint32_t histogramStreamCount = 0;
+    for (const auto& [encodingType, count] : metrics.encodingHistogram) {
+      histogramStreamCount += count;
+    }
+    EXPECT_EQ(metrics.streamCount, histogramStreamCount);
+    // The nullable column has nulls in every stripe.
+    EXPECT_EQ(
+        1, metrics.encodingHistogram.count(nimble::EncodingType::Nullable));
+  }
+}
+
+TEST_F(VeloxReaderTests, ReuseEncodingsWithChangingLayouts) {
+  constexpr auto kBatchSize = 1000;
+  velox::test::VectorMaker vectorMaker{leafPool_.get()};
+  auto makeStripe = [&](std::function<int64_t(velox::vector_size_t)> value,
+                        std::function<bool(velox::vector_size_t)> isNull) {
+    return vectorMaker.rowVector(
+        {"int", "string"},
+        {
+            vectorMaker.flatVector<int64_t>(kBatchSize, value, isNull),
+            vectorMaker.flatVector<std::string>(
+                kBatchSize,
+                [&](auto row) { return std::to_string(value(row)); },
+                isNull),
+        });
+  };
+  auto noNulls = [](auto /* row */) { return false; };
+  // Consecutive stripes with different (top level and nested) encodings, so
+  // reused encodings are replaced, or have nested encodings rebuilt.
+  std::vector<velox::VectorPtr> stripes{
+      makeStripe([](auto row) { return row * 2654435761L; }, noNulls),
+      makeStripe([](auto /* row */) { return 7; }, noNulls),
+      makeStripe(
+          [](auto row) { return row * 2654435761L; },
+          [](auto row) { return row % 5 == 0; }),
+      makeStripe([](auto row) { return row % 3; }, noNulls),
+      makeStripe([](auto row) { return row * 2654435761L; }, noNulls),
+  };
+  auto file = nimble::test::createNimbleFile(*rootPool_, stripes);
+
+  for (auto useDecodingArena : {false, true}) {
+    auto logger = std::make_shared<StripeLoadLogger>();
+    nimble::VeloxReadParams params;
+    params.metricsLogger = logger;
+    params.useDecodingArena = useDecodingArena;
+    params.reuseEncodings = true;
+    velox::InMemoryReadFile readFile(file);
+    nimble::VeloxReader reader(
+        *leafPool_, &readFile, /* selector */ nullptr, std::move(params));
+
+    velox::VectorPtr result;
+    for (const auto& expected : stripes) {
+      ASSERT_TRUE(reader.next(kBatchSize, result));
+      ASSERT_EQ(kBatchSize, result->size());
+      for (auto i = 0; i < kBatchSize; ++i) {
+        ASSERT_TRUE(result->equalValueAt(expected.get(), i, i))
+            << "Content mismatch at index " << i
+            << "\nReference: " << expected->toString(i)
+            << "\nResult: " << result->toString(i);
+      }
+    }
+    ASSERT_FALSE(reader.next(1, result));
+
+    ASSERT_EQ(stripes.size(), logger->metrics_.size());
+    for (size_t stripe = 1; stripe < stripes.size(); ++stripe) {
+      EXPECT_NE(
+          logger->metrics_[stripe - 1].encodingHistogram,
+          logger->metrics_[stripe].encodingHistogram);
+    }
+  }
+}
@@ -28,6 +28,7 @@
 #include "dwio/nimble/velox/VeloxWriter.h"
 #include "folly/FileUtil.h"
 #include "folly/Random.h"
+#include "folly/executors/CPUThreadPoolExecutor.h"
 #include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/common/memory/SharedArbitrator.h"
 #include "velox/vector/VectorStream.h"
@@ -387,6 +388,123 @@ TEST_F(VeloxWriterTests, FlushHugeStrings) {
   EXPECT_EQ(3, reader.tabletReader().stripeCount());
 }
 
+TEST_F(VeloxWriterTests, ParallelEncodingSplitsLargeStreams) {
+  class StreamEncodeLogger : public nimble::MetricsLogger {
+   public:
+    void logStreamEncode(
+        const nimble::StreamEncodeMetrics& metrics) const override {
+      std::lock_guard<std::mutex> lock{mutex_};
+      metrics_.push_back(metrics);
+    }
+
+    mutable std::mutex mutex_;
+    mutable std::vector<nimble::StreamEncodeMetrics> metrics_;
+  };
+
+  auto batchSize = 10'000;
+  velox::test::VectorMaker vectorMaker{leafPool_.get()};
+  auto vector = vectorMaker.rowVector(
+      {"int", "string"},
+      {
+          vectorMaker.flatVector<int64_t>(
+              batchSize,
+              [](auto row) { return row % 100; },
+              [](auto row) { return row % 7 == 0; }),
+          vectorMaker.flatVector<std::string>(
+              batchSize,
+              [](auto row) { return std::to_string(row % 11); },
+              [](auto row) { return row % 5 == 0; }),
+      });
+
+  auto logger = std::make_shared<StreamEncodeLogger>();
+  std::string file;
+  auto writeFile = std::make_unique<velox::InMemoryWriteFile>(&file);
+  nimble::VeloxWriter writer(
+      *rootPool_,
+      vector->type(),
+      std::move(writeFile),
+      {
+          .metricsLogger = logger,
+          .encodingExecutor =
+              std::make_shared<folly::CPUThreadPoolExecutor>(4),
+          .encodingSplitRawSize = 4096,
+      });
+  writer.write(vector);
+  writer.close();
+
+  // Both column streams are larger than the split size.
+  ASSERT_EQ(2, logger->metrics_.size());
+  for (const auto& metrics : logger->metrics_) {
+    EXPECT_GT(metrics.sliceCount, 1);
+    EXPECT_GT(metrics.encodedSize, 0);
+  }
+
+  velox::InMemoryReadFile readFile(file);
+  nimble::VeloxReader reader(*leafPool_, &readFile);
+
+  velox::VectorPtr result;
+  ASSERT_TRUE(reader.next(batchSize, result));
+  ASSERT_EQ(result->size(), batchSize);
+  for (auto i = 0; i < batchSize; ++i) {
+    ASSERT_TRUE(result->equalValueAt(vector.get(), i, i));
+  }
+  ASSERT_FALSE(reader.next(1, result));
+}
+
+TEST_F(VeloxWriterTests, ZstdDictionaryForSmallStreams) {
+  // Many small (similar) streams, which barely compress on their own.
+  constexpr auto kColumnCount = 200;
+  constexpr auto kBatchSize = 50;
+  velox::test::VectorMaker vectorMaker{leafPool_.get()};
+  std::vector<std::string> names;
+  std::vector<velox::VectorPtr> children;
+  for (auto i = 0; i < kColumnCount; ++i) {
+    names.push_back(fmt::format("feature_{}", i));
+    children.push_back(vectorMaker.flatVector<std::string>(
+        kBatchSize, [i](auto row) {
+          return fmt::format("category_{}_value_{}", (i + row) % 13, row % 7);
+        }));
+  }
+  auto vector = vectorMaker.rowVector(names, children);
+
+  auto writeFile = [&](bool enableZstdDictionary) {
+    std::string file;
+    nimble::VeloxWriter writer(
+        *rootPool_,
+        vector->type(),
+        std::make_unique<velox::InMemoryWriteFile>(&file),
+        {
+            .enableZstdDictionary = enableZstdDictionary,
+            .zstdDictionaryMaxSize = 4 * 1024,
+        });
+    writer.write(vector);
+    writer.flush();
+    writer.write(vector);
+    writer.close();
+    return file;
+  };
+
+  auto file = writeFile(/* enableZstdDictionary */ true);
+  EXPECT_LT(file.size(), writeFile(/* enableZstdDictionary */ false).size());
+
+  velox::InMemoryReadFile readFile(file);
+  nimble::VeloxReader reader(*leafPool_, &readFile);
+  EXPECT_TRUE(reader.tabletReader()
+                  .loadOptionalSection(
+                      std::string(nimble::kZstdDictionarySection))
+                  .has_value());
+
+  velox::VectorPtr result;
+  for (auto batch = 0; batch < 2; ++batch) {
+    ASSERT_TRUE(reader.next(kBatchSize, result));
+    ASSERT_EQ(result->size(), kBatchSize);
+    for (auto i = 0; i < kBatchSize; ++i) {
+      ASSERT_TRUE(result->equalValueAt(vector.get(), i, i));
+    }
+  }
+  ASSERT_FALSE(reader.next(1, result));
+}
+
 TEST_F(VeloxWriterTests, EncodingLayout) {
   nimble::EncodingLayoutTree expected{
       nimble::Kind::Row,